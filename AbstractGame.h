@@ -34,7 +34,8 @@ public :
 	virtual void GameInitialize(GameSettings &gameSettingsRef) = 0; // pure virtual method declaration
 	virtual void GameStart(void) = 0;
 	virtual void GameEnd(void) = 0;
-	virtual void GamePaint() = 0;
+	// alpha: how far (0 to 1) the current time lies between the last GameTick and the next one
+	virtual void GamePaint(double alpha) = 0;
 	virtual void GameTick(double deltaTime) = 0;
 
 	// NOTE(AJ): I added the following functions to this class
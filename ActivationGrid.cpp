@@ -0,0 +1,188 @@
+#include "stdafx.h"
+
+#include "ActivationGrid.h"
+#include "Entity.h"
+
+ActivationGrid::ActivationGrid(double activationDistance) :
+	m_ActivationDistance(activationDistance)
+{
+}
+
+ActivationGrid::~ActivationGrid()
+{
+}
+
+int ActivationGrid::GetBucketIndex(double x)
+{
+	const int bucketIndex = max(0, int(x / BUCKET_WIDTH));
+
+	// NOTE: Buckets are only added when something is placed in them, levels don't tell us their width up front
+	if (bucketIndex >= int(m_BucketsArr.size()))
+	{
+		m_BucketsArr.resize(bucketIndex + 1);
+	}
+
+	return bucketIndex;
+}
+
+void ActivationGrid::Add(Entity* entityPtr, bool alwaysActive)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+	cellRef = Entity::GridCell();
+	cellRef.m_X = entityPtr->GetActivationX();
+
+	if (alwaysActive)
+	{
+		cellRef.m_AlwaysActive = true;
+		cellRef.m_ActiveIndex = int(m_ActivePtrArr.size());
+		m_ActivePtrArr.push_back(entityPtr);
+		return;
+	}
+
+	cellRef.m_Bucket = GetBucketIndex(cellRef.m_X);
+
+	std::vector<Entity*>& bucketRef = m_BucketsArr[cellRef.m_Bucket];
+	cellRef.m_IndexInBucket = int(bucketRef.size());
+	bucketRef.push_back(entityPtr);
+
+	// NOTE: New bodies are awake, most come to rest within a second
+	if (entityPtr->IsMovedByPhysics()) AddToMovingSet(entityPtr);
+}
+
+void ActivationGrid::Remove(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+	if (cellRef.m_Bucket == -1 && cellRef.m_AlwaysActive == false) return;
+
+	if (cellRef.m_ActiveIndex != -1)
+	{
+		RemoveFromActiveSet(entityPtr);
+	}
+	if (cellRef.m_MovingIndex != -1)
+	{
+		RemoveFromMovingSet(entityPtr);
+	}
+	if (cellRef.m_Bucket != -1)
+	{
+		RemoveFromBucket(entityPtr);
+	}
+
+	cellRef = Entity::GridCell();
+}
+
+void ActivationGrid::Refresh(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+	if (cellRef.m_Bucket == -1) return;
+
+	cellRef.m_X = entityPtr->GetActivationX();
+
+	const int bucketIndex = GetBucketIndex(cellRef.m_X);
+	if (bucketIndex == cellRef.m_Bucket) return;
+
+	RemoveFromBucket(entityPtr);
+
+	std::vector<Entity*>& bucketRef = m_BucketsArr[bucketIndex];
+	cellRef.m_Bucket = bucketIndex;
+	cellRef.m_IndexInBucket = int(bucketRef.size());
+	bucketRef.push_back(entityPtr);
+}
+
+void ActivationGrid::Clear()
+{
+	m_BucketsArr.clear();
+	m_ActivePtrArr.clear();
+	m_MovingPtrArr.clear();
+}
+
+void ActivationGrid::Update(double playerX, std::vector<Entity*>& enteredPtrArrRef, std::vector<Entity*>& leftPtrArrRef)
+{
+	// Falling or pushed entities aren't ticked, so nothing else moves them into the bucket they ended up in
+	for (int i = int(m_MovingPtrArr.size()) - 1; i >= 0; --i)
+	{
+		Entity* entityPtr = m_MovingPtrArr[i];
+		Refresh(entityPtr);
+		if (entityPtr->IsMovedByPhysics() == false)
+		{
+			RemoveFromMovingSet(entityPtr);
+		}
+	}
+
+	for (int i = int(m_ActivePtrArr.size()) - 1; i >= 0; --i)
+	{
+		Entity* entityPtr = m_ActivePtrArr[i];
+		const Entity::GridCell& cellRef = entityPtr->GetGridCell();
+		if (cellRef.m_AlwaysActive == false && abs(cellRef.m_X - playerX) >= m_ActivationDistance)
+		{
+			RemoveFromActiveSet(entityPtr);
+			if (entityPtr->IsMovedByPhysics()) AddToMovingSet(entityPtr);
+			leftPtrArrRef.push_back(entityPtr);
+		}
+	}
+
+	// Anything which came into range has to be in one of the buckets the activation window overlaps
+	const int firstBucket = max(0, int((playerX - m_ActivationDistance) / BUCKET_WIDTH));
+	const int lastBucket = min(int(m_BucketsArr.size()) - 1, int((playerX + m_ActivationDistance) / BUCKET_WIDTH));
+	for (int bucketIndex = firstBucket; bucketIndex <= lastBucket; ++bucketIndex)
+	{
+		const std::vector<Entity*>& bucketRef = m_BucketsArr[bucketIndex];
+		for (size_t i = 0; i < bucketRef.size(); ++i)
+		{
+			Entity::GridCell& cellRef = bucketRef[i]->GetGridCell();
+			if (cellRef.m_ActiveIndex == -1 && abs(cellRef.m_X - playerX) < m_ActivationDistance)
+			{
+				if (cellRef.m_MovingIndex != -1) RemoveFromMovingSet(bucketRef[i]);
+
+				cellRef.m_ActiveIndex = int(m_ActivePtrArr.size());
+				m_ActivePtrArr.push_back(bucketRef[i]);
+				enteredPtrArrRef.push_back(bucketRef[i]);
+			}
+		}
+	}
+}
+
+const std::vector<Entity*>& ActivationGrid::GetActiveEntities() const
+{
+	return m_ActivePtrArr;
+}
+
+void ActivationGrid::RemoveFromBucket(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+	std::vector<Entity*>& bucketRef = m_BucketsArr[cellRef.m_Bucket];
+
+	bucketRef[cellRef.m_IndexInBucket] = bucketRef.back();
+	bucketRef[cellRef.m_IndexInBucket]->GetGridCell().m_IndexInBucket = cellRef.m_IndexInBucket;
+	bucketRef.pop_back();
+}
+
+void ActivationGrid::RemoveFromActiveSet(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+
+	m_ActivePtrArr[cellRef.m_ActiveIndex] = m_ActivePtrArr.back();
+	m_ActivePtrArr[cellRef.m_ActiveIndex]->GetGridCell().m_ActiveIndex = cellRef.m_ActiveIndex;
+	m_ActivePtrArr.pop_back();
+
+	cellRef.m_ActiveIndex = -1;
+}
+
+void ActivationGrid::AddToMovingSet(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+	if (cellRef.m_MovingIndex != -1) return;
+
+	cellRef.m_MovingIndex = int(m_MovingPtrArr.size());
+	m_MovingPtrArr.push_back(entityPtr);
+}
+
+void ActivationGrid::RemoveFromMovingSet(Entity* entityPtr)
+{
+	Entity::GridCell& cellRef = entityPtr->GetGridCell();
+
+	m_MovingPtrArr[cellRef.m_MovingIndex] = m_MovingPtrArr.back();
+	m_MovingPtrArr[cellRef.m_MovingIndex]->GetGridCell().m_MovingIndex = cellRef.m_MovingIndex;
+	m_MovingPtrArr.pop_back();
+
+	cellRef.m_MovingIndex = -1;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+class Entity;
+
+// Buckets entities by their x position so that only the ones near the player have to be looked at each tick.
+// Levels are far wider than they are tall, so a single row of buckets is enough
+class ActivationGrid
+{
+public:
+	ActivationGrid(double activationDistance);
+	virtual ~ActivationGrid();
+
+	ActivationGrid(const ActivationGrid&) = delete;
+	ActivationGrid& operator=(const ActivationGrid&) = delete;
+
+	// Always active entities are put straight into the active set and never leave it
+	void Add(Entity* entityPtr, bool alwaysActive = false);
+	void Remove(Entity* entityPtr);
+	// Moves the entity into the bucket its activation x is now in, call this after it may have moved
+	void Refresh(Entity* entityPtr);
+	void Clear();
+
+	// Entities which came within the activation distance of playerX are appended to enteredPtrArrRef,
+	// ones which went out of range are appended to leftPtrArrRef.
+	// Entities which aren't activated but are still being moved by the physics step are moved into their new bucket first
+	void Update(double playerX, std::vector<Entity*>& enteredPtrArrRef, std::vector<Entity*>& leftPtrArrRef);
+
+	const std::vector<Entity*>& GetActiveEntities() const;
+
+private:
+	int GetBucketIndex(double x);
+	void RemoveFromBucket(Entity* entityPtr);
+	void RemoveFromActiveSet(Entity* entityPtr);
+	void AddToMovingSet(Entity* entityPtr);
+	void RemoveFromMovingSet(Entity* entityPtr);
+
+	static const int BUCKET_WIDTH = 128;
+
+	const double m_ActivationDistance;
+
+	std::vector<std::vector<Entity*>> m_BucketsArr;
+	std::vector<Entity*> m_ActivePtrArr;
+	// Entities which aren't activated, but whose body hadn't come to rest yet the last time the grid looked at them
+	std::vector<Entity*> m_MovingPtrArr;
+};
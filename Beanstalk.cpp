@@ -14,6 +14,7 @@ Beanstalk::Beanstalk(DOUBLE2 bottomLeft, Level* levelPtr, int height) :
 	m_CurrentHeight = 0;
 	m_ActPtr->SetSensor(true);
 	m_IsActive = true;
+	m_IsAlwaysActive = true;
 }
 
 Beanstalk::~Beanstalk()
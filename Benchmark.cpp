@@ -0,0 +1,353 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+#include "Game.h"
+#include "Level.h"
+#include "Player.h"
+#include "TileMap.h"
+#include "Keybindings.h"
+#include "KoopaShell.h"
+
+#include <algorithm>
+#include <atomic>
+
+// Every allocation made with new goes through here so the benchmark can count them.
+// Outside of a benchmark run this costs one branch per allocation.
+// NOTE: Box2D allocates with malloc, so its allocations are not included
+static std::atomic<bool> countingAllocations(false);
+static std::atomic<unsigned int> numAllocations(0);
+
+void* operator new(size_t size)
+{
+	if (countingAllocations.load(std::memory_order_relaxed)) numAllocations.fetch_add(1, std::memory_order_relaxed);
+	void* memoryPtr = malloc(size == 0 ? 1 : size);
+	if (memoryPtr == nullptr) throw std::bad_alloc();
+	return memoryPtr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memoryPtr) noexcept
+{
+	free(memoryPtr);
+}
+
+void operator delete[](void* memoryPtr) noexcept
+{
+	free(memoryPtr);
+}
+
+const char* Benchmark::SCENARIO_NAMES[int(Scenario::_LAST_ELEMENT)] =
+{
+	"level_00_run", "chargin_chuck_and_monty_moles", "shell_chain", "p_switch", "particle_storm"
+};
+
+const int Benchmark::SCENARIO_MAX_TICKS[int(Scenario::_LAST_ELEMENT)] =
+{
+	60 * 180,	// LEVEL_00_RUN (ends early once the goal gate is reached)
+	60 * 60,	// CHARGIN_CHUCK_AND_MONTY_MOLES
+	60 * 10,	// SHELL_CHAIN
+	60 * 12,	// P_SWITCH (long enough for the blocks to turn back into coins)
+	60 * 10		// PARTICLE_STORM
+};
+
+Game* Benchmark::m_GamePtr = nullptr;
+Benchmark::Scenario Benchmark::m_ActiveScenario = Benchmark::Scenario::LEVEL_00_RUN;
+int Benchmark::m_TicksRun = 0;
+double Benchmark::m_FurthestX = 0.0;
+int Benchmark::m_TicksSinceProgress = 0;
+int Benchmark::m_NumNudges = 0;
+int Benchmark::m_StartScore = 0;
+bool Benchmark::m_TeleportFailed = false;
+bool Benchmark::m_ReachedIntendedState = false;
+
+std::vector<double> Benchmark::m_TickSecondsArr;
+std::vector<unsigned int> Benchmark::m_TickAllocationsArr;
+__int64 Benchmark::m_PrevTickCount = 0;
+unsigned int Benchmark::m_PrevTickAllocations = 0;
+
+bool Benchmark::RunAllScenarios(const String& resultsFilePath)
+{
+	ScenarioResult resultsArr[int(Scenario::_LAST_ELEMENT)];
+	for (int i = 0; i < int(Scenario::_LAST_ELEMENT); ++i)
+	{
+		resultsArr[i] = RunScenario(Scenario(i));
+	}
+
+	bool allScenariosValid = true;
+	for (int i = 0; i < int(Scenario::_LAST_ELEMENT); ++i)
+	{
+		if (resultsArr[i].m_ReachedIntendedState == false)
+		{
+			OutputDebugString(String("ERROR: Benchmark scenario ") + String(SCENARIO_NAMES[i]) + String(" didn't reach its intended state\n"));
+			allScenariosValid = false;
+		}
+	}
+
+	return WriteResults(resultsFilePath, resultsArr) && allScenariosValid;
+}
+
+Benchmark::ScenarioResult Benchmark::RunScenario(Scenario scenario)
+{
+	m_ActiveScenario = scenario;
+	m_TicksRun = 0;
+	m_FurthestX = 0.0;
+	m_TicksSinceProgress = 0;
+	m_NumNudges = 0;
+	m_StartScore = 0;
+	m_TeleportFailed = false;
+	m_ReachedIntendedState = false;
+
+	const int maxTicks = SCENARIO_MAX_TICKS[int(scenario)];
+	m_TickSecondsArr.clear();
+	m_TickSecondsArr.reserve(maxTicks);
+	m_TickAllocationsArr.clear();
+	m_TickAllocationsArr.reserve(maxTicks);
+
+	// Every scenario sees the same random numbers, so runs can be compared with each other
+	srand((unsigned int)scenario + 1);
+
+	// The tick which creates the level isn't measured, so run one more
+	m_GamePtr = new Game();
+	GAME_ENGINE->SetGame(m_GamePtr);
+	GAME_ENGINE->SetHeadlessTickCallback(Benchmark::Tick);
+	countingAllocations = true;
+	const int exitCode = GAME_ENGINE->RunHeadless(maxTicks + 1);
+	countingAllocations = false;
+	GAME_ENGINE->SetHeadlessTickCallback(nullptr);
+	m_GamePtr = nullptr;
+
+	if (exitCode != 0)
+	{
+		OutputDebugString(String("ERROR: Benchmark scenario ") + String(SCENARIO_NAMES[int(scenario)]) + String(" failed to run\n"));
+	}
+
+	ScenarioResult result = {};
+	result.m_NumNudges = m_NumNudges;
+	result.m_ReachedIntendedState = exitCode == 0 && m_ReachedIntendedState && m_TeleportFailed == false;
+	result.m_NumTicks = int(m_TickSecondsArr.size());
+	if (result.m_NumTicks == 0) return result;
+
+	std::vector<double> sortedTickSecondsArr = m_TickSecondsArr;
+	std::sort(sortedTickSecondsArr.begin(), sortedTickSecondsArr.end());
+
+	unsigned int totalAllocations = 0;
+	for (size_t i = 0; i < m_TickSecondsArr.size(); ++i)
+	{
+		result.m_TotalSeconds += m_TickSecondsArr[i];
+		totalAllocations += m_TickAllocationsArr[i];
+	}
+	result.m_P50Seconds = sortedTickSecondsArr[(result.m_NumTicks - 1) / 2];
+	result.m_P99Seconds = sortedTickSecondsArr[((result.m_NumTicks - 1) * 99) / 100];
+	result.m_MaxSeconds = sortedTickSecondsArr.back();
+	result.m_AllocationsPerTick = double(totalAllocations) / result.m_NumTicks;
+
+	return result;
+}
+
+void Benchmark::Tick()
+{
+	// Nothing to measure until the game state has created the level
+	Level* levelPtr = m_GamePtr->GetCurrentLevel();
+	if (levelPtr == nullptr) return;
+
+	// Measured from the start of one engine tick to the start of the next, so this
+	// covers the whole tick: input, game tick, physics step and contact callbacks
+	const __int64 tickCount = Profiler::GetCount();
+	const unsigned int tickAllocations = GetAllocationCount();
+
+	if (m_TicksRun == 0)
+	{
+		SetUpScenario(levelPtr);
+	}
+	else if (m_TickSecondsArr.size() < m_TickSecondsArr.capacity())
+	{
+		__int64 countsPerSec;
+		QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSec);
+		m_TickSecondsArr.push_back(double(tickCount - m_PrevTickCount) / countsPerSec);
+		m_TickAllocationsArr.push_back(tickAllocations - m_PrevTickAllocations);
+	}
+	++m_TicksRun;
+
+	m_ReachedIntendedState = IsIntendedStateReached(levelPtr);
+	HoldScriptedButtons(levelPtr);
+
+	// Don't count the time spent in here against the next tick
+	m_PrevTickCount = Profiler::GetCount();
+	m_PrevTickAllocations = GetAllocationCount();
+}
+
+void Benchmark::SetUpScenario(Level* levelPtr)
+{
+	m_StartScore = levelPtr->GetPlayer()->GetScore();
+
+	switch (m_ActiveScenario)
+	{
+	case Scenario::CHARGIN_CHUCK_AND_MONTY_MOLES:
+	{
+		TeleportPlayer(levelPtr, DOUBLE2(2000, 250));
+	} break;
+	case Scenario::SHELL_CHAIN:
+	{
+		// Slides along the platform straight into the row of koopas
+		KoopaShell* koopaShellPtr = new KoopaShell(DOUBLE2(20 * 16, 18 * 16), levelPtr, Colour::RED);
+		levelPtr->AddItem(koopaShellPtr, true);
+		koopaShellPtr->KickHorizontally(1, false);
+	} break;
+	case Scenario::P_SWITCH:
+	{
+		// Drop the player right on top of the p switch
+		TeleportPlayer(levelPtr, DOUBLE2(282 * 16 + 8, 12 * 16));
+	} break;
+	}
+}
+
+void Benchmark::HoldScriptedButtons(Level* levelPtr)
+{
+	switch (m_ActiveScenario)
+	{
+	case Scenario::LEVEL_00_RUN:
+	{
+		// The goal gate's top left is at tile (301, 13)
+		const double goalGateX = 301 * 16;
+		RunTowards(levelPtr, goalGateX);
+		if (levelPtr->GetPlayer()->GetPosition().x >= goalGateX)
+		{
+			GAME_ENGINE->QuitGame();
+		}
+	} break;
+	case Scenario::CHARGIN_CHUCK_AND_MONTY_MOLES:
+	{
+		// Past the last monty mole
+		RunTowards(levelPtr, 4000);
+	} break;
+	case Scenario::PARTICLE_STORM:
+	{
+		const DOUBLE2 playerPos = levelPtr->GetPlayer()->GetPosition();
+		for (int i = 0; i < PARTICLES_PER_TICK; ++i)
+		{
+			const DOUBLE2 offset((rand() % Game::WIDTH) - Game::WIDTH / 2, -(rand() % (Game::HEIGHT / 2)));
+			levelPtr->AddParticle(SpriteParticleStore::Kind::COIN_COLLECT, playerPos + offset);
+			levelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, playerPos - offset);
+		}
+	} break;
+	}
+}
+
+void Benchmark::RunTowards(Level* levelPtr, double goalX)
+{
+	Player* playerPtr = levelPtr->GetPlayer();
+	const DOUBLE2 playerPos = playerPtr->GetPosition();
+
+	const bool running = playerPos.x < goalX;
+	GAME_ENGINE->SetKeyboardKeyDown(Keybindings::D_PAD_RIGHT, running);
+	GAME_ENGINE->SetKeyboardKeyDown(Keybindings::Y_BUTTON, running);
+	// Hop every so often to get over enemies and small gaps
+	GAME_ENGINE->SetKeyboardKeyDown(Keybindings::B_BUTTON, running && (m_TicksRun % 45) < 20);
+
+	if (playerPos.x > m_FurthestX)
+	{
+		m_FurthestX = playerPos.x;
+		m_TicksSinceProgress = 0;
+	}
+	else if (playerPtr->IsDead() == false && ++m_TicksSinceProgress > TICKS_BEFORE_NUDGE)
+	{
+		// Stuck behind a wall or pipe the hops can't clear, lift the player over it
+		TeleportPlayer(levelPtr, playerPos + DOUBLE2(24, -48));
+		++m_NumNudges;
+		m_TicksSinceProgress = 0;
+	}
+}
+
+bool Benchmark::TeleportPlayer(Level* levelPtr, DOUBLE2 position)
+{
+	if (levelPtr->GetTileMap()->GetTileAt(position) != TileMap::Tile::EMPTY)
+	{
+		OutputDebugString(String("ERROR: Benchmark scenario ") + String(SCENARIO_NAMES[int(m_ActiveScenario)]) +
+			String(" tried to move the player into the ground at ") + String(position.x) + String(", ") + String(position.y) + String("\n"));
+		m_TeleportFailed = true;
+		return false;
+	}
+
+	levelPtr->GetPlayer()->SetPosition(position);
+	return true;
+}
+
+bool Benchmark::IsIntendedStateReached(Level* levelPtr)
+{
+	Player* playerPtr = levelPtr->GetPlayer();
+
+	switch (m_ActiveScenario)
+	{
+	case Scenario::LEVEL_00_RUN:
+	{
+		return playerPtr->GetPosition().x >= 301 * 16;
+	}
+	case Scenario::CHARGIN_CHUCK_AND_MONTY_MOLES:
+	{
+		return m_FurthestX >= 4000;
+	}
+	case Scenario::SHELL_CHAIN:
+	{
+		// Every koopa the shell knocks out scores points
+		return playerPtr->GetScore() > m_StartScore;
+	}
+	case Scenario::P_SWITCH:
+	{
+		// Once pressed, the coins stay blocks for the rest of the scenario
+		return m_ReachedIntendedState || levelPtr->IsPSwitchActive();
+	}
+	case Scenario::PARTICLE_STORM:
+	{
+		// The storm itself can't fail, but a player who died stopped spawning particles where intended
+		return playerPtr->IsDead() == false;
+	}
+	}
+	return false;
+}
+
+unsigned int Benchmark::GetAllocationCount()
+{
+	return numAllocations;
+}
+
+bool Benchmark::WriteResults(const String& resultsFilePath, const ScenarioResult resultsArr[])
+{
+	std::ofstream fileOutStream;
+	fileOutStream.open(resultsFilePath.C_str());
+
+	if (fileOutStream.fail())
+	{
+		OutputDebugString(String("ERROR: Unable to write benchmark results to ") + resultsFilePath + String("\n"));
+		return false;
+	}
+
+	fileOutStream << std::fixed << std::setprecision(4);
+	fileOutStream << "{" << std::endl;
+	fileOutStream << "\t\"scenarios\": [" << std::endl;
+	for (int i = 0; i < int(Scenario::_LAST_ELEMENT); ++i)
+	{
+		const ScenarioResult& resultRef = resultsArr[i];
+		const double ticksPerSecond = resultRef.m_TotalSeconds > 0.0 ? resultRef.m_NumTicks / resultRef.m_TotalSeconds : 0.0;
+
+		fileOutStream << "\t\t{" << std::endl;
+		fileOutStream << "\t\t\t\"name\": \"" << SCENARIO_NAMES[i] << "\"," << std::endl;
+		fileOutStream << "\t\t\t\"ticks\": " << resultRef.m_NumTicks << "," << std::endl;
+		fileOutStream << "\t\t\t\"ticksPerSecond\": " << ticksPerSecond << "," << std::endl;
+		fileOutStream << "\t\t\t\"p50TickMs\": " << resultRef.m_P50Seconds * 1000.0 << "," << std::endl;
+		fileOutStream << "\t\t\t\"p99TickMs\": " << resultRef.m_P99Seconds * 1000.0 << "," << std::endl;
+		fileOutStream << "\t\t\t\"maxTickMs\": " << resultRef.m_MaxSeconds * 1000.0 << "," << std::endl;
+		fileOutStream << "\t\t\t\"allocationsPerTick\": " << resultRef.m_AllocationsPerTick << "," << std::endl;
+		fileOutStream << "\t\t\t\"nudges\": " << resultRef.m_NumNudges << "," << std::endl;
+		fileOutStream << "\t\t\t\"reachedIntendedState\": " << (resultRef.m_ReachedIntendedState ? "true" : "false") << std::endl;
+		fileOutStream << "\t\t}" << (i < int(Scenario::_LAST_ELEMENT) - 1 ? "," : "") << std::endl;
+	}
+	fileOutStream << "\t]" << std::endl;
+	fileOutStream << "}" << std::endl;
+
+	fileOutStream.close();
+	return true;
+}
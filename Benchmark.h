@@ -0,0 +1,73 @@
+#pragma once
+
+class Game;
+class Level;
+
+// Runs a fixed set of scripted scenarios headless and reports how fast they tick.
+// Started with the -benchmark <file> command line option, results are written as JSON.
+// Allocations made with new are counted while a scenario runs
+class Benchmark
+{
+public:
+	enum class Scenario
+	{
+		LEVEL_00_RUN, CHARGIN_CHUCK_AND_MONTY_MOLES, SHELL_CHAIN, P_SWITCH, PARTICLE_STORM,
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
+	};
+
+	// Returns false if the results file couldn't be written or a scenario didn't reach its intended state
+	static bool RunAllScenarios(const String& resultsFilePath);
+
+private:
+	Benchmark() = delete;
+
+	struct ScenarioResult
+	{
+		int m_NumTicks;
+		double m_TotalSeconds;
+		double m_P50Seconds;
+		double m_P99Seconds;
+		double m_MaxSeconds;
+		double m_AllocationsPerTick;
+		int m_NumNudges;
+		bool m_ReachedIntendedState;
+	};
+
+	static ScenarioResult RunScenario(Scenario scenario);
+	// Called by the engine at the start of every tick: sets the scenario up once the level exists,
+	// then measures the previous tick, checks the scenario's progress and holds down this tick's scripted buttons
+	static void Tick();
+	static void SetUpScenario(Level* levelPtr);
+	static void HoldScriptedButtons(Level* levelPtr);
+	static void RunTowards(Level* levelPtr, double goalX);
+	// Moves the player, unless position lies inside the ground. Returns false (and fails the scenario) if it does
+	static bool TeleportPlayer(Level* levelPtr, DOUBLE2 position);
+	// Whether the level is (still) in the state the scenario is meant to reach
+	static bool IsIntendedStateReached(Level* levelPtr);
+	static unsigned int GetAllocationCount();
+	static bool WriteResults(const String& resultsFilePath, const ScenarioResult resultsArr[]);
+
+	static const char* SCENARIO_NAMES[int(Scenario::_LAST_ELEMENT)];
+	static const int SCENARIO_MAX_TICKS[int(Scenario::_LAST_ELEMENT)];
+
+	// How long the player may go without making progress before the run script lifts them over the obstacle
+	static const int TICKS_BEFORE_NUDGE = 90;
+	static const int PARTICLES_PER_TICK = 8;
+
+	static Game* m_GamePtr;
+	static Scenario m_ActiveScenario;
+	static int m_TicksRun;
+	static double m_FurthestX;
+	static int m_TicksSinceProgress;
+	static int m_NumNudges;
+	static int m_StartScore;
+	static bool m_TeleportFailed;
+	static bool m_ReachedIntendedState;
+
+	// Reserved before every scenario so recording never allocates
+	static std::vector<double> m_TickSecondsArr;
+	static std::vector<unsigned int> m_TickAllocationsArr;
+	static __int64 m_PrevTickCount;
+	static unsigned int m_PrevTickAllocations;
+};
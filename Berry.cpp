@@ -47,3 +47,11 @@ void Berry::Paint()
 	else if (m_Colour == Colour::GREEN) srcRow += 2;
 	SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::GENERAL_TILES)->Paint(left, top, srcCol, srcRow);
 }
+
+bool Berry::ResetToSpawnState()
+{
+	ResetBodyAndAnimation();
+	m_IsActive = true;
+
+	return true;
+}
@@ -14,6 +14,7 @@ public:
 
 	void Tick(double deltaTime);
 	void Paint();
+	bool ResetToSpawnState();
 
 private:
 	Colour m_Colour;
@@ -10,6 +10,7 @@ Block::Block(DOUBLE2 topLeft, Type type, Level* levelPtr, BodyType bodyType, int
 	collisionFilter.maskBits |= Level::YOSHI | Level::ITEM | Level::SHELL;
 	m_ActPtr->SetCollisionFilter(collisionFilter);
 	m_IsActive = true;
+	m_IsAlwaysActive = true;
 }
 
 Block::~Block() {}
@@ -4,6 +4,7 @@
 #include "Game.h"
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
+#include "ParticlePool.h"
 
 BlockChunk::BlockChunk(DOUBLE2 position, DOUBLE2 velocity, bool isRainbow) :
 	m_Position(position), m_Velocity(velocity), m_IsRanbow(isRainbow)
@@ -15,6 +16,18 @@ BlockChunk::BlockChunk(DOUBLE2 position, DOUBLE2 velocity, bool isRainbow) :
 BlockChunk::~BlockChunk()
 {
 }
+void* BlockChunk::operator new(size_t size)
+{
+	return ParticlePool::Allocate(size);
+}
+void BlockChunk::operator delete(void* memoryPtr)
+{
+	ParticlePool::Free(memoryPtr);
+}
+DOUBLE2 BlockChunk::GetPosition() const
+{
+	return m_Position;
+}
 void BlockChunk::Tick(double deltaTime)
 {
 	m_AnimInfo.Tick(deltaTime);
@@ -99,3 +112,22 @@ void BlockBreakParticle::Paint()
 		m_BlockChunkPtrArr[i]->Paint();
 	}
 }
+
+RECT2 BlockBreakParticle::GetPaintBounds()
+{
+	const DOUBLE2 firstPos = m_BlockChunkPtrArr[0]->GetPosition();
+	RECT2 bounds(firstPos.x, firstPos.y, firstPos.x, firstPos.y);
+	for (int i = 1; i < 4; ++i)
+	{
+		const DOUBLE2 chunkPos = m_BlockChunkPtrArr[i]->GetPosition();
+		bounds.left = min(bounds.left, chunkPos.x);
+		bounds.top = min(bounds.top, chunkPos.y);
+		bounds.right = max(bounds.right, chunkPos.x);
+		bounds.bottom = max(bounds.bottom, chunkPos.y);
+	}
+
+	// Chunks are painted from their top left
+	bounds.right += MAX_CHUNK_SIZE;
+	bounds.bottom += MAX_CHUNK_SIZE;
+	return bounds;
+}
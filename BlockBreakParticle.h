@@ -13,6 +13,11 @@ public:
 
 	void Tick(double deltaTime);
 	void Paint();
+	DOUBLE2 GetPosition() const;
+
+	// Chunks live as long as their particle, so they're stored alongside it in the ParticlePool
+	static void* operator new(size_t size);
+	static void operator delete(void* memoryPtr);
 
 private:
 	AnimationInfo m_AnimInfo;
@@ -36,9 +41,12 @@ public:
 
 	bool Tick(double deltaTime);
 	void Paint();
+	// The chunks fly apart, so this covers all four of them
+	RECT2 GetPaintBounds();
 
 private:
 	static const int LIFETIME = 100;
+	static const int MAX_CHUNK_SIZE = 16;
 
 	// Holds 4 values, one for each block piece
 	BlockChunk* m_BlockChunkPtrArr[4];
@@ -30,6 +30,7 @@ void Camera::Reset()
 	m_PrevOffset = DOUBLE2(0.0, DEFAULT_Y_OFFSET);
 	m_OffsetDirection = Direction::RIGHT;
 	m_XOffset = DISTANCE_FROM_EDGE;
+	m_MatPrevTranslation = m_MatTranslation;
 }
 
 DOUBLE2 Camera::GetOffset(Level* levelPtr, double deltaTime)
@@ -251,9 +252,22 @@ void Camera::CalculateViewMatrix(Level* levelPtr, double deltaTime)
 	m_MatTranslation = MATRIX3X2::CreateTranslationMatrix(-newTranslation);
 }
 
-MATRIX3X2 Camera::GetViewMatrix()
+void Camera::StorePreviousViewMatrix()
 {
-	return m_MatTranslation;
+	m_MatPrevTranslation = m_MatTranslation;
+}
+
+MATRIX3X2 Camera::GetViewMatrix(double alpha)
+{
+	const DOUBLE2 prevOrig = m_MatPrevTranslation.orig;
+	const DOUBLE2 orig = prevOrig + (m_MatTranslation.orig - prevOrig) * alpha;
+	return MATRIX3X2::CreateTranslationMatrix(orig);
+}
+
+RECT2 Camera::GetVisibleRect(double alpha)
+{
+	const DOUBLE2 topLeft = -GetViewMatrix(alpha).orig;
+	return RECT2(topLeft.x, topLeft.y, topLeft.x + WIDTH, topLeft.y + HEIGHT);
 }
 
 /* Paints extra debug info about the camera (Expects view matrix to be Game::matIdentity) */
@@ -294,3 +308,25 @@ void Camera::Clamp(DOUBLE2& posRef, Level* levelPtr)
 	if (posRef.y < 0) posRef.y = 0;
 	else if (posRef.y > levelPtr->GetHeight() - HEIGHT) posRef.y = levelPtr->GetHeight() - HEIGHT;
 }
+
+bool ViewCulling::IsVisible(const RECT2& boundsRef)
+{
+	const bool visible = boundsRef.right >= m_VisibleRect.left && boundsRef.left <= m_VisibleRect.right &&
+		boundsRef.bottom >= m_VisibleRect.top && boundsRef.top <= m_VisibleRect.bottom;
+
+	if (visible) ++m_NumDrawn;
+	else ++m_NumCulled;
+
+	return visible;
+}
+
+bool ViewCulling::IsVisible(DOUBLE2 center, double extent)
+{
+	return IsVisible(RECT2(center.x - extent, center.y - extent, center.x + extent, center.y + extent));
+}
+
+void ViewCulling::ResetCounters()
+{
+	m_NumDrawn = 0;
+	m_NumCulled = 0;
+}
@@ -5,6 +5,21 @@
 class Player;
 class Level;
 
+// The part of the world which is on screen while a frame is painted. Paint calls check their
+// bounds against it, and it counts how many of them were drawn and how many were culled
+struct ViewCulling
+{
+	// Counts the paint call as drawn or culled
+	bool IsVisible(const RECT2& boundsRef);
+	// Checks the square extent pixels around center
+	bool IsVisible(DOUBLE2 center, double extent);
+	void ResetCounters();
+
+	RECT2 m_VisibleRect;
+	int m_NumDrawn = 0;
+	int m_NumCulled = 0;
+};
+
 class Camera
 {
 public:
@@ -16,7 +31,12 @@ public:
 
 	DOUBLE2 GetOffset(Level* levelPtr, double deltaTime);
 	void CalculateViewMatrix(Level* levelPtr, double deltaTime);
-	MATRIX3X2 GetViewMatrix();
+	// Remembers the current view so paints between this tick and the next can blend from it
+	void StorePreviousViewMatrix();
+	// alpha: 0 returns the view of the previous tick, 1 the view of the current tick
+	MATRIX3X2 GetViewMatrix(double alpha = 1.0);
+	// The world space rect on screen, blended between ticks the same way as GetViewMatrix
+	RECT2 GetVisibleRect(double alpha = 1.0);
 
 	void Reset();
 	void DEBUGPaint();
@@ -52,4 +72,5 @@ private:
 	double m_YTarget;
 
 	MATRIX3X2 m_MatTranslation;
+	MATRIX3X2 m_MatPrevTranslation;
 };
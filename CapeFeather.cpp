@@ -15,7 +15,6 @@ CapeFeather::~CapeFeather()
 
 void CapeFeather::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
 	if (m_IsActive == false)
 	{
 		m_LevelPtr->RemoveItem(this);
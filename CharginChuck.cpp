@@ -7,7 +7,6 @@
 #include "SpriteSheet.h"
 #include "SpriteSheetManager.h"
 #include "SoundManager.h"
-#include "SplatParticle.h"
 
 const double CharginChuck::TARGET_OVERSHOOT_DISTANCE = 60.0;
 const double CharginChuck::RUN_VEL = 7000.0;
@@ -48,19 +47,6 @@ void CharginChuck::Tick(double deltaTime)
 		return;
 	}
 
-	bool wasActive = m_IsActive;
-	Enemy::Tick(deltaTime);
-	if (m_IsActive == false && wasActive)
-	{
-		SoundManager::SetSongPaused(SoundManager::Song::CHARGIN_CHUCK_RUN, true);
-
-		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_SpawingPosition.x) >= MINIMUM_PLAYER_DISTANCE)
-		{
-			m_ActPtr->SetPosition(m_SpawingPosition);
-			return;
-		}
-	}
-
 	if (m_IsActive == false) return;
 
 	if (m_WaitingTimer.Tick() && m_WaitingTimer.IsComplete())
@@ -118,20 +104,16 @@ void CharginChuck::Tick(double deltaTime)
 
 bool CharginChuck::CalculateOnGround()
 {
-	if (m_ActPtr->GetLinearVelocity().y < 0) return false;
+	// NOTE: This probe was run from where the last physics step left us
+	const bool groundBelow = m_GroundProbe.m_Hit;
 
-	DOUBLE2 point1 = m_ActPtr->GetPosition();
-	DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(0, (GetHeight() / 2 + 2));
-	DOUBLE2 intersection, normal;
-	double fraction = -1.0;
-	int collisionBits = Level::LEVEL | Level::BLOCK;
+	m_GroundProbe.m_Offset = DOUBLE2(0, (GetHeight() / 2 + 2));
+	m_GroundProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_GroundProbe);
 
-	if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
-	{
-		return true;
-	}
+	if (m_ActPtr->GetLinearVelocity().y < 0) return false;
 
-	return false;
+	return groundBelow;
 }
 
 void CharginChuck::Paint()
@@ -201,21 +183,16 @@ void CharginChuck::UpdateVelocity(double deltaTime)
 		CalculateNewTarget();
 	}
 
-	if (m_IsOnGround)
+	// Probe forwards to see if we need to jump over somthing
+	if (m_IsOnGround && m_ObstacleProbe.m_Hit)
 	{
-		// Raycast forwards to see if we need to jump over somthing
-		DOUBLE2 point1 = m_ActPtr->GetPosition();
-		DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * (GetWidth() / 2 + 8), 0);
-		DOUBLE2 intersection, normal;
-		double fraction = -1.0;
-		int collisionBits = Level::LEVEL | Level::BLOCK;
-
-		if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
-		{
-			Jump(deltaTime);
-		}
+		Jump(deltaTime);
 	}
 
+	m_ObstacleProbe.m_Offset = DOUBLE2(m_DirFacing * (GetWidth() / 2 + 8), 0);
+	m_ObstacleProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_ObstacleProbe);
+
 	// Keep walking towards the target
 	double newXVel = m_DirFacing * RUN_VEL * deltaTime;
 
@@ -259,8 +236,7 @@ void CharginChuck::CalculateNewTarget()
 
 void CharginChuck::HeadBonk()
 {
-	SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(splatParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition());
 
 	switch (m_AnimationState)
 	{
@@ -420,6 +396,22 @@ int CharginChuck::GetHeight() const
 	return HEIGHT;
 }
 
+void CharginChuck::SetActivated(bool activated)
+{
+	// NOTE: Dead chucks keep falling until they're off the screen, so they aren't moved back to their spawn
+	if (m_IsActive && activated == false && m_AnimationState != AnimationState::DEAD)
+	{
+		SoundManager::SetSongPaused(SoundManager::Song::CHARGIN_CHUCK_RUN, true);
+
+		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_SpawingPosition.x) >= MINIMUM_PLAYER_DISTANCE)
+		{
+			m_ActPtr->SetPosition(m_SpawingPosition);
+		}
+	}
+
+	Enemy::SetActivated(activated);
+}
+
 void CharginChuck::SetPaused(bool paused)
 {
 	m_ActPtr->SetActive(!paused);
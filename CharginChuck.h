@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Enemy.h"
+#include "ProbeService.h"
 
 struct INT2;
 
@@ -25,6 +26,7 @@ public:
 	int GetHeight() const;
 
 	void SetPaused(bool paused);
+	void SetActivated(bool activated) override;
 
 	void HeadBonk();
 
@@ -66,6 +68,9 @@ private:
 
 	double m_TargetX;
 
+	Probe m_GroundProbe;
+	Probe m_ObstacleProbe; // Whether there's something ahead to jump over
+
 	bool m_ShouldRemoveActor;
 
 };
@@ -0,0 +1,89 @@
+#include "stdafx.h"
+
+#include "ChunkedBitmap.h"
+#include "Game.h"
+
+ChunkedBitmap::ChunkedBitmap(const String& filePathRef)
+{
+	// The whole image is only decoded, never uploaded, and is freed again once it's been split up
+	Bitmap* imagePtr = new Bitmap(filePathRef, false);
+	m_Width = imagePtr->GetWidth();
+	m_Height = imagePtr->GetHeight();
+
+	const int numChunks = (m_Width + CHUNK_WIDTH - 1) / CHUNK_WIDTH;
+	m_ChunksPtrArr.reserve(numChunks);
+	for (int i = 0; i < numChunks; ++i)
+	{
+		const int left = i * CHUNK_WIDTH;
+		const int width = min(CHUNK_WIDTH, m_Width - left);
+		m_ChunksPtrArr.push_back(new Bitmap(imagePtr, left, 0, width, m_Height));
+	}
+
+	delete imagePtr;
+}
+
+ChunkedBitmap::~ChunkedBitmap()
+{
+	for (size_t i = 0; i < m_ChunksPtrArr.size(); ++i)
+	{
+		delete m_ChunksPtrArr[i];
+	}
+}
+
+void ChunkedBitmap::Paint(const RECT2& visibleRectRef)
+{
+	const int numChunks = int(m_ChunksPtrArr.size());
+	const int firstVisible = max(0, int(visibleRectRef.left) / CHUNK_WIDTH);
+	const int lastVisible = min(numChunks - 1, int(visibleRectRef.right) / CHUNK_WIDTH);
+
+	for (int i = 0; i < numChunks; ++i)
+	{
+		Bitmap* chunkPtr = m_ChunksPtrArr[i];
+		if (i < firstVisible - RELEASE_DISTANCE || i > lastVisible + RELEASE_DISTANCE)
+		{
+			if (chunkPtr->HasDeviceBitmap())
+			{
+				chunkPtr->ReleaseDeviceBitmap();
+				--m_NumLoadedChunks;
+			}
+		}
+		else if (i >= firstVisible - LOAD_DISTANCE && i <= lastVisible + LOAD_DISTANCE && chunkPtr->HasDeviceBitmap() == false)
+		{
+			chunkPtr->CreateDeviceBitmap();
+			if (chunkPtr->HasDeviceBitmap()) ++m_NumLoadedChunks;
+		}
+	}
+
+	for (int i = firstVisible; i <= lastVisible; ++i)
+	{
+		// Headless frames are painted on the CPU, straight from the decoded image
+		if (m_ChunksPtrArr[i]->HasDeviceBitmap() || GAME_ENGINE->IsHeadless())
+		{
+			GAME_ENGINE->DrawBitmap(m_ChunksPtrArr[i], i * CHUNK_WIDTH, 0);
+		}
+	}
+}
+
+void ChunkedBitmap::ReleaseAllChunks()
+{
+	for (size_t i = 0; i < m_ChunksPtrArr.size(); ++i)
+	{
+		m_ChunksPtrArr[i]->ReleaseDeviceBitmap();
+	}
+	m_NumLoadedChunks = 0;
+}
+
+int ChunkedBitmap::GetWidth() const
+{
+	return m_Width;
+}
+
+int ChunkedBitmap::GetHeight() const
+{
+	return m_Height;
+}
+
+int ChunkedBitmap::GetNumLoadedChunks() const
+{
+	return m_NumLoadedChunks;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+// An image as wide as a level, split into columns CHUNK_WIDTH pixels wide when it's loaded so no texture
+// gets too large for the video card. Only chunks which are on screen are painted, chunks close to the
+// screen are kept in video memory and the rest are released until the camera comes near them again
+class ChunkedBitmap
+{
+public:
+	ChunkedBitmap(const String& filePathRef);
+	virtual ~ChunkedBitmap();
+
+	ChunkedBitmap(const ChunkedBitmap&) = delete;
+	ChunkedBitmap& operator=(const ChunkedBitmap&) = delete;
+
+	// Paints the chunks overlapping visibleRectRef at their place in the level, and loads or releases
+	// the video memory of the chunks around them
+	void Paint(const RECT2& visibleRectRef);
+	// Frees the video memory of every chunk, e.g. when the level is left
+	void ReleaseAllChunks();
+
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetNumLoadedChunks() const;
+
+	static const int CHUNK_WIDTH = 256;
+	// Chunks this many chunks away from the screen are loaded before they're needed
+	static const int LOAD_DISTANCE = 1;
+	// Chunks further than this many chunks from the screen are released
+	static const int RELEASE_DISTANCE = 3;
+
+private:
+	std::vector<Bitmap*> m_ChunksPtrArr;
+	int m_Width;
+	int m_Height;
+	int m_NumLoadedChunks = 0;
+};
@@ -27,3 +27,10 @@ void CloudBlock::Paint()
 void CloudBlock::Hit()
 {
 }
+
+bool CloudBlock::ResetToSpawnState()
+{
+	ResetBodyAndAnimation();
+
+	return true;
+}
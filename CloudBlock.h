@@ -14,4 +14,5 @@ public:
 	void Tick(double deltaTime);
 	void Paint();
 	void Hit();
+	bool ResetToSpawnState();
 };
@@ -2,7 +2,6 @@
 
 #include "Coin.h"
 #include "Level.h"
-#include "CoinCollectParticle.h"
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
 
@@ -57,8 +56,7 @@ bool Coin::HasInfiniteLifetime()
 
 void Coin::GenerateParticles()
 {
-	CoinCollectParticle* coinParticlePtr = new CoinCollectParticle(m_ActPtr->GetPosition() + DOUBLE2(0, -15));
-	m_LevelPtr->AddParticle(coinParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::COIN_COLLECT, m_ActPtr->GetPosition() + DOUBLE2(0, -15));
 }
 
 void Coin::Paint()
@@ -88,3 +86,15 @@ bool Coin::IsBlock()
 {
 	return m_IsBlock;
 }
+
+bool Coin::ResetToSpawnState()
+{
+	// Coins which pop out of blocks are never part of the level's spawn data
+	if (HasInfiniteLifetime() == false) return false;
+
+	ResetBodyAndAnimation();
+	TurnToBlock(false);
+	m_IsActive = true;
+
+	return true;
+}
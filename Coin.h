@@ -21,6 +21,8 @@ public:
 
 	bool IsBlock();
 
+	bool ResetToSpawnState();
+
 protected:
 	static const int WIDTH = 16;
 	static const int HEIGHT = 16;
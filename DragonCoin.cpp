@@ -1,7 +1,6 @@
 #include "stdafx.h"
 
 #include "DragonCoin.h"
-#include "CoinCollectParticle.h"
 #include "Level.h"
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
@@ -24,8 +23,7 @@ void DragonCoin::Tick(double deltaTime)
 
 void DragonCoin::GenerateParticles()
 {
-	CoinCollectParticle* coinParticlePtr = new CoinCollectParticle(m_ActPtr->GetPosition() + DOUBLE2(0, -5));
-	m_LevelPtr->AddParticle(coinParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::COIN_COLLECT, m_ActPtr->GetPosition() + DOUBLE2(0, -5));
 }
 
 void DragonCoin::Paint()
@@ -25,22 +25,20 @@ Enemy::~Enemy()
 {
 }
 
-void Enemy::Tick(double deltaTime)
+void Enemy::SetActivated(bool activated)
 {
-	if (m_IsActive == false)
-	{
-		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_SpawingPosition.x) < MINIMUM_PLAYER_DISTANCE)
-		{
-			m_IsActive = true;
-		}
-	}
-	else
-	{
-		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_ActPtr->GetPosition().x) >= MINIMUM_PLAYER_DISTANCE)
-		{
-			m_IsActive = false;
-		}
-	}
+	m_IsActive = activated;
+}
+
+double Enemy::GetActivationX()
+{
+	if (m_IsActive && m_ActPtr != nullptr) return m_ActPtr->GetPosition().x;
+	else return m_SpawingPosition.x;
+}
+
+bool Enemy::IsMovedByPhysics()
+{
+	return false;
 }
 
 Enemy::Type Enemy::GetType() const
@@ -9,7 +9,9 @@ class Enemy : public Entity
 public:
 	enum class Type
 	{
-		NONE, KOOPA_TROOPA, CHARGIN_CHUCK, PIRHANA_PLANT, MONTY_MOLE
+		NONE, KOOPA_TROOPA, CHARGIN_CHUCK, PIRHANA_PLANT, MONTY_MOLE,
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
 	};
 
 	Enemy(Type type, DOUBLE2 centerPos, double width, double height, BodyType bodyType,
@@ -19,9 +21,14 @@ public:
 	Enemy(const Enemy&) = delete;
 	Enemy& operator=(const Enemy&) = delete;
 
-	void Tick(double deltaTime);
 	virtual void Paint() = 0;
 
+	void SetActivated(bool activated) override;
+	// Enemies come back when the player nears where they spawned, and go away once the player is far from where they are
+	double GetActivationX() override;
+	// Inactive enemies are measured from where they spawned, so their body moving doesn't matter
+	bool IsMovedByPhysics() override;
+
 	virtual int GetWidth() const = 0;
 	virtual int GetHeight() const = 0;
 
@@ -32,6 +39,9 @@ public:
 	static Type StringToTYPE(const std::string& string);
 
 protected:
+	// LevelData builds its enemy activation grid with MINIMUM_PLAYER_DISTANCE
+	friend class LevelData;
+
 	static const int MINIMUM_PLAYER_DISTANCE; // how close the player needs to get for us to activate
 
 	Type m_Type;
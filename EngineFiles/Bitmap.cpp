@@ -14,7 +14,7 @@
 // Bitmap methods
 //---------------------------
 // Load an Bitmap using a filename
-Bitmap::Bitmap(const String& fileName) : m_BitmapPtr(nullptr), m_ConvertorPtr(nullptr), m_Opacity(1.0), m_ResourceID(0)
+Bitmap::Bitmap(const String& fileName, bool createDeviceBitmap) : m_BitmapPtr(nullptr), m_ConvertorPtr(nullptr), m_Opacity(1.0), m_ResourceID(0)
 {
 	m_FileName = fileName;
 	//IWICFormatConverter *convertorPtr=nullptr;
@@ -22,7 +22,8 @@ Bitmap::Bitmap(const String& fileName) : m_BitmapPtr(nullptr), m_ConvertorPtr(nu
 	IWICImagingFactory *iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
 
 	HRESULT hr = LoadBitmapFromFile(renderTargetPtr, iWICFactoryPtr, m_FileName, 0, 0, &m_ConvertorPtr);
-	if (SUCCEEDED(hr))
+	// Without a render target (headless) only the decoded WIC image is kept
+	if (SUCCEEDED(hr) && renderTargetPtr != nullptr && createDeviceBitmap)
 	{
 		// Create a Direct2D bitmap from the WIC bitmap.
 		hr = renderTargetPtr->CreateBitmapFromWicBitmap(m_ConvertorPtr, &m_BitmapPtr);
@@ -43,7 +44,7 @@ Bitmap::Bitmap(int resourceID) : m_BitmapPtr(nullptr), m_ConvertorPtr(nullptr),
 	IWICImagingFactory* iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
 
 	HRESULT hr = LoadResourceBitmap(renderTargetPtr, iWICFactoryPtr, (unsigned int)resourceID, String("IMAGE"), &m_ConvertorPtr);
-	if (SUCCEEDED(hr))
+	if (SUCCEEDED(hr) && renderTargetPtr != nullptr)
 	{
 		//Create a Direct2D bitmap from the WIC bitmap.
 		hr = renderTargetPtr->CreateBitmapFromWicBitmap(m_ConvertorPtr, &m_BitmapPtr);
@@ -64,7 +65,7 @@ Bitmap::Bitmap(BYTE* pBlob, int blobSize) :m_BitmapPtr(nullptr), m_ConvertorPtr(
 	IWICImagingFactory* iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
 
 	HRESULT hr = LoadResourceFromStream(renderTargetPtr, iWICFactoryPtr, pBlob, blobSize, &m_ConvertorPtr);
-	if (SUCCEEDED(hr))
+	if (SUCCEEDED(hr) && renderTargetPtr != nullptr)
 	{
 		//Create a Direct2D bitmap from the WIC bitmap.
 		hr = renderTargetPtr->CreateBitmapFromWicBitmap(m_ConvertorPtr, &m_BitmapPtr);
@@ -78,9 +79,36 @@ Bitmap::Bitmap(BYTE* pBlob, int blobSize) :m_BitmapPtr(nullptr), m_ConvertorPtr(
 	}
 }
 
+// Copy a part of another Bitmap
+Bitmap::Bitmap(const Bitmap* sourcePtr, int left, int top, int width, int height) : m_BitmapPtr(nullptr), m_ConvertorPtr(nullptr), m_Opacity(1.0), m_ResourceID(0)
+{
+	m_FileName = sourcePtr->m_FileName;
+	IWICImagingFactory* iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
+
+	// The pixels are copied, so the source can be deleted while this part is still in use
+	IWICBitmap* iWICBitmapPtr = nullptr;
+	HRESULT hr = iWICFactoryPtr->CreateBitmapFromSourceRect(sourcePtr->m_ConvertorPtr, left, top, width, height, &iWICBitmapPtr);
+	if (SUCCEEDED(hr))
+	{
+		hr = iWICFactoryPtr->CreateFormatConverter(&m_ConvertorPtr);
+	}
+	if (SUCCEEDED(hr))
+	{
+		hr = m_ConvertorPtr->Initialize(iWICBitmapPtr, GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, NULL, 0.f, WICBitmapPaletteTypeMedianCut);
+	}
+	if (iWICBitmapPtr != nullptr) iWICBitmapPtr->Release();
+
+	if (FAILED(hr))
+	{
+		//show messagebox and leave the program
+		GameEngine::GetSingleton()->MessageBox(String("IMAGE COPYING ERROR File ") + m_FileName);
+		exit(-1);
+	}
+}
+
 Bitmap::~Bitmap()
 {
-	m_BitmapPtr->Release();
+	if (m_BitmapPtr != nullptr) m_BitmapPtr->Release();
 	m_ConvertorPtr->Release();
 }
 
@@ -290,6 +318,57 @@ HRESULT Bitmap::LoadResourceFromStream(ID2D1RenderTarget* renderTargetPtr, IWICI
 	return hr;
 }
 
+void Bitmap::CreateDeviceBitmap()
+{
+	ID2D1RenderTarget* renderTargetPtr = GameEngine::GetSingleton()->GetHwndRenderTarget();
+	if (m_BitmapPtr != nullptr || renderTargetPtr == nullptr) return;
+
+	HRESULT hr = renderTargetPtr->CreateBitmapFromWicBitmap(m_ConvertorPtr, &m_BitmapPtr);
+	if (FAILED(hr))
+	{
+		OutputDebugString(String("ERROR: Could not create the video memory of ") + m_FileName + String("\n"));
+		m_BitmapPtr = nullptr;
+	}
+}
+
+void Bitmap::ReleaseDeviceBitmap()
+{
+	if (m_BitmapPtr == nullptr) return;
+
+	m_BitmapPtr->Release();
+	m_BitmapPtr = nullptr;
+}
+
+bool Bitmap::HasDeviceBitmap() const
+{
+	return m_BitmapPtr != nullptr;
+}
+
+const std::vector<unsigned int>& Bitmap::GetSoftwarePixels()
+{
+	if (m_SoftwarePixelsArr.empty())
+	{
+		UINT width = 0, height = 0;
+		m_ConvertorPtr->GetSize(&width, &height);
+		UINT bitmapStride = 4 * width;
+		UINT size = width * height * 4;
+		unsigned char* pixelsPtr = new unsigned char[size];
+		m_ConvertorPtr->CopyPixels(NULL, bitmapStride, size, pixelsPtr);
+		StoreSoftwarePixels(pixelsPtr, width, height);
+		delete[] pixelsPtr;
+	}
+	return m_SoftwarePixelsArr;
+}
+
+void Bitmap::StoreSoftwarePixels(const unsigned char* pixelsPtr, UINT width, UINT height)
+{
+	m_SoftwarePixelsArr.resize(width * height);
+	for (unsigned int count = 0; count < width * height; ++count)
+	{
+		m_SoftwarePixelsArr[count] = pixelsPtr[count * 4 + 2] | (pixelsPtr[count * 4 + 1] << 8) | (pixelsPtr[count * 4] << 16) | (pixelsPtr[count * 4 + 3] << 24);
+	}
+}
+
 ID2D1Bitmap* Bitmap::GetBitmapPtr() const
 {
 	return m_BitmapPtr;
@@ -298,12 +377,24 @@ ID2D1Bitmap* Bitmap::GetBitmapPtr() const
 int Bitmap::GetWidth() const
 {
 	if (this == nullptr) MessageBoxA(NULL, "Bitmap::GetWidth() called from a pointer that is a nullptr\nThe MessageBox that will appear after you close this MessageBox is the default error message from visual studio.", "GameEngine says NO", MB_OK);
+	if (m_BitmapPtr == nullptr)
+	{
+		UINT width = 0, height = 0;
+		m_ConvertorPtr->GetSize(&width, &height);
+		return width;
+	}
 	return m_BitmapPtr->GetPixelSize().width;
 }
 
 int	Bitmap::GetHeight() const
 {
 	if (this == nullptr) MessageBoxA(NULL, "Bitmap::GetHeight() called from a pointer that is a nullptr\nThe MessageBox that will appear after you close this MessageBox is the default error message from visual studio.", "GameEngine says NO", MB_OK);
+	if (m_BitmapPtr == nullptr)
+	{
+		UINT width = 0, height = 0;
+		m_ConvertorPtr->GetSize(&width, &height);
+		return height;
+	}
 	return m_BitmapPtr->GetPixelSize().height;
 }
 
@@ -346,12 +437,17 @@ void Bitmap::SetTransparencyColor(COLOR transparentColor)
 	IWICImagingFactory* iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
 	IWICBitmap* iWICBitmapPtr = nullptr;
 	HRESULT hr = iWICFactoryPtr->CreateBitmapFromMemory(width, height, GUID_WICPixelFormat32bppPBGRA, bitmapStride, size, pixelsPtr, &iWICBitmapPtr);
+	// The converter still holds the original pixels, so the software copy is kept here
+	StoreSoftwarePixels(pixelsPtr, width, height);
 	delete[] pixelsPtr; //destroy buffer
 	if (hr == S_OK)
 	{
 		ID2D1RenderTarget *renderTargetPtr = GameEngine::GetSingleton()->GetHwndRenderTarget();
-		if (m_BitmapPtr != nullptr) m_BitmapPtr->Release();
-		renderTargetPtr->CreateBitmapFromWicBitmap(iWICBitmapPtr, &m_BitmapPtr);
+		if (renderTargetPtr != nullptr)
+		{
+			if (m_BitmapPtr != nullptr) m_BitmapPtr->Release();
+			renderTargetPtr->CreateBitmapFromWicBitmap(iWICBitmapPtr, &m_BitmapPtr);
+		}
 		iWICBitmapPtr->Release();
 	}
 }
@@ -386,12 +482,17 @@ void Bitmap::Invert()
 	IWICImagingFactory* iWICFactoryPtr = GameEngine::GetSingleton()->GetWICImagingFactory();
 	IWICBitmap* iWICBitmapPtr = nullptr;
 	HRESULT hr = iWICFactoryPtr->CreateBitmapFromMemory(width, height, GUID_WICPixelFormat32bppPBGRA, bitmapStride, size, pixelsPtr, &iWICBitmapPtr);
+	// The converter still holds the original pixels, so the software copy is kept here
+	StoreSoftwarePixels(pixelsPtr, width, height);
 	delete[] pixelsPtr; //destroy buffer
 	if (hr == S_OK)
 	{
 		ID2D1RenderTarget *renderTargetPtr = GameEngine::GetSingleton()->GetHwndRenderTarget();
-		if (m_BitmapPtr != nullptr) m_BitmapPtr->Release();
-		renderTargetPtr->CreateBitmapFromWicBitmap(iWICBitmapPtr, &m_BitmapPtr);
+		if (renderTargetPtr != nullptr)
+		{
+			if (m_BitmapPtr != nullptr) m_BitmapPtr->Release();
+			renderTargetPtr->CreateBitmapFromWicBitmap(iWICBitmapPtr, &m_BitmapPtr);
+		}
 		iWICBitmapPtr->Release();
 	}
 }
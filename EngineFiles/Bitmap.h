@@ -15,7 +15,8 @@ public:
 	// Constructors & Destructor
 	// -------------------------
 	//! Load an Bitmap using a filename
-	Bitmap(const String& fileNameRef);
+	//! When createDeviceBitmap is false the image is only decoded, call CreateDeviceBitmap before painting it
+	Bitmap(const String& fileNameRef, bool createDeviceBitmap = true);
 
 	//! Load an Bitmap using a resourceID
 	Bitmap(int resourceID);
@@ -23,6 +24,10 @@ public:
 	//! Load a Bitmap from memory
 	Bitmap(BYTE* pBlob, int blobSize);
 
+	//! Copies a part of another Bitmap's image, call CreateDeviceBitmap before painting it
+	//! Example: Bitmap* leftHalfPtr = new Bitmap(bmpPtr, 0, 0, bmpPtr->GetWidth() / 2, bmpPtr->GetHeight());
+	Bitmap(const Bitmap* sourcePtr, int left, int top, int width, int height);
+
 	virtual ~Bitmap();
 
 	// C++11 make the class non-copyable
@@ -44,6 +49,19 @@ public:
 	//! Returns the opacity of this image
 	double GetOpacity() const;
 
+	//! Uploads the image to video memory, if it isn't there yet
+	void CreateDeviceBitmap();
+
+	//! Frees the video memory of this image, it can't be painted until CreateDeviceBitmap is called again
+	void ReleaseDeviceBitmap();
+
+	//! Returns true when this image is in video memory and can be painted
+	bool HasDeviceBitmap() const;
+
+	//! Returns the pixels for the SoftwareRenderer, rows top to bottom in premultiplied RGBA (R in the lowest byte)
+	//! The pixels are copied out of the image the first time this is called
+	const std::vector<unsigned int>& GetSoftwarePixels();
+
 	//! The opacity level of an image has a range from 0 to 1
 	//! The GameEngine uses the opacity level to blend the image with the background
 	void SetOpacity(double opacity);
@@ -66,6 +84,8 @@ private:
 	HRESULT LoadBitmapFromFile(ID2D1RenderTarget* renderTargetPtr, IWICImagingFactory* wICFactoryPtr, const String& uriRef, UINT destinationWidth, UINT destinationHeight, IWICFormatConverter** formatConvertorPtrPtr);
 	// Not intended to be used by students
 	HRESULT LoadResourceFromStream(ID2D1RenderTarget* renderTargetPtr, IWICImagingFactory* wICFactoryPtr, byte* pBlob, int blobSize, IWICFormatConverter** formatConvertorPtr);
+	// Swaps the red and blue channels of 32bppPBGRA pixels into m_SoftwarePixelsArr
+	void StoreSoftwarePixels(const unsigned char* pixelsPtr, UINT width, UINT height);
 
 	//-------------------------------------------------
 	// Datamembers								
@@ -75,4 +95,5 @@ private:
 	double					m_Opacity;//range: between 0 and 1
 	String					m_FileName;
 	int						m_ResourceID;
+	std::vector<unsigned int> m_SoftwarePixelsArr; // empty until GetSoftwarePixels is called
 };
@@ -10,9 +10,9 @@
 #include "FmodSystem.h"
 
 
-FmodSystem::FmodSystem()
+FmodSystem::FmodSystem(bool silent)
 {
-	Initialize();
+	Initialize(silent);
 }
 
 
@@ -38,7 +38,7 @@ bool FmodSystem::ErrorCheck(FMOD_RESULT res)
 	return true;
 }
 
-void FmodSystem::Initialize()
+void FmodSystem::Initialize(bool silent)
 {
 	FMOD_RESULT result;
 	unsigned int version;
@@ -60,6 +60,16 @@ void FmodSystem::Initialize()
 		return;
 	}
 
+	if (silent)
+	{
+		// Non-realtime: nothing is mixed until System::update is called, and the result is thrown away
+		result = m_FmodSystemPtr->setOutput(FMOD_OUTPUTTYPE_NOSOUND_NRT);
+		ErrorCheck(result);
+		result = m_FmodSystemPtr->init(32, FMOD_INIT_NORMAL, 0);
+		ErrorCheck(result);
+		return;
+	}
+
 	result = m_FmodSystemPtr->getNumDrivers(&numdrivers);
 	ErrorCheck(result);
 	if (numdrivers == 0)
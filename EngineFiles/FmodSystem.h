@@ -10,7 +10,8 @@
 class FmodSystem
 {
 public:
-	FmodSystem();
+	//! silent: mix on demand only and discard the output, no sound device is opened
+	FmodSystem(bool silent = false);
 	virtual ~FmodSystem();
 
 	static bool ErrorCheck(FMOD_RESULT res);
@@ -21,7 +22,7 @@ public:
 	FmodSystem& operator=(const FmodSystem&) = delete;
 
 private:
-	void Initialize();
+	void Initialize(bool silent);
 	FMOD::System* m_FmodSystemPtr = nullptr;
 };
 
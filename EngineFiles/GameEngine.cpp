@@ -63,12 +63,16 @@ void GameEngine::ResetGameData()
 	m_BitmapInterpolationMode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
 	m_ConsoleHandle = 0;
 	m_bVSync = true;
+	m_bHeadless = false;
 	m_Gravity = DOUBLE2(0, 9.81);
 	m_UserFontPtr = nullptr;
 	m_MatView = MATRIX3X2::CreateIdentityMatrix();
 	m_MatWorld = MATRIX3X2::CreateIdentityMatrix();
 	m_DebugRendering = false;
 	m_PhysicsTimeStep = 1 / 60.0f;
+	m_MaxTicksPerFrame = 5;
+	m_DroppedTime = 0;
+	m_DroppedTicks = 0;
 }
 
 GameEngine::~GameEngine()
@@ -128,6 +132,11 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 	// Inputmanager
 	m_InputPtr = new InputManager();
 	m_InputPtr->Initialize();
+	if (!LoadInputReplay())
+	{
+		CleanUpGame();
+		return 1;
+	}
 
 	// Game Initialization
 	GameSettings gameSettings;
@@ -149,24 +158,8 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 	// Initialize the Graphics Engine
 	CreateDeviceResources();
 
-#pragma region Box2D
 	// Initialize Box2D
-	// Define the gravity vector.
-	b2Vec2 gravity((float)m_Gravity.x, (float)m_Gravity.y);
-
-	// Construct a world object, which will hold and simulate the rigid bodies.
-	m_Box2DWorldPtr = new b2World(gravity);
-	//m_Box2DWorldPtr->SetContactListener(m_GamePtr);
-	m_Box2DWorldPtr->SetContactListener(this);
-	m_Box2DWorldPtr->SetDestructionListener(this);
-
-
-	m_Box2DDebugRenderer.SetFlags(b2Draw::e_shapeBit);
-	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_centerOfMassBit);
-	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_jointBit);
-	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_pairBit);
-	m_Box2DWorldPtr->SetDebugDraw(&m_Box2DDebugRenderer);
-#pragma endregion
+	CreateBox2DWorld();
 
 	// User defined functions for start of the game
 	m_GamePtr->GameStart();
@@ -211,8 +204,11 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 				previous = current;  // reset
 				lag += elapsed;
 
-				while (lag >= m_PhysicsTimeStep)
+				int ticksThisFrame = 0;
+				while (lag >= m_PhysicsTimeStep && ticksThisFrame < m_MaxTicksPerFrame)
 				{
+					Profiler::BeginTick();
+
 					// Check the state of keyboard and mouse
 					m_InputPtr->Update();
 
@@ -224,7 +220,10 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 
 					int32 velocityIterations = 6;
 					int32 positionIterations = 2;
-					m_Box2DWorldPtr->Step((float)m_PhysicsTimeStep, velocityIterations, positionIterations);
+					{
+						ProfileScope profileScope(Profiler::Phase::PHYSICS_STEP);
+						m_Box2DWorldPtr->Step((float)m_PhysicsTimeStep, velocityIterations, positionIterations);
+					}
 
 					// Step generates contact lists, pass to Listeners and clear the vector
 					// CallListeners();
@@ -233,10 +232,20 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 					GUIConsumeEvents();
 
 					lag -= m_PhysicsTimeStep;
+					++ticksThisFrame;
 				}
 
-				// Paint using vsynch
-				ExecuteDirect2DPaint();
+				// Catching up any further would only make the next frame slower: drop the remaining whole ticks
+				if (lag >= m_PhysicsTimeStep)
+				{
+					int ticksToDrop = int(lag / m_PhysicsTimeStep);
+					m_DroppedTicks += ticksToDrop;
+					m_DroppedTime += ticksToDrop * m_PhysicsTimeStep;
+					lag -= ticksToDrop * m_PhysicsTimeStep;
+				}
+
+				// Paint using vsynch, alpha tells how far we are into the next tick
+				ExecuteDirect2DPaint(lag / m_PhysicsTimeStep);
 
 			}
 			else WaitMessage(); // if the engine is sleeping or the game loop isn't supposed to run, wait for the next windows message.
@@ -269,6 +278,154 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 		m_ConsoleHandle = NULL;
 	}
 
+	CleanUpGame();
+
+	return msg.wParam;
+}
+
+int GameEngine::RunHeadless(int numTicks)
+{
+	// create the game engine object, exit if failure
+	if (GameEngine::GetSingleton() == nullptr) return 1;
+
+	// reset members in between different game objects
+	ResetGameData();
+	m_bHeadless = true;
+	m_bHeadlessQuit = false;
+
+	// Replace the audio system by one that mixes nothing and never touches a sound device
+	delete m_FmodSystemPtr;
+	m_FmodSystemPtr = new FmodSystem(true);
+
+	//Initialize the high precision timers
+	m_GameTickTimerPtr = new PrecisionTimer();
+	m_GameTickTimerPtr->Reset();
+
+	// Inputmanager, reads from the in-memory keyboard instead of the windows keyboard
+	m_InputPtr = new InputManager();
+	m_InputPtr->Initialize();
+	if (!LoadInputReplay())
+	{
+		// Nothing has been initialized yet, so there is no GameEnd to call
+		CleanUpGame();
+		m_bHeadless = false;
+		return 1;
+	}
+
+	// A replay runs exactly as many ticks as were recorded, unless told otherwise.
+	// The recording starts after the tick which created the level, so that tick is run as well
+	if (numTicks <= 0 && m_InputPtr->IsReplaying()) numTicks = m_InputPtr->GetReplayTickCount() + 1;
+
+	// Game Initialization
+	GameSettings gameSettings;
+	m_GamePtr->GameInitialize(gameSettings);
+	ApplyGameSettings(gameSettings);
+
+	// No window and no render target: only the device independent resources are used
+	m_DefaultFontPtr = new Font(String("Consolas"), 12);
+	m_UserFontPtr = m_DefaultFontPtr;
+
+	// Initialize Box2D
+	CreateBox2DWorld();
+
+	// User defined functions for start of the game
+	m_GamePtr->GameStart();
+
+	// A run which can't write the frames it was asked for stops and fails
+	int exitCode = 0;
+
+	// Frames are only painted when asked for, on the CPU since there is no render target
+	if (m_HeadlessFrameFolder.Length() > 0)
+	{
+		if (CreateDirectoryA(m_HeadlessFrameFolder.C_str(), NULL) == FALSE && GetLastError() != ERROR_ALREADY_EXISTS)
+		{
+			MessageBox(String("Could not create the frame folder ") + m_HeadlessFrameFolder);
+			exitCode = 1;
+		}
+		else
+		{
+			m_SoftwareRendererPtr = new SoftwareRenderer(GetWidth(), GetHeight());
+			m_SoftwareRendererPtr->SetTransform(m_MatWorld * m_MatView);
+		}
+	}
+
+	// There is nothing to wait for, so run the ticks back to back
+	m_bSleep = false;
+	m_GameTickTimerPtr->Start();
+	double startTime = m_GameTickTimerPtr->GetGameTime();
+
+	int tickCount = 0;
+	m_HeadlessTicksRun = 0;
+	while (tickCount < numTicks && m_bHeadlessQuit == false && exitCode == 0)
+	{
+		Profiler::BeginTick();
+
+		if (m_HeadlessTickCallbackPtr != nullptr) m_HeadlessTickCallbackPtr();
+
+		m_InputPtr->Update();
+
+		m_GamePtr->GameTick(m_PhysicsTimeStep);
+
+		int32 velocityIterations = 6;
+		int32 positionIterations = 2;
+		{
+			ProfileScope profileScope(Profiler::Phase::PHYSICS_STEP);
+			m_Box2DWorldPtr->Step((float)m_PhysicsTimeStep, velocityIterations, positionIterations);
+		}
+
+		m_FmodSystemPtr->GetSystem()->update();
+
+		++tickCount;
+		m_HeadlessTicksRun = tickCount;
+
+		if (m_SoftwareRendererPtr != nullptr && tickCount % m_HeadlessTicksPerFrame == 0 && ExecuteSoftwarePaint(tickCount) == false)
+		{
+			exitCode = 1;
+		}
+	}
+
+	double totalTime = m_GameTickTimerPtr->GetGameTime() - startTime;
+	std::cout << "Headless run: " << tickCount << " ticks in " << totalTime << " s";
+	if (totalTime > 0.0) std::cout << " (" << tickCount / totalTime << " ticks/sec)";
+	std::cout << std::endl;
+
+// Clean up 
+
+	// User defined code for exiting the game
+	m_GamePtr->GameEnd();
+
+	CleanUpGame();
+
+	delete m_SoftwareRendererPtr;
+	m_SoftwareRendererPtr = nullptr;
+	m_bHeadless = false;
+
+	return exitCode;
+}
+
+void GameEngine::CreateBox2DWorld()
+{
+	// Define the gravity vector.
+	b2Vec2 gravity((float)m_Gravity.x, (float)m_Gravity.y);
+
+	// Construct a world object, which will hold and simulate the rigid bodies.
+	m_Box2DWorldPtr = new b2World(gravity);
+	//m_Box2DWorldPtr->SetContactListener(m_GamePtr);
+	m_Box2DWorldPtr->SetContactListener(this);
+	m_Box2DWorldPtr->SetDestructionListener(this);
+
+
+	m_Box2DDebugRenderer.SetFlags(b2Draw::e_shapeBit);
+	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_centerOfMassBit);
+	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_jointBit);
+	m_Box2DDebugRenderer.AppendFlags(b2Draw::e_pairBit);
+	m_Box2DWorldPtr->SetDebugDraw(&m_Box2DDebugRenderer);
+}
+
+void GameEngine::CleanUpGame()
+{
+	EndInputRecording();
+
 	delete m_Box2DWorldPtr;
 	delete m_InputPtr;
 	delete m_GameTickTimerPtr;
@@ -280,19 +437,20 @@ int GameEngine::Run(HINSTANCE hInstance, int iCmdShow)
 	m_GameTickTimerPtr = nullptr;
 	m_GamePtr = nullptr;
 	m_DefaultFontPtr = nullptr;
-
-	return msg.wParam;
+	m_UserFontPtr = nullptr;
 }
 
-void GameEngine::ExecuteDirect2DPaint()
+void GameEngine::ExecuteDirect2DPaint(double alpha)
 {
+	ProfileScope profileScope(Profiler::Phase::PAINT);
+
 	D2DBeginPaint();
 	RECT usedClientRect = { 0, 0, GetWidth(), GetHeight() };
 
 	m_bPaintingAllowed = true;
 	// make sure the view matrix is taken in account
 	SetWorldMatrix(MATRIX3X2::CreateIdentityMatrix());
-	m_GamePtr->GamePaint();
+	m_GamePtr->GamePaint(alpha);
 
 	//Paint the buttons and textboxes
 	GUIPaint();
@@ -370,11 +528,22 @@ bool GameEngine::OpenWindow(int iCmdShow)
 
 void GameEngine::QuitGame()
 {
+	if (m_bHeadless)
+	{
+		m_bHeadlessQuit = true;
+		return;
+	}
 	PostMessage(GameEngine::GetWindow(), WM_DESTROY, 0, 0);
 }
 
 void GameEngine::MessageBox(const String &text) const
 {
+	// There is nobody to click the box away when running headless
+	if (m_bHeadless)
+	{
+		std::cerr << text.C_str() << std::endl;
+		return;
+	}
 	MessageBoxA(GetWindow(), text.C_str(), m_Title.C_str(), MB_ICONEXCLAMATION | MB_OK);
 }
 
@@ -509,6 +678,31 @@ void GameEngine::SetInstance(HINSTANCE hInstance)
 	m_hInstance = hInstance;
 }
 
+bool GameEngine::ExecuteSoftwarePaint(int tickCount)
+{
+	{
+		ProfileScope profileScope(Profiler::Phase::PAINT);
+
+		m_SoftwareRendererPtr->Clear(COLOR(255, 255, 255));
+
+		m_bPaintingAllowed = true;
+		SetWorldMatrix(MATRIX3X2::CreateIdentityMatrix());
+		m_GamePtr->GamePaint(1.0);
+		GUIPaint();
+		m_bPaintingAllowed = false;
+	}
+
+	std::stringstream filePathStream;
+	filePathStream << m_HeadlessFrameFolder.C_str() << "/frame_" << std::setfill('0') << std::setw(6) << tickCount << ".png";
+	const String filePath(filePathStream.str().c_str());
+	if (m_SoftwareRendererPtr->WritePNG(filePath) == false)
+	{
+		MessageBox(String("Could not write frame ") + filePath);
+		return false;
+	}
+	return true;
+}
+
 void GameEngine::SetWindow(HWND hWindow)
 {
 	m_hWindow = hWindow;
@@ -516,6 +710,9 @@ void GameEngine::SetWindow(HWND hWindow)
 
 bool GameEngine::CanIPaint() const
 {
+	// Without a render target draw calls are no-ops, unless headless frames are painted on the CPU
+	if (m_bHeadless) return m_bPaintingAllowed && m_SoftwareRendererPtr != nullptr;
+
 	if (m_bPaintingAllowed) return true;
 	else
 	{
@@ -528,11 +725,14 @@ bool GameEngine::CanIPaint() const
 
 void GameEngine::SetColor(COLOR color)
 {
+	if (m_SoftwareRendererPtr != nullptr) m_SoftwareRendererPtr->SetColor(color);
+	if (m_ColorBrushPtr == nullptr) return;
 	m_ColorBrushPtr->SetColor(D2D1::ColorF((FLOAT)(color.red / 255.0), (FLOAT)(color.green / 255.0), (FLOAT)(color.blue / 255.0), (FLOAT)(color.alpha / 255.0)));
 }
 
 COLOR GameEngine::GetColor()
 {
+	if (m_ColorBrushPtr == nullptr) return COLOR();
 	D2D1_COLOR_F dColor = m_ColorBrushPtr->GetColor();
 	return COLOR((unsigned char)(dColor.r * 255), (unsigned char)(dColor.g * 255), (unsigned char)(dColor.b * 255), (unsigned char)(dColor.a * 255));
 }
@@ -541,6 +741,13 @@ bool GameEngine::DrawSolidBackground(COLOR backgroundColor)
 {
 	if (!CanIPaint()) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->Clear(backgroundColor);
+		return true;
+	}
+
+	FlushSpriteBatch();
 	m_RenderTargetPtr->Clear(D2D1::ColorF((FLOAT)(backgroundColor.red / 255.0), (FLOAT)(backgroundColor.green / 255.0), (FLOAT)(backgroundColor.blue / 255.0), (FLOAT)(backgroundColor.alpha)));
 
 	return true;
@@ -554,6 +761,12 @@ bool GameEngine::DrawLine(double x1, double y1, double x2, double y2, double str
 bool GameEngine::DrawLine(DOUBLE2 p1, DOUBLE2 p2, double strokeWidth)
 {
 	if (!CanIPaint()) return false;
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawLine(p1, p2, strokeWidth);
+		return true;
+	}
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawLine(Point2F((FLOAT)p1.x, (FLOAT)p1.y), Point2F((FLOAT)p2.x, (FLOAT)p2.y), m_ColorBrushPtr, (FLOAT)strokeWidth);
 
 	return true;
@@ -587,6 +800,12 @@ bool GameEngine::FillPolygon(const std::vector<DOUBLE2>& ptsArrRef)
 	//do not fill an empty polygon
 	if (count < 2) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillPolygon(ptsArrRef);
+		return true;
+	}
+
 	HRESULT hr;
 
 	// Create path geometry
@@ -631,6 +850,7 @@ bool GameEngine::FillPolygon(const std::vector<DOUBLE2>& ptsArrRef)
 
 	if (SUCCEEDED(hr))
 	{
+		FlushSpriteBatch();
 		m_RenderTargetPtr->FillGeometry(geometryPtr, m_ColorBrushPtr);
 		geometryPtr->Release();
 		return true;
@@ -661,7 +881,13 @@ bool GameEngine::DrawRect(RECT2 rect, double strokeWidth)
 	{
 		OutputDebugString(String("GameEngine::DrawRect warning: invalid dimensions! (left > right or top > bottom)\n"));
 	}
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawRect(rect, strokeWidth);
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)rect.left, (FLOAT)rect.top, (FLOAT)rect.right, (FLOAT)rect.bottom);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawRectangle(d2dRect, m_ColorBrushPtr, (FLOAT)strokeWidth);
 
 	return true;
@@ -689,7 +915,14 @@ bool GameEngine::FillRect(RECT2 rect)
 			OutputDebugString(String("GameEngine::FillRect warning: invalid dimensions! (left > right or top > bottom)\n"));
 	}
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillRect(rect);
+		return true;
+	}
+
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)rect.left, (FLOAT)rect.top, (FLOAT)rect.right, (FLOAT)rect.bottom);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillRectangle(d2dRect, m_ColorBrushPtr);
 
 	return true;
@@ -698,8 +931,15 @@ bool GameEngine::FillRect(RECT2 rect)
 bool GameEngine::DrawRoundedRect(double left, double top, double right, double bottom, double radiusX, double radiusY, double strokeWidth)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawRect(RECT2(left, top, right, bottom), strokeWidth);
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)left, (FLOAT)top, (FLOAT)(right), (FLOAT)(bottom));
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr, (FLOAT)strokeWidth);
 	return true;
 }
@@ -707,8 +947,15 @@ bool GameEngine::DrawRoundedRect(double left, double top, double right, double b
 bool GameEngine::DrawRoundedRect(DOUBLE2 topLeft, DOUBLE2 rightbottom, double radiusX, double radiusY, double strokeWidth)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawRect(RECT2(topLeft.x, topLeft.y, rightbottom.x, rightbottom.y), strokeWidth);
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)topLeft.x, (FLOAT)topLeft.y, (FLOAT)(rightbottom.x), (FLOAT)(rightbottom.y));
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr, (FLOAT)strokeWidth);
 	return true;
 }
@@ -716,8 +963,15 @@ bool GameEngine::DrawRoundedRect(DOUBLE2 topLeft, DOUBLE2 rightbottom, double ra
 bool GameEngine::FillRoundedRect(double left, double top, double right, double bottom, double radiusX, double radiusY)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillRect(RECT2(left, top, right, bottom));
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)left, (FLOAT)top, (FLOAT)(right), (FLOAT)(bottom));
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr);
 	return true;
 }
@@ -726,8 +980,15 @@ bool GameEngine::FillRoundedRect(double left, double top, double right, double b
 bool GameEngine::FillRoundedRect(DOUBLE2 topLeft, DOUBLE2 rightbottom, double radiusX, double radiusY)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillRect(RECT2(topLeft.x, topLeft.y, rightbottom.x, rightbottom.y));
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)topLeft.x, (FLOAT)topLeft.y, (FLOAT)(rightbottom.x), (FLOAT)(rightbottom.y));
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr);
 	return true;
 }
@@ -735,8 +996,15 @@ bool GameEngine::FillRoundedRect(DOUBLE2 topLeft, DOUBLE2 rightbottom, double ra
 bool GameEngine::DrawRoundedRect(RECT2 rect, double radiusX, double radiusY, double strokeWidth)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawRect(rect, strokeWidth);
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)rect.left, (FLOAT)rect.top, (FLOAT)rect.right, (FLOAT)rect.bottom);
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr, (FLOAT)strokeWidth);
 	return true;
 }
@@ -744,8 +1012,15 @@ bool GameEngine::DrawRoundedRect(RECT2 rect, double radiusX, double radiusY, dou
 bool GameEngine::FillRoundedRect(RECT2 rect, double radiusX, double radiusY)
 {
 	if (!CanIPaint()) return false;
+	// The software renderer paints the corners square
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillRect(rect);
+		return true;
+	}
 	D2D1_RECT_F d2dRect = D2D1::RectF((FLOAT)rect.left, (FLOAT)rect.top, (FLOAT)rect.right, (FLOAT)rect.bottom);
 	D2D1_ROUNDED_RECT  d2dRoundedRect = D2D1::RoundedRect(d2dRect, (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillRoundedRectangle(d2dRoundedRect, m_ColorBrushPtr);
 	return true;
 }
@@ -763,7 +1038,14 @@ bool GameEngine::DrawEllipse(double centerX, double centerY, double radiusX, dou
 {
 	if (!CanIPaint()) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawEllipse(DOUBLE2(centerX, centerY), radiusX, radiusY, strokeWidth);
+		return true;
+	}
+
 	D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F((FLOAT)centerX, (FLOAT)centerY), (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawEllipse(ellipse, m_ColorBrushPtr, (FLOAT)strokeWidth);
 
 	return true;
@@ -773,7 +1055,14 @@ bool GameEngine::DrawEllipse(DOUBLE2 centerPt, double radiusX, double radiusY, d
 {
 	if (!CanIPaint()) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawEllipse(centerPt, radiusX, radiusY, strokeWidth);
+		return true;
+	}
+
 	D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F((FLOAT)centerPt.x, (FLOAT)centerPt.y), (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawEllipse(ellipse, m_ColorBrushPtr, (FLOAT)strokeWidth);
 
 	return true;
@@ -792,7 +1081,14 @@ bool GameEngine::FillEllipse(double centerX, double centerY, double radiusX, dou
 {
 	if (!CanIPaint()) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillEllipse(DOUBLE2(centerX, centerY), radiusX, radiusY);
+		return true;
+	}
+
 	D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F((FLOAT)centerX, (FLOAT)centerY), (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillEllipse(ellipse, m_ColorBrushPtr);
 
 	return true;
@@ -802,7 +1098,14 @@ bool GameEngine::FillEllipse(DOUBLE2 centerPt, double radiusX, double radiusY)
 {
 	if (!CanIPaint()) return false;
 
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->FillEllipse(centerPt, radiusX, radiusY);
+		return true;
+	}
+
 	D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F((FLOAT)centerPt.x, (FLOAT)centerPt.y), (FLOAT)radiusX, (FLOAT)radiusY);
+	FlushSpriteBatch();
 	m_RenderTargetPtr->FillEllipse(ellipse, m_ColorBrushPtr);
 
 	return true;
@@ -831,6 +1134,10 @@ bool GameEngine::DrawString(const String& text, DOUBLE2 topLeft, double right, d
 	}
 	D2D1_RECT_F layoutRect = (RectF)((FLOAT)topLeft.x, (FLOAT)topLeft.y, (FLOAT)(right), (FLOAT)(bottom));
 
+	// The software renderer has no text rasterizer
+	if (m_SoftwareRendererPtr != nullptr) return false;
+
+	FlushSpriteBatch();
 	m_RenderTargetPtr->DrawText(stext.c_str(), stext.length(), m_UserFontPtr->GetTextFormat(), layoutRect, m_ColorBrushPtr, options);
 
 	return true;
@@ -894,7 +1201,14 @@ bool GameEngine::DrawBitmap(Bitmap* imagePtr, DOUBLE2 position, RECT2 srcRect)
 	dstRect_f.top = (FLOAT)position.y;
 	dstRect_f.bottom = dstRect_f.top + (FLOAT)(srcRect.bottom - srcRect.top);
 
-	m_RenderTargetPtr->DrawBitmap(imagePtr->GetBitmapPtr(), dstRect_f, (FLOAT)imagePtr->GetOpacity(), m_BitmapInterpolationMode, srcRect_f);
+	if (m_SoftwareRendererPtr != nullptr)
+	{
+		m_SoftwareRendererPtr->DrawBitmap(imagePtr, position, srcRect, imagePtr->GetOpacity());
+		return true;
+	}
+
+	// Drawn the next time anything else is drawn, or at the end of the frame
+	m_SpriteBatch.Add(imagePtr->GetBitmapPtr(), dstRect_f, srcRect_f, (FLOAT)imagePtr->GetOpacity(), m_BitmapInterpolationMode, m_Transform);
 
 	return true;
 }
@@ -903,8 +1217,10 @@ bool GameEngine::DrawBitmap(Bitmap* imagePtr, DOUBLE2 position, RECT2 srcRect)
 void GameEngine::SetWorldMatrix(const MATRIX3X2& mat)
 {
 	m_MatWorld = mat;
-	D2D1::Matrix3x2F matDirect2D = (m_MatWorld * m_MatView).ToMatrix3x2F();
-	m_RenderTargetPtr->SetTransform(matDirect2D);
+	// Applied to the render target by the next draw which needs it
+	m_Transform = (m_MatWorld * m_MatView).ToMatrix3x2F();
+	m_IsTransformApplied = false;
+	if (m_SoftwareRendererPtr != nullptr) m_SoftwareRendererPtr->SetTransform(m_MatWorld * m_MatView);
 }
 
 MATRIX3X2 GameEngine::GetWorldMatrix()
@@ -916,8 +1232,10 @@ MATRIX3X2 GameEngine::GetWorldMatrix()
 void GameEngine::SetViewMatrix(const MATRIX3X2& mat)
 {
 	m_MatView = mat;
-	D2D1::Matrix3x2F matDirect2D = (m_MatWorld * m_MatView).ToMatrix3x2F();
-	m_RenderTargetPtr->SetTransform(matDirect2D);
+	// Applied to the render target by the next draw which needs it
+	m_Transform = (m_MatWorld * m_MatView).ToMatrix3x2F();
+	m_IsTransformApplied = false;
+	if (m_SoftwareRendererPtr != nullptr) m_SoftwareRendererPtr->SetTransform(m_MatWorld * m_MatView);
 }
 
 MATRIX3X2 GameEngine::GetViewMatrix()
@@ -1159,6 +1477,98 @@ bool GameEngine::IsMouseButtonReleased(int button) const
 	return m_InputPtr->IsMouseButtonReleased(button);
 }
 
+void GameEngine::SetKeyboardKeyDown(int key, bool down)
+{
+	m_InputPtr->SetVirtualKeyDown(key, down);
+}
+
+bool GameEngine::IsHeadless() const
+{
+	return m_bHeadless;
+}
+
+void GameEngine::SetInputRecordingFilePath(const String& filePathRef)
+{
+	m_InputRecordingFilePath = filePathRef;
+}
+
+void GameEngine::SetInputReplayFilePath(const String& filePathRef)
+{
+	m_InputReplayFilePath = filePathRef;
+}
+
+int GameEngine::GetHeadlessTicksRun() const
+{
+	return m_HeadlessTicksRun;
+}
+
+void GameEngine::SetHeadlessTickCallback(void (*tickCallbackPtr)())
+{
+	m_HeadlessTickCallbackPtr = tickCallbackPtr;
+}
+
+void GameEngine::SetHeadlessFrameOutput(const String& folderPathRef, int ticksPerFrame)
+{
+	m_HeadlessFrameFolder = folderPathRef;
+	m_HeadlessTicksPerFrame = max(1, ticksPerFrame);
+}
+
+bool GameEngine::LoadInputReplay()
+{
+	if (m_InputReplayFilePath.Length() == 0) return true;
+
+	if (!m_InputPtr->LoadReplay(m_InputReplayFilePath))
+	{
+		MessageBox(String("Could not load input recording ") + m_InputReplayFilePath);
+		return false;
+	}
+	return true;
+}
+
+void GameEngine::BeginLevelInput(int levelIndex)
+{
+	if (m_InputPtr->IsReplaying())
+	{
+		// Only the first level of a replay starts it, randomness has to play out exactly like it did while recording
+		if (m_InputPtr->IsReplayStarted()) return;
+		srand(m_InputPtr->GetReplayRandomSeed());
+		m_InputPtr->StartReplay();
+		return;
+	}
+
+	// Like a replay, a recording covers the first level only. Starting another one would truncate the file
+	if (m_InputRecordingFilePath.Length() == 0 || m_InputRecordingStarted) return;
+	m_InputRecordingStarted = true;
+
+	// Seed rand() so the replay can do the same
+	unsigned int randomSeed = GetTickCount();
+	srand(randomSeed);
+	m_InputPtr->StartRecording(m_InputRecordingFilePath, levelIndex, randomSeed);
+}
+
+void GameEngine::EndInputRecording()
+{
+	if (m_InputPtr != nullptr && m_InputPtr->IsRecording())
+	{
+		m_InputPtr->StopRecording();
+	}
+}
+
+bool GameEngine::IsRecordingInput() const
+{
+	return m_InputPtr != nullptr && m_InputPtr->IsRecording();
+}
+
+bool GameEngine::IsReplayingInput() const
+{
+	return m_InputPtr != nullptr && m_InputPtr->IsReplaying();
+}
+
+int GameEngine::GetInputReplayLevelIndex() const
+{
+	return m_InputPtr->GetReplayLevelIndex();
+}
+
 
 LRESULT GameEngine::HandleEvent(HWND hWindow, UINT msg, WPARAM wParam, LPARAM lParam)
 {
@@ -1477,6 +1887,8 @@ void GameEngine::D2DBeginPaint()
 	{
 		m_RenderTargetPtr->BeginDraw();
 		m_RenderTargetPtr->SetTransform(D2D1::Matrix3x2F::Identity());
+		m_Transform = D2D1::Matrix3x2F::Identity();
+		m_IsTransformApplied = true;
 
 		// Paint the client area using a white color
 		m_RenderTargetPtr->Clear((D2D1::ColorF) D2D1::ColorF::White);
@@ -1488,6 +1900,9 @@ void GameEngine::D2DBeginPaint()
 
 bool GameEngine::D2DEndPaint()
 {
+	FlushSpriteBatch();
+	m_SpriteBatch.EndFrame();
+
 	HRESULT hr = S_OK;
 	hr = m_RenderTargetPtr->EndDraw();
 
@@ -1499,15 +1914,58 @@ bool GameEngine::D2DEndPaint()
 	return true;
 }
 
+void GameEngine::FlushSpriteBatch()
+{
+	if (!m_SpriteBatch.IsEmpty())
+	{
+		m_SpriteBatch.Flush(m_RenderTargetPtr);
+		// The batch leaves the transform of its last sprite on the render target
+		m_IsTransformApplied = false;
+	}
+
+	if (!m_IsTransformApplied)
+	{
+		m_RenderTargetPtr->SetTransform(m_Transform);
+		m_IsTransformApplied = true;
+	}
+}
+
+int GameEngine::GetSpritesDrawnLastFrame() const
+{
+	return m_SpriteBatch.GetSpritesLastFrame();
+}
+
+int GameEngine::GetSpriteBatchesLastFrame() const
+{
+	return m_SpriteBatch.GetBatchesLastFrame();
+}
+
 //Box2D settings
 void GameEngine::SetGravity(const DOUBLE2 gravity)
 {
 	m_Box2DWorldPtr->SetGravity(b2Vec2((float32)gravity.x, (float32)gravity.y));
 }
 
+void GameEngine::SetMaxTicksPerFrame(int maxTicks)
+{
+	m_MaxTicksPerFrame = max(1, maxTicks);
+}
+
+double GameEngine::GetDroppedTime() const
+{
+	return m_DroppedTime;
+}
+
+int GameEngine::GetDroppedTicks() const
+{
+	return m_DroppedTicks;
+}
+
 // Box2D overloads
 void GameEngine::BeginContact(b2Contact* contactPtr)
 {
+	ProfileScope profileScope(Profiler::Phase::CONTACT_CALLBACKS);
+
 	b2Fixture * fixContactListenerPtr = nullptr;
 	b2Fixture * fixOtherPtr = nullptr;
 
@@ -1546,6 +2004,8 @@ void GameEngine::BeginContact(b2Contact* contactPtr)
 
 void GameEngine::EndContact(b2Contact* contactPtr)
 {
+	ProfileScope profileScope(Profiler::Phase::CONTACT_CALLBACKS);
+
 	b2Fixture * fixContactListenerPtr = nullptr;
 	b2Fixture * fixOtherPtr = nullptr;
 
@@ -1584,6 +2044,8 @@ void GameEngine::EndContact(b2Contact* contactPtr)
 
 void GameEngine::PreSolve(b2Contact* contactPtr, const b2Manifold* oldManifoldPtr)
 {
+	ProfileScope profileScope(Profiler::Phase::CONTACT_CALLBACKS);
+
 	b2Fixture * fixContactListenerPtr = nullptr;
 	b2Fixture * fixOtherPtr = nullptr;
 
@@ -22,6 +22,7 @@ class PrecisionTimer;
 class b2World;
 class ContactListener;
 class FmodSystem;
+class SoftwareRenderer;
 
 // Includes
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
@@ -57,9 +58,22 @@ public:
 	// General Methods used by GameWinMain
 	void SetGame(AbstractGame* gamePtr);
 	int Run(HINSTANCE hInstance, int iCmdShow);
+	// Returns 0 on success, like a process exit code. GetHeadlessTicksRun tells how many ticks ran
+	int RunHeadless(int numTicks);
+	void SetInputRecordingFilePath(const String& filePathRef);
+	void SetInputReplayFilePath(const String& filePathRef);
+	void SetHeadlessFrameOutput(const String& folderPathRef, int ticksPerFrame);
+	// Called at the start of every RunHeadless tick, before the input update, so a runner can script the in-memory keyboard
+	void SetHeadlessTickCallback(void (*tickCallbackPtr)());
 	static void Destroy();
 #endif
 
+	//! Returns true when the engine runs without a window, render target or audio output
+	bool IsHeadless() const;
+
+	//! Returns how many ticks the last (or current) RunHeadless has run
+	int GetHeadlessTicksRun() const;
+
 // Input methods
 	// Returns a DOUBLE2 containing the window coordinates of the mouse
 	// Usage example:
@@ -90,6 +104,28 @@ public:
 	//! Possible values for button are: VK_LBUTTON, VK_RBUTTON and VK_MBUTTON
 	bool IsMouseButtonReleased(int button) const;
 
+	//! Sets the state of a key in the in-memory keyboard used in headless mode
+	//! The new state is picked up by the Is...() methods after the next input update
+	void SetKeyboardKeyDown(int key, bool down);
+
+	//! Seeds rand() and starts recording the keyboard state of every tick to the file passed with "-record <file>",
+	//! or starts replaying the file passed with "-replay <file>" after seeding rand() like the recorded run did.
+	//! Does nothing when neither was given, or when a recording or replay was already started in this process.
+	//! Call this right before a level is created, levelIndex is stored in the recording so the replay can start in the same level
+	void BeginLevelInput(int levelIndex);
+
+	//! Writes the recording started by BeginLevelInput to disk
+	void EndInputRecording();
+
+	//! Returns true while the keyboard state is being written to the file passed with "-record <file>"
+	bool IsRecordingInput() const;
+
+	//! Returns true when a recording was passed with "-replay <file>", the keyboard is replaced by it once its level begins
+	bool IsReplayingInput() const;
+
+	//! Returns the index of the level the recording being replayed was made in
+	int GetInputReplayLevelIndex() const;
+
 	// Add GUI derived object to the GUI std::vector to be ticked automatically
 	// NOT for students
 	void RegisterGUI(GUIBase *guiPtr);
@@ -332,12 +368,35 @@ public:
 	//! Set the Box2D world gravity vector
 	void SetGravity(DOUBLE2 gravity);
 
+	//! Sets how many GameTicks may run back to back to catch up after a slow frame
+	//! Any time that is still left after that is dropped
+	void SetMaxTicksPerFrame(int maxTicks);
+
+	//! Returns the total amount of game time (in seconds) that was dropped because of the tick cap
+	double GetDroppedTime() const;
+
+	//! Returns the total number of ticks that were dropped because of the tick cap
+	int GetDroppedTicks() const;
+
+	//! Returns the number of bitmaps drawn last frame
+	int GetSpritesDrawnLastFrame() const;
+
+	//! Returns the number of batches the bitmaps of last frame were drawn in
+	int GetSpriteBatchesLastFrame() const;
+
 private:
 
 #ifndef WRAPPER_LIB
 	// General Methods used by GameWinMain
 	void SetGame(AbstractGame* gamePtr);
 	int Run(HINSTANCE hInstance, int iCmdShow);
+	// Returns 0 on success, like a process exit code. GetHeadlessTicksRun tells how many ticks ran
+	int RunHeadless(int numTicks);
+	void SetInputRecordingFilePath(const String& filePathRef);
+	void SetInputReplayFilePath(const String& filePathRef);
+	void SetHeadlessFrameOutput(const String& folderPathRef, int ticksPerFrame);
+	// Called at the start of every RunHeadless tick, before the input update, so a runner can script the in-memory keyboard
+	void SetHeadlessTickCallback(void (*tickCallbackPtr)());
 	static void Destroy();
 #endif
 
@@ -380,6 +439,15 @@ private:
 
 	bool RegisterWindowClass();
 
+	// Creates the Box2D world and hooks up the listeners and debug renderer
+	void CreateBox2DWorld();
+
+	// Loads the recording set with SetInputReplayFilePath, if any. BeginLevelInput starts the replay
+	bool LoadInputReplay();
+
+	// Deletes the world, input manager, timer and game created by Run or RunHeadless
+	void CleanUpGame();
+
 	bool OpenWindow(int iCmdShow);
 
 	// Reset all data members; prepare for a game
@@ -414,6 +482,8 @@ private:
 	// Direct2D methods
 	void D2DBeginPaint();
 	bool D2DEndPaint();
+	// Draws the queued bitmaps and applies the current transform, called before anything else is drawn
+	void FlushSpriteBatch();
 	void CreateDeviceIndependentResources();
 	void DestroyDeviceIndependentResources();
 	void CreateD2DFactory();
@@ -421,7 +491,9 @@ private:
 	void CreateWriteFactory();
 	void CreateDeviceResources();
 	void DiscardDeviceResources();
-	void ExecuteDirect2DPaint();
+	void ExecuteDirect2DPaint(double alpha);
+	// Paints the game with the SoftwareRenderer and writes the frame as a PNG file in m_HeadlessFrameFolder, false if writing failed
+	bool ExecuteSoftwarePaint(int tickCount);
 	void GUITick(double deltaTime);
 	void GUIPaint();
 	void GUIConsumeEvents();
@@ -438,6 +510,15 @@ private:
 	// Draw assistance variables
 	bool				m_bPaintingAllowed = false;
 	bool				m_bVSync = true;
+	// Headless: no window, no render target, silent audio, in-memory input
+	bool				m_bHeadless = false;
+	bool				m_bHeadlessQuit = false;
+	int					m_HeadlessTicksRun = 0;
+	// Headless frame output: every m_HeadlessTicksPerFrame ticks a frame is painted on the CPU
+	SoftwareRenderer*	m_SoftwareRendererPtr = nullptr;
+	String				m_HeadlessFrameFolder;
+	int					m_HeadlessTicksPerFrame = 1;
+	void				(*m_HeadlessTickCallbackPtr)() = nullptr;
 	// Direct2D
 	bool							m_bInitialized = false;
 	ID2D1Factory*					m_D2DFactoryPtr = nullptr;
@@ -450,6 +531,9 @@ private:
 	ID2D1SolidColorBrush*			m_ColorBrushPtr = nullptr;
 	D2D1_ANTIALIAS_MODE				m_AntialiasMode = D2D1_ANTIALIAS_MODE_ALIASED;
 	MATRIX3X2						m_MatWorld, m_MatView;
+	D2D1::Matrix3x2F				m_Transform = D2D1::Matrix3x2F::Identity();	// m_MatWorld * m_MatView
+	bool							m_IsTransformApplied = false;
+	SpriteBatch						m_SpriteBatch;
 	D2D1_BITMAP_INTERPOLATION_MODE	m_BitmapInterpolationMode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;	// used when painting scaled bitmaps:
 	Font*							m_DefaultFontPtr = nullptr;			// Default Font --> deleted in destructor
 	Font*							m_UserFontPtr = nullptr;			// the pointer the user defines using SetFont()
@@ -459,6 +543,9 @@ private:
 
 	// Input manager
 	InputManager* m_InputPtr = nullptr;
+	String m_InputRecordingFilePath;
+	String m_InputReplayFilePath;
+	bool m_InputRecordingStarted = false; // Only the first level entered in a process is recorded
 
 	// Box2D
 	b2World *m_Box2DWorldPtr = nullptr;
@@ -466,6 +553,9 @@ private:
 	Box2DDebugRenderer m_Box2DDebugRenderer;
 	bool m_DebugRendering = false;
 	double m_PhysicsTimeStep = 1;
+	int m_MaxTicksPerFrame = 5;
+	double m_DroppedTime = 0;
+	int m_DroppedTicks = 0;
 	DOUBLE2 m_Gravity; 
 	
 	//Audio
@@ -479,6 +569,7 @@ private:
 	friend class InputManager;
 	friend class Font;
 	friend class Bitmap;
+	friend class Benchmark;
 	friend LRESULT CALLBACK WndProc(HWND hWindow, UINT msg, WPARAM wParam, LPARAM lParam);
 	friend int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, char * szCmdLine, int iCmdShow);
 };
\ No newline at end of file
@@ -19,6 +19,7 @@ BYTE* InputManager::m_pCurrKeyboardState = nullptr;
 BYTE* InputManager::m_pOldKeyboardState = nullptr;
 BYTE* InputManager::m_pKeyboardState0 = nullptr;
 BYTE* InputManager::m_pKeyboardState1 = nullptr;
+BYTE* InputManager::m_pVirtualKeyboardState = nullptr;
 bool  InputManager::m_KeyboardState0Active = true;
 DOUBLE2 InputManager::m_OldMousePosition;
 DOUBLE2 InputManager::m_CurrMousePosition;
@@ -35,9 +36,11 @@ InputManager::~InputManager(void)
 	{
 		delete[] m_pKeyboardState0;
 		delete[] m_pKeyboardState1;
+		delete[] m_pVirtualKeyboardState;
 
 		m_pKeyboardState0 = nullptr;
 		m_pKeyboardState1 = nullptr;
+		m_pVirtualKeyboardState = nullptr;
 		m_pCurrKeyboardState = nullptr;
 		m_pOldKeyboardState = nullptr;
 	}
@@ -49,9 +52,19 @@ void InputManager::Initialize()
 	{
 		m_pKeyboardState0 = new BYTE[256];
 		m_pKeyboardState1 = new BYTE[256];
+		m_pVirtualKeyboardState = new BYTE[256];
 
-		GetKeyboardState(m_pKeyboardState0);
-		GetKeyboardState(m_pKeyboardState1);
+		ZeroMemory(m_pVirtualKeyboardState, 256);
+		if (GameEngine::GetSingleton()->IsHeadless())
+		{
+			ZeroMemory(m_pKeyboardState0, 256);
+			ZeroMemory(m_pKeyboardState1, 256);
+		}
+		else
+		{
+			GetKeyboardState(m_pKeyboardState0);
+			GetKeyboardState(m_pKeyboardState1);
+		}
 		// prevent nullptr
 		m_pCurrKeyboardState = m_pKeyboardState0;
 		m_pOldKeyboardState = m_pKeyboardState1;
@@ -62,7 +75,15 @@ bool InputManager::UpdateKeyboardStates()
 {
 	//Get Current KeyboardState and set Old KeyboardState
 	BOOL getKeyboardResult;
-	if (m_KeyboardState0Active)
+	if (GameEngine::GetSingleton()->IsHeadless())
+	{
+		// No window to receive messages, take a snapshot of the in-memory keyboard
+		BYTE* targetPtr = m_KeyboardState0Active ? m_pKeyboardState1 : m_pKeyboardState0;
+		memcpy(targetPtr, m_pVirtualKeyboardState, 256);
+		m_pOldKeyboardState = m_KeyboardState0Active ? m_pKeyboardState0 : m_pKeyboardState1;
+		m_pCurrKeyboardState = targetPtr;
+	}
+	else if (m_KeyboardState0Active)
 	{
 		// using windows messages
 		getKeyboardResult = GetKeyboardState(m_pKeyboardState1);
@@ -77,6 +98,14 @@ bool InputManager::UpdateKeyboardStates()
 		m_pCurrKeyboardState = m_pKeyboardState0;
 	}
 
+	if (m_Replaying)
+	{
+		// The recording starts when the level does, nothing is held down before that
+		if (m_ReplayStarted) ReplayKeyboardState(m_pCurrKeyboardState);
+		else ZeroMemory(m_pCurrKeyboardState, 256);
+	}
+	else if (m_Recording) RecordKeyboardState(m_pCurrKeyboardState);
+
 	m_KeyboardState0Active = !m_KeyboardState0Active;
 
 	return true;// getKeyboardResult > 0 ? true : false;
@@ -89,6 +118,9 @@ void InputManager::Update()
 
 	UpdateKeyboardStates();
 
+	// There is no cursor to read when running headless
+	if (GameEngine::GetSingleton()->IsHeadless()) return;
+
 	//Mouse Position
 	m_OldMousePosition = m_CurrMousePosition;
 	POINT mousePos;
@@ -179,6 +211,184 @@ bool InputManager::IsMouseButtonReleased(int button, bool previousFrame) const
 	return false;
 }
 
+void InputManager::SetVirtualKeyDown(int key, bool down)
+{
+	if (m_pVirtualKeyboardState == nullptr) return;
+
+	if (key > 0x00 && key <= 0xFE)
+	{
+		m_pVirtualKeyboardState[key] = down ? 0x80 : 0x00;
+	}
+}
+
+void InputManager::StartRecording(const String& filePathRef, int levelIndex, unsigned int randomSeed)
+{
+	m_RecordingFilePath = filePathRef;
+	m_LevelIndex = levelIndex;
+	m_RandomSeed = randomSeed;
+	m_TickCount = 0;
+	m_KeyboardRunsArr.clear();
+
+	// The current state becomes the previous state during the first recorded Update
+	if (m_pCurrKeyboardState != nullptr) PackKeyboardState(m_pCurrKeyboardState, m_InitialKeysDown);
+	else ZeroMemory(m_InitialKeysDown, PACKED_KEYBOARD_SIZE);
+
+	m_Recording = true;
+}
+
+bool InputManager::StopRecording()
+{
+	if (!m_Recording) return false;
+	m_Recording = false;
+
+	std::ofstream fileStream(m_RecordingFilePath.C_str(), std::ios::binary);
+	if (fileStream.fail())
+	{
+		OutputDebugString(String("ERROR: Could not write input recording to ") + m_RecordingFilePath + String("\n"));
+		return false;
+	}
+
+	// Header: magic, version, level index, random seed, tick count, initial state, number of runs
+	const unsigned int version = RECORDING_VERSION;
+	const unsigned int runCount = m_KeyboardRunsArr.size();
+	fileStream.write("SMWI", 4);
+	fileStream.write((const char*)&version, sizeof(version));
+	fileStream.write((const char*)&m_LevelIndex, sizeof(m_LevelIndex));
+	fileStream.write((const char*)&m_RandomSeed, sizeof(m_RandomSeed));
+	fileStream.write((const char*)&m_TickCount, sizeof(m_TickCount));
+	fileStream.write((const char*)m_InitialKeysDown, PACKED_KEYBOARD_SIZE);
+	fileStream.write((const char*)&runCount, sizeof(runCount));
+
+	for (const KeyboardRun& runRef : m_KeyboardRunsArr)
+	{
+		fileStream.write((const char*)&runRef.runLength, sizeof(runRef.runLength));
+		fileStream.write((const char*)runRef.keysDown, PACKED_KEYBOARD_SIZE);
+	}
+
+	return fileStream.good();
+}
+
+bool InputManager::LoadReplay(const String& filePathRef)
+{
+	std::ifstream fileStream(filePathRef.C_str(), std::ios::binary);
+	if (fileStream.fail())
+	{
+		OutputDebugString(String("ERROR: Could not open input recording ") + filePathRef + String("\n"));
+		return false;
+	}
+
+	char magic[4] = {};
+	unsigned int version = 0;
+	unsigned int runCount = 0;
+	fileStream.read(magic, 4);
+	fileStream.read((char*)&version, sizeof(version));
+	if (fileStream.fail() || strncmp(magic, "SMWI", 4) != 0 || version != RECORDING_VERSION)
+	{
+		OutputDebugString(String("ERROR: ") + filePathRef + String(" is not a valid input recording\n"));
+		return false;
+	}
+
+	fileStream.read((char*)&m_LevelIndex, sizeof(m_LevelIndex));
+	fileStream.read((char*)&m_RandomSeed, sizeof(m_RandomSeed));
+	fileStream.read((char*)&m_TickCount, sizeof(m_TickCount));
+	fileStream.read((char*)m_InitialKeysDown, PACKED_KEYBOARD_SIZE);
+	fileStream.read((char*)&runCount, sizeof(runCount));
+
+	m_KeyboardRunsArr.resize(runCount);
+	for (unsigned int i = 0; i < runCount; ++i)
+	{
+		fileStream.read((char*)&m_KeyboardRunsArr[i].runLength, sizeof(unsigned int));
+		fileStream.read((char*)m_KeyboardRunsArr[i].keysDown, PACKED_KEYBOARD_SIZE);
+	}
+
+	if (fileStream.fail())
+	{
+		OutputDebugString(String("ERROR: Input recording ") + filePathRef + String(" is truncated\n"));
+		m_KeyboardRunsArr.clear();
+		return false;
+	}
+
+	m_ReplayRunIndex = 0;
+	m_ReplayRunTicksUsed = 0;
+	m_Recording = false;
+	m_Replaying = true;
+	m_ReplayStarted = false;
+
+	return true;
+}
+
+void InputManager::StartReplay()
+{
+	if (!m_Replaying) return;
+
+	// Like StartRecording, the current state becomes the previous state during the first replayed Update
+	if (m_pCurrKeyboardState != nullptr) UnpackKeyboardState(m_InitialKeysDown, m_pCurrKeyboardState);
+
+	m_ReplayStarted = true;
+}
+
+bool InputManager::IsReplayFinished() const
+{
+	return m_ReplayRunIndex >= m_KeyboardRunsArr.size();
+}
+
+void InputManager::RecordKeyboardState(const BYTE* keyboardStatePtr)
+{
+	BYTE keysDown[PACKED_KEYBOARD_SIZE];
+	PackKeyboardState(keyboardStatePtr, keysDown);
+
+	++m_TickCount;
+
+	// Most ticks look exactly like the previous one, extend the last run if they do
+	if (m_KeyboardRunsArr.empty() == false &&
+		memcmp(m_KeyboardRunsArr.back().keysDown, keysDown, PACKED_KEYBOARD_SIZE) == 0)
+	{
+		++m_KeyboardRunsArr.back().runLength;
+		return;
+	}
+
+	KeyboardRun newRun;
+	newRun.runLength = 1;
+	memcpy(newRun.keysDown, keysDown, PACKED_KEYBOARD_SIZE);
+	m_KeyboardRunsArr.push_back(newRun);
+}
+
+void InputManager::ReplayKeyboardState(BYTE* keyboardStatePtr)
+{
+	if (IsReplayFinished())
+	{
+		// Nothing is held down after the recording ends
+		ZeroMemory(keyboardStatePtr, 256);
+		return;
+	}
+
+	UnpackKeyboardState(m_KeyboardRunsArr[m_ReplayRunIndex].keysDown, keyboardStatePtr);
+
+	++m_ReplayRunTicksUsed;
+	if (m_ReplayRunTicksUsed >= m_KeyboardRunsArr[m_ReplayRunIndex].runLength)
+	{
+		++m_ReplayRunIndex;
+		m_ReplayRunTicksUsed = 0;
+	}
+}
+
+void InputManager::PackKeyboardState(const BYTE* keyboardStatePtr, BYTE* packedPtr)
+{
+	ZeroMemory(packedPtr, PACKED_KEYBOARD_SIZE);
+	for (int key = 0; key < 256; ++key)
+	{
+		if ((keyboardStatePtr[key] & 0xF0) != 0) packedPtr[key / 8] |= (1 << (key % 8));
+	}
+}
+
+void InputManager::UnpackKeyboardState(const BYTE* packedPtr, BYTE* keyboardStatePtr)
+{
+	for (int key = 0; key < 256; ++key)
+	{
+		keyboardStatePtr[key] = (packedPtr[key / 8] & (1 << (key % 8))) ? 0x80 : 0x00;
+	}
+}
+
 //NO RANGE CHECKS
 bool InputManager::IsKeyboardKeyDown_unsafe(int key, bool previousFrame) const
 {
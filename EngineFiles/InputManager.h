@@ -42,6 +42,37 @@ public:
 	bool IsKeyboardKeyReleased(int key, bool previousFrame = false) const;
 	// Not intended to be used by students
 	bool IsMouseButtonReleased(int button, bool previousFrame = false) const;
+	// Not intended to be used by students
+	// Sets a key in the in-memory keyboard which replaces the windows keyboard when running headless
+	void SetVirtualKeyDown(int key, bool down);
+
+	// Not intended to be used by students
+	// Captures the keyboard state of every following Update, the file is written by StopRecording
+	void StartRecording(const String& filePathRef, int levelIndex, unsigned int randomSeed);
+	// Not intended to be used by students
+	// Writes the run-length encoded keyboard states to disk, returns false if the file couldn't be written
+	bool StopRecording();
+	// Not intended to be used by students
+	bool IsRecording() const { return m_Recording; }
+	// Not intended to be used by students
+	// Loads a recording, Updates see nothing held down until StartReplay is called
+	bool LoadReplay(const String& filePathRef);
+	// Not intended to be used by students
+	// Every following Update takes the next recorded keyboard state instead of the real one
+	void StartReplay();
+	// Not intended to be used by students
+	// True from the moment a recording was loaded, even before StartReplay
+	bool IsReplaying() const { return m_Replaying; }
+	// Not intended to be used by students
+	bool IsReplayStarted() const { return m_ReplayStarted; }
+	// Not intended to be used by students
+	bool IsReplayFinished() const;
+	// Not intended to be used by students
+	int GetReplayLevelIndex() const { return m_LevelIndex; }
+	// Not intended to be used by students
+	unsigned int GetReplayRandomSeed() const { return m_RandomSeed; }
+	// Not intended to be used by students
+	unsigned int GetReplayTickCount() const { return m_TickCount; }
 
 
 private:
@@ -50,17 +81,50 @@ private:
 	InputManager();
 
 	static BYTE *m_pCurrKeyboardState, *m_pOldKeyboardState, *m_pKeyboardState0, *m_pKeyboardState1;
+	static BYTE *m_pVirtualKeyboardState;
 	static bool m_KeyboardState0Active;
 	static DOUBLE2 m_CurrMousePosition, m_OldMousePosition, m_MouseMovement;
 
 	static bool m_Enabled;
 
+	// One bit per virtual key code
+	static const int PACKED_KEYBOARD_SIZE = 256 / 8;
+	static const unsigned int RECORDING_VERSION = 1;
+
+	// A keyboard state that stayed the same for runLength Updates in a row
+	struct KeyboardRun
+	{
+		unsigned int runLength;
+		BYTE keysDown[PACKED_KEYBOARD_SIZE];
+	};
+
+	bool m_Recording = false;
+	bool m_Replaying = false;
+	bool m_ReplayStarted = false;
+	String m_RecordingFilePath;
+	int m_LevelIndex = 0;
+	unsigned int m_RandomSeed = 0;
+	unsigned int m_TickCount = 0;
+	// The state before the first recorded Update, needed to detect presses and releases on the first tick
+	BYTE m_InitialKeysDown[PACKED_KEYBOARD_SIZE];
+	std::vector<KeyboardRun> m_KeyboardRunsArr;
+	size_t m_ReplayRunIndex = 0;
+	unsigned int m_ReplayRunTicksUsed = 0;
+
 	// Not intended to be used by students
 	bool UpdateKeyboardStates();
 	// Not intended to be used by students
 	bool IsKeyboardKeyDown_unsafe(int key, bool previousFrame = false) const;
 	// Not intended to be used by students
 	bool IsMouseButtonDown_unsafe(int button, bool previousFrame = false) const;
+	// Not intended to be used by students
+	void RecordKeyboardState(const BYTE* keyboardStatePtr);
+	// Not intended to be used by students
+	void ReplayKeyboardState(BYTE* keyboardStatePtr);
+	// Not intended to be used by students
+	static void PackKeyboardState(const BYTE* keyboardStatePtr, BYTE* packedPtr);
+	// Not intended to be used by students
+	static void UnpackKeyboardState(const BYTE* packedPtr, BYTE* keyboardStatePtr);
 
 
 	// Game Engine captures windows messages and sends them to this manager
@@ -283,18 +283,16 @@ std::vector<b2Fixture *> PhysicsActor::AddSVGFixture(BYTE* pBlob, int blobSize,
 
 std::vector<b2Fixture *> PhysicsActor::AddSVGFixture(const String & svgFilePathRef, double restitution, double friction, double density)
 {
-	// a vector containing chains
-	std::vector<std::vector<DOUBLE2>> verticesArr;
+	std::vector<b2Fixture *>fixPtrArr;
 
-	//parse the svg file
-	SVGParser svgParser;
-	svgParser.LoadGeometryFromSvgFile(svgFilePathRef, verticesArr);
+	// the svg file is only parsed the first time it is used, or when it changed since
+	const std::vector<std::vector<DOUBLE2>>* verticesArrPtr = SVGGeometryCache::GetGeometry(svgFilePathRef);
+	if (verticesArrPtr == nullptr) return fixPtrArr;
 
-	std::vector<b2Fixture *>fixPtrArr;
 	// process the chains
-	for (size_t i = 0; i < verticesArr.size(); i++)
+	for (size_t i = 0; i < verticesArrPtr->size(); i++)
 	{
-		std::vector<DOUBLE2> &chain = verticesArr[i];
+		const std::vector<DOUBLE2> &chain = (*verticesArrPtr)[i];
 		b2Fixture * fixPtr = AddChainFixture(chain, true, restitution, friction, density);
 		if (fixPtr != nullptr)
 		{
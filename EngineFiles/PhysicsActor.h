@@ -88,6 +88,7 @@ public:
 
 	//! Parses a svg file and extracts lines only. Supports only SVG1.0 and 1.1 text files. Use Inkscape to create the svg file.
 	//! Converts the lines into chains and adds them to the actor. 
+	//! The parsed chains are cached in memory and on disk (see SVGGeometryCache), so an unchanged file is only parsed once.
 	//! @param svgFilePathRef is a String representing the name of the svg file to parse.
 	//! @param restitution is the a value between 0 (full damping) and 1 (no energy loss)
 	//! @param friction represents the static and dynamic friction.  The friction parameter is usually set between 0 and 1, but can be any non - negative value. A friction value of 0 turns off friction and a value of 1 makes the friction strong. When two fixtures collide with each other, the resulting friction tends toward the lower of their friction values.
@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Source - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+#include "stdafx.h"
+#include "../stdafx.h"
+#include "Profiler.h"
+
+const char* Profiler::PHASE_NAMES[NUM_PHASES] =
+{
+	"game tick",
+	"removal", "player", "particles", "items/enemies", "camera",
+	"physics step", "contacts",
+	"paint"
+};
+
+__int64 Profiler::m_SampleCountsArr[HISTORY_LENGTH][NUM_PHASES];
+unsigned int Profiler::m_TickNumberArr[HISTORY_LENGTH];
+int Profiler::m_CurrentSample = HISTORY_LENGTH - 1;
+int Profiler::m_NumSamplesStored = 0;
+unsigned int Profiler::m_TickNumber = 0;
+double Profiler::m_MillisecondsPerCount = 0.0;
+String Profiler::m_CSVFilePath;
+
+void Profiler::BeginTick()
+{
+	m_CurrentSample = (m_CurrentSample + 1) % HISTORY_LENGTH;
+	if (m_NumSamplesStored < HISTORY_LENGTH) ++m_NumSamplesStored;
+
+	for (int i = 0; i < NUM_PHASES; ++i)
+	{
+		m_SampleCountsArr[m_CurrentSample][i] = 0;
+	}
+	m_TickNumberArr[m_CurrentSample] = m_TickNumber++;
+}
+
+void Profiler::AddSample(Phase phase, __int64 counts)
+{
+	// Anything that happens before the first tick has no row to go in
+	if (m_NumSamplesStored == 0) return;
+
+	m_SampleCountsArr[m_CurrentSample][int(phase)] += counts;
+}
+
+__int64 Profiler::GetCount()
+{
+	__int64 count;
+	QueryPerformanceCounter((LARGE_INTEGER*)&count);
+	return count;
+}
+
+double Profiler::CountsToMilliseconds(__int64 counts)
+{
+	if (m_MillisecondsPerCount == 0.0)
+	{
+		__int64 countsPerSec;
+		QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSec);
+		m_MillisecondsPerCount = 1000.0 / (double)countsPerSec;
+	}
+	return counts * m_MillisecondsPerCount;
+}
+
+void Profiler::Paint(int left, int bottom, int lineHeight)
+{
+	const int numTicks = min(OVERLAY_TICKS, m_NumSamplesStored);
+	if (numTicks == 0) return;
+
+	int y = bottom - lineHeight * NUM_PHASES;
+	GameEngine::GetSingleton()->DrawString(String("ms avg/max (") + String(numTicks) + String(" ticks)"), left, y - lineHeight);
+
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+	{
+		__int64 total = 0;
+		__int64 worst = 0;
+		for (int i = 0; i < numTicks; ++i)
+		{
+			const int sample = (m_CurrentSample - i + HISTORY_LENGTH) % HISTORY_LENGTH;
+			const __int64 counts = m_SampleCountsArr[sample][phase];
+			total += counts;
+			if (counts > worst) worst = counts;
+		}
+
+		// Level sub phases are indented under the game tick they are a part of
+		const bool isSubPhase = (phase > int(Phase::GAME_TICK) && phase <= int(Phase::CAMERA)) ||
+			phase == int(Phase::CONTACT_CALLBACKS);
+		String line = String(isSubPhase ? " " : "") + String(PHASE_NAMES[phase]) + String(": ") +
+			String(CountsToMilliseconds(total) / numTicks, 3) + String("/") + String(CountsToMilliseconds(worst), 3);
+		GameEngine::GetSingleton()->DrawString(line, left, y);
+		y += lineHeight;
+	}
+}
+
+bool Profiler::WriteCSV(const String& filePath)
+{
+	std::ofstream fileOutStream;
+	fileOutStream.open(filePath.C_str());
+	if (fileOutStream.fail()) return false;
+
+	fileOutStream << "tick";
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+	{
+		fileOutStream << "," << PHASE_NAMES[phase];
+	}
+	fileOutStream << std::endl;
+
+	fileOutStream << std::fixed << std::setprecision(4);
+	const int oldestSample = (m_CurrentSample - m_NumSamplesStored + 1 + HISTORY_LENGTH) % HISTORY_LENGTH;
+	for (int i = 0; i < m_NumSamplesStored; ++i)
+	{
+		const int sample = (oldestSample + i) % HISTORY_LENGTH;
+		fileOutStream << m_TickNumberArr[sample];
+		for (int phase = 0; phase < NUM_PHASES; ++phase)
+		{
+			fileOutStream << "," << CountsToMilliseconds(m_SampleCountsArr[sample][phase]);
+		}
+		fileOutStream << "\n";
+	}
+
+	fileOutStream.close();
+	return true;
+}
+
+void Profiler::SetCSVFilePath(const String& filePath)
+{
+	m_CSVFilePath = filePath;
+}
+
+const String& Profiler::GetCSVFilePath()
+{
+	return m_CSVFilePath;
+}
+
+ProfileScope::ProfileScope(Profiler::Phase phase) :
+	m_Phase(phase),
+	m_StartCount(Profiler::GetCount())
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+	Profiler::AddSample(m_Phase, Profiler::GetCount() - m_StartCount);
+}
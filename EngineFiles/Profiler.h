@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Header - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+
+#pragma once
+
+// Keeps track of how long each phase of the game loop takes, per tick.
+// Samples live in a fixed size ring buffer, so recording never allocates.
+// Paint time is added to the tick that was last started, contact callbacks
+// are a part of the physics step they are called from.
+class Profiler
+{
+public:
+	enum class Phase
+	{
+		GAME_TICK,
+		ITEM_ENEMY_REMOVAL, PLAYER_TICK, PARTICLES_TICK, ITEMS_AND_ENEMIES_TICK, CAMERA,
+		PHYSICS_STEP, CONTACT_CALLBACKS,
+		PAINT,
+		_LAST_ELEMENT
+	};
+
+	// Starts a new row in the ring buffer, overwriting the oldest one when it is full
+	static void BeginTick();
+	static void AddSample(Phase phase, __int64 counts);
+
+	static __int64 GetCount();
+
+	// Average and worst time of the last OVERLAY_TICKS ticks, drawn upwards from bottom using the current font
+	static void Paint(int left, int bottom, int lineHeight);
+
+	// Writes every sample still in the ring buffer, oldest first, in milliseconds
+	static bool WriteCSV(const String& filePath);
+
+	// Where the game writes its samples to when it ends, set with -profile. Empty means nothing is written
+	static void SetCSVFilePath(const String& filePath);
+	static const String& GetCSVFilePath();
+
+	static const int NUM_PHASES = int(Phase::_LAST_ELEMENT);
+	static const int HISTORY_LENGTH = 600;
+	static const int OVERLAY_TICKS = 60;
+
+private:
+	Profiler() = delete;
+
+	static double CountsToMilliseconds(__int64 counts);
+
+	static const char* PHASE_NAMES[NUM_PHASES];
+
+	static __int64 m_SampleCountsArr[HISTORY_LENGTH][NUM_PHASES];
+	static unsigned int m_TickNumberArr[HISTORY_LENGTH];
+	static int m_CurrentSample;
+	static int m_NumSamplesStored;
+	static unsigned int m_TickNumber;
+	static double m_MillisecondsPerCount;
+	static String m_CSVFilePath;
+};
+
+// Adds the time between its construction and destruction to the given phase
+class ProfileScope
+{
+public:
+	explicit ProfileScope(Profiler::Phase phase);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	Profiler::Phase m_Phase;
+	__int64 m_StartCount;
+};
@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Source - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+#include "stdafx.h"
+#include "../stdafx.h"
+#include "SVGGeometryCache.h"
+
+const char SVGGeometryCache::MAGIC[4] = { 'S', 'V', 'G', 'C' };
+
+std::map<std::string, SVGGeometryCache::Entry> SVGGeometryCache::m_EntriesMap;
+
+const std::vector<std::vector<DOUBLE2>>* SVGGeometryCache::GetGeometry(const String& svgFilePathRef)
+{
+	const std::string svgFilePath = svgFilePathRef.C_str();
+
+	// Entering the same level again doesn't need to touch the disk at all
+	std::map<std::string, Entry>::iterator entryIt = m_EntriesMap.find(svgFilePath);
+	if (entryIt != m_EntriesMap.end())
+	{
+		return &entryIt->second.m_ChainsArr;
+	}
+
+	std::ifstream svgFile(svgFilePath, std::ios::binary);
+	if (!svgFile)
+	{
+		GameEngine::GetSingleton()->MessageBox(String("Failed to load geometry from file ") + svgFilePathRef);
+		return nullptr;
+	}
+	std::vector<char> svgBytesArr((std::istreambuf_iterator<char>(svgFile)), std::istreambuf_iterator<char>());
+	svgFile.close();
+
+	Entry entry;
+	entry.m_Hash = HashBytes(svgBytesArr);
+
+	const std::string cacheFilePath = svgFilePath + ".chains";
+	if (ReadCacheFile(cacheFilePath, entry.m_Hash, entry.m_ChainsArr) == false)
+	{
+		entry.m_ChainsArr.clear();
+
+		SVGParser svgParser;
+		if (svgParser.LoadGeometryFromSvgStream((BYTE*)svgBytesArr.data(), int(svgBytesArr.size()), entry.m_ChainsArr) == false)
+		{
+			return nullptr;
+		}
+
+		if (WriteCacheFile(cacheFilePath, entry.m_Hash, entry.m_ChainsArr) == false)
+		{
+			OutputDebugString(String("ERROR: Unable to write svg geometry cache ") + String(cacheFilePath.c_str()) + String("\n"));
+		}
+	}
+
+	entryIt = m_EntriesMap.insert(std::make_pair(svgFilePath, std::move(entry))).first;
+	return &entryIt->second.m_ChainsArr;
+}
+
+// 64 bit FNV-1a
+unsigned __int64 SVGGeometryCache::HashBytes(const std::vector<char>& bytesRef)
+{
+	unsigned __int64 hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < bytesRef.size(); ++i)
+	{
+		hash ^= (unsigned char)bytesRef[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// File layout: magic, version, svg hash, chain count, then per chain its vertex count followed by its vertices
+bool SVGGeometryCache::ReadCacheFile(const std::string& cacheFilePath, unsigned __int64 hash, std::vector<std::vector<DOUBLE2>>& chainsArrRef)
+{
+	std::ifstream fileInStream(cacheFilePath, std::ios::binary | std::ios::ate);
+	if (!fileInStream) return false;
+
+	// Counts are checked against the bytes left, so a truncated or corrupt file can't make us allocate huge chains
+	const std::streamoff fileSize = fileInStream.tellg();
+	fileInStream.seekg(0, std::ios::beg);
+	if (fileSize < 0 || !fileInStream) return false;
+
+	char magic[4];
+	unsigned int version = 0;
+	unsigned __int64 fileHash = 0;
+	unsigned int numChains = 0;
+	fileInStream.read(magic, sizeof(magic));
+	fileInStream.read((char*)&version, sizeof(version));
+	fileInStream.read((char*)&fileHash, sizeof(fileHash));
+	fileInStream.read((char*)&numChains, sizeof(numChains));
+
+	// Out of date caches are simply rebuilt
+	if (!fileInStream || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION || fileHash != hash)
+	{
+		return false;
+	}
+
+	std::streamoff remainingSize = fileSize - fileInStream.tellg();
+	if (numChains > unsigned __int64(remainingSize) / sizeof(unsigned int)) return false;
+
+	chainsArrRef.resize(numChains);
+	for (unsigned int i = 0; i < numChains; ++i)
+	{
+		unsigned int numVertices = 0;
+		fileInStream.read((char*)&numVertices, sizeof(numVertices));
+		if (!fileInStream) return false;
+
+		remainingSize = fileSize - fileInStream.tellg();
+		if (numVertices > unsigned __int64(remainingSize) / sizeof(DOUBLE2)) return false;
+
+		chainsArrRef[i].resize(numVertices);
+		fileInStream.read((char*)chainsArrRef[i].data(), numVertices * sizeof(DOUBLE2));
+		if (!fileInStream) return false;
+	}
+
+	// Anything after the last chain means the file isn't one we wrote
+	return fileInStream.tellg() == fileSize;
+}
+
+bool SVGGeometryCache::WriteCacheFile(const std::string& cacheFilePath, unsigned __int64 hash, const std::vector<std::vector<DOUBLE2>>& chainsArrRef)
+{
+	std::ofstream fileOutStream(cacheFilePath, std::ios::binary);
+	if (!fileOutStream) return false;
+
+	// Static members can't be written through a pointer to them, copy them first
+	const unsigned int version = VERSION;
+	const unsigned int numChains = chainsArrRef.size();
+	fileOutStream.write(MAGIC, sizeof(MAGIC));
+	fileOutStream.write((const char*)&version, sizeof(version));
+	fileOutStream.write((const char*)&hash, sizeof(hash));
+	fileOutStream.write((const char*)&numChains, sizeof(numChains));
+
+	for (size_t i = 0; i < chainsArrRef.size(); ++i)
+	{
+		const unsigned int numVertices = chainsArrRef[i].size();
+		fileOutStream.write((const char*)&numVertices, sizeof(numVertices));
+		fileOutStream.write((const char*)chainsArrRef[i].data(), numVertices * sizeof(DOUBLE2));
+	}
+
+	return !fileOutStream.fail();
+}
@@ -0,0 +1,41 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Header - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// SVGGeometryCache Class
+//-----------------------------------------------------------------
+// Keeps the vertex chains parsed from svg files around, so every file is parsed at most once.
+// Chains are kept in memory per file path, and written next to the svg file (<file>.chains)
+// together with a hash of the svg's contents, so later runs only parse the svg again when it changed.
+class SVGGeometryCache
+{
+public:
+	//! Returns the chains in the given svg file, or nullptr if the file could not be read or parsed.
+	//! The returned chains stay valid for the rest of the run
+	static const std::vector<std::vector<DOUBLE2>>* GetGeometry(const String& svgFilePathRef);
+
+private:
+	SVGGeometryCache() = delete;
+
+	struct Entry
+	{
+		unsigned __int64 m_Hash;
+		std::vector<std::vector<DOUBLE2>> m_ChainsArr;
+	};
+
+	static unsigned __int64 HashBytes(const std::vector<char>& bytesRef);
+	static bool ReadCacheFile(const std::string& cacheFilePath, unsigned __int64 hash, std::vector<std::vector<DOUBLE2>>& chainsArrRef);
+	static bool WriteCacheFile(const std::string& cacheFilePath, unsigned __int64 hash, const std::vector<std::vector<DOUBLE2>>& chainsArrRef);
+
+	static const char MAGIC[4];
+	static const unsigned int VERSION = 1;
+
+	static std::map<std::string, Entry> m_EntriesMap;
+};
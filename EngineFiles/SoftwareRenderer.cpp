@@ -0,0 +1,514 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Source - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+#include "stdafx.h"
+#include "../stdafx.h"
+#include "SoftwareRenderer.h"
+
+#include <algorithm>
+#include <emmintrin.h>
+
+SoftwareRenderer::SoftwareRenderer(int width, int height) :
+	m_Width(width), m_Height(height)
+{
+	m_PixelsArr.resize(m_Width * m_Height);
+	m_SpanPixelsArr.resize(m_Width);
+	m_Color = ToPixel(COLOR(0, 0, 0));
+	Clear(COLOR(255, 255, 255));
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+}
+
+void SoftwareRenderer::Clear(COLOR color)
+{
+	std::fill(m_PixelsArr.begin(), m_PixelsArr.end(), ToPixel(color));
+}
+
+void SoftwareRenderer::SetColor(COLOR color)
+{
+	m_Color = ToPixel(color);
+}
+
+void SoftwareRenderer::SetTransform(const MATRIX3X2& matRef)
+{
+	m_Transform = matRef;
+	m_InverseTransform = matRef.Inverse();
+}
+
+void SoftwareRenderer::DrawBitmap(Bitmap* bitmapPtr, DOUBLE2 position, RECT2 srcRect, double opacity)
+{
+	const std::vector<unsigned int>& srcPixelsArrRef = bitmapPtr->GetSoftwarePixels();
+	const int bmpWidth = bitmapPtr->GetWidth();
+	const int bmpHeight = bitmapPtr->GetHeight();
+
+	// Only the part of the source rect which is inside the bitmap is drawn
+	const int srcLeft = max(0, int(srcRect.left));
+	const int srcTop = max(0, int(srcRect.top));
+	const int width = min(bmpWidth, int(srcRect.right)) - srcLeft;
+	const int height = min(bmpHeight, int(srcRect.bottom)) - srcTop;
+	if (width <= 0 || height <= 0) return;
+
+	const DOUBLE2 dstTopLeft = position + DOUBLE2(srcLeft - srcRect.left, srcTop - srcRect.top);
+
+	// Framebuffer rows and columns the transformed bitmap can touch
+	const DOUBLE2 cornersArr[4] =
+	{
+		m_Transform.TransformPoint(dstTopLeft),
+		m_Transform.TransformPoint(dstTopLeft + DOUBLE2(width, 0)),
+		m_Transform.TransformPoint(dstTopLeft + DOUBLE2(0, height)),
+		m_Transform.TransformPoint(dstTopLeft + DOUBLE2(width, height))
+	};
+	double minX = cornersArr[0].x, maxX = cornersArr[0].x, minY = cornersArr[0].y, maxY = cornersArr[0].y;
+	for (int i = 1; i < 4; ++i)
+	{
+		minX = min(minX, cornersArr[i].x);
+		maxX = max(maxX, cornersArr[i].x);
+		minY = min(minY, cornersArr[i].y);
+		maxY = max(maxY, cornersArr[i].y);
+	}
+	const int firstColumn = max(0, int(floor(minX)));
+	const int endColumn = min(m_Width, int(ceil(maxX)));
+	const int firstRow = max(0, int(floor(minY)));
+	const int endRow = min(m_Height, int(ceil(maxY)));
+	if (firstColumn >= endColumn || firstRow >= endRow) return;
+
+	// Every framebuffer pixel center is mapped back into the bitmap, moving one pixel right is a constant step
+	const DOUBLE2 step = m_InverseTransform.TransformVector(DOUBLE2(1, 0));
+	const unsigned int opacityScale = static_cast<unsigned int>(max(0.0, min(1.0, opacity)) * 256.0);
+
+	for (int y = firstRow; y < endRow; ++y)
+	{
+		const DOUBLE2 rowStart = m_InverseTransform.TransformPoint(DOUBLE2(firstColumn + 0.5, y + 0.5)) - dstTopLeft;
+
+		// Narrow the row down to the pixels which land inside the bitmap on both axes
+		int begin = 0;
+		int end = endColumn - firstColumn;
+		ClipSpan(rowStart.x, step.x, width, begin, end);
+		ClipSpan(rowStart.y, step.y, height, begin, end);
+		if (begin >= end) continue;
+
+		const int count = end - begin;
+		double u = rowStart.x + begin * step.x;
+		double v = rowStart.y + begin * step.y;
+		for (int i = 0; i < count; ++i)
+		{
+			const int srcX = max(0, min(width - 1, int(u)));
+			const int srcY = max(0, min(height - 1, int(v)));
+			const unsigned int pixel = srcPixelsArrRef[(srcTop + srcY) * bmpWidth + srcLeft + srcX];
+			m_SpanPixelsArr[i] = (opacityScale < 256) ? ScalePixel(pixel, opacityScale) : pixel;
+			u += step.x;
+			v += step.y;
+		}
+
+		BlendSpan(&m_PixelsArr[y * m_Width + firstColumn + begin], m_SpanPixelsArr.data(), count);
+	}
+}
+
+void SoftwareRenderer::DrawLine(DOUBLE2 p1, DOUBLE2 p2, double strokeWidth)
+{
+	const DOUBLE2 start = m_Transform.TransformPoint(p1);
+	const DOUBLE2 end = m_Transform.TransformPoint(p2);
+	const DOUBLE2 direction = end - start;
+	const double length = direction.Length();
+	if (length == 0.0) return;
+
+	// The line is filled as a quad, at least one pixel wide so thin lines don't disappear
+	const double halfWidth = max(1.0, strokeWidth * sqrt(abs(m_Transform.Determinant()))) / 2.0;
+	const DOUBLE2 normal = DOUBLE2(-direction.y, direction.x) * (halfWidth / length);
+
+	m_ContoursArr.resize(1);
+	std::vector<DOUBLE2>& contourRef = m_ContoursArr[0];
+	contourRef.clear();
+	contourRef.push_back(start + normal);
+	contourRef.push_back(end + normal);
+	contourRef.push_back(end - normal);
+	contourRef.push_back(start - normal);
+	FillContours(m_ContoursArr);
+}
+
+void SoftwareRenderer::DrawRect(RECT2 rect, double strokeWidth)
+{
+	// Four sides which don't overlap, so translucent outlines don't get darker corners
+	const double halfWidth = strokeWidth / 2.0;
+	FillTransformedRect(rect.left - halfWidth, rect.top - halfWidth, rect.right + halfWidth, rect.top + halfWidth);
+	FillTransformedRect(rect.left - halfWidth, rect.bottom - halfWidth, rect.right + halfWidth, rect.bottom + halfWidth);
+	FillTransformedRect(rect.left - halfWidth, rect.top + halfWidth, rect.left + halfWidth, rect.bottom - halfWidth);
+	FillTransformedRect(rect.right - halfWidth, rect.top + halfWidth, rect.right + halfWidth, rect.bottom - halfWidth);
+}
+
+void SoftwareRenderer::FillRect(RECT2 rect)
+{
+	FillTransformedRect(rect.left, rect.top, rect.right, rect.bottom);
+}
+
+void SoftwareRenderer::DrawEllipse(DOUBLE2 center, double radiusX, double radiusY, double strokeWidth)
+{
+	// An outer and an inner outline filled with the even-odd rule leave a ring
+	const double halfWidth = strokeWidth / 2.0;
+	m_ContoursArr.resize(0);
+	AddEllipseContour(m_ContoursArr, center, radiusX + halfWidth, radiusY + halfWidth);
+	if (radiusX > halfWidth && radiusY > halfWidth)
+	{
+		AddEllipseContour(m_ContoursArr, center, radiusX - halfWidth, radiusY - halfWidth);
+	}
+	FillContours(m_ContoursArr);
+}
+
+void SoftwareRenderer::FillEllipse(DOUBLE2 center, double radiusX, double radiusY)
+{
+	m_ContoursArr.resize(0);
+	AddEllipseContour(m_ContoursArr, center, radiusX, radiusY);
+	FillContours(m_ContoursArr);
+}
+
+void SoftwareRenderer::FillPolygon(const std::vector<DOUBLE2>& ptsArrRef)
+{
+	m_ContoursArr.resize(1);
+	std::vector<DOUBLE2>& contourRef = m_ContoursArr[0];
+	contourRef.clear();
+	for (size_t i = 0; i < ptsArrRef.size(); ++i)
+	{
+		contourRef.push_back(m_Transform.TransformPoint(ptsArrRef[i]));
+	}
+	FillContours(m_ContoursArr);
+}
+
+void SoftwareRenderer::FillTransformedRect(double left, double top, double right, double bottom)
+{
+	if (left >= right || top >= bottom) return;
+
+	m_ContoursArr.resize(1);
+	std::vector<DOUBLE2>& contourRef = m_ContoursArr[0];
+	contourRef.clear();
+	contourRef.push_back(m_Transform.TransformPoint(DOUBLE2(left, top)));
+	contourRef.push_back(m_Transform.TransformPoint(DOUBLE2(right, top)));
+	contourRef.push_back(m_Transform.TransformPoint(DOUBLE2(right, bottom)));
+	contourRef.push_back(m_Transform.TransformPoint(DOUBLE2(left, bottom)));
+	FillContours(m_ContoursArr);
+}
+
+void SoftwareRenderer::AddEllipseContour(std::vector<std::vector<DOUBLE2>>& contoursArrRef, DOUBLE2 center, double radiusX, double radiusY)
+{
+	// Roughly one segment per pixel of radius on screen
+	const double screenRadius = max(radiusX, radiusY) * sqrt(abs(m_Transform.Determinant()));
+	const int numSegments = max(MIN_ELLIPSE_SEGMENTS, int(screenRadius));
+
+	contoursArrRef.resize(contoursArrRef.size() + 1);
+	std::vector<DOUBLE2>& contourRef = contoursArrRef.back();
+	contourRef.clear();
+	for (int i = 0; i < numSegments; ++i)
+	{
+		const double angle = 2.0 * M_PI * i / numSegments;
+		contourRef.push_back(m_Transform.TransformPoint(center + DOUBLE2(cos(angle) * radiusX, sin(angle) * radiusY)));
+	}
+}
+
+void SoftwareRenderer::FillContours(const std::vector<std::vector<DOUBLE2>>& contoursArrRef)
+{
+	double minY = DBL_MAX, maxY = -DBL_MAX;
+	for (const std::vector<DOUBLE2>& contourRef : contoursArrRef)
+	{
+		for (const DOUBLE2& pointRef : contourRef)
+		{
+			minY = min(minY, pointRef.y);
+			maxY = max(maxY, pointRef.y);
+		}
+	}
+	if (minY > maxY) return;
+
+	const int firstRow = max(0, int(floor(minY)));
+	const int endRow = min(m_Height, int(ceil(maxY)));
+
+	for (int y = firstRow; y < endRow; ++y)
+	{
+		// Every edge crossing the center of this row, a pixel is filled when an odd number of crossings is left of its center
+		const double sampleY = y + 0.5;
+		m_CrossingsArr.clear();
+		for (const std::vector<DOUBLE2>& contourRef : contoursArrRef)
+		{
+			const size_t numPoints = contourRef.size();
+			for (size_t i = 0; i < numPoints; ++i)
+			{
+				const DOUBLE2& p1Ref = contourRef[i];
+				const DOUBLE2& p2Ref = contourRef[(i + 1) % numPoints];
+				if ((p1Ref.y <= sampleY) != (p2Ref.y <= sampleY))
+				{
+					m_CrossingsArr.push_back(p1Ref.x + (sampleY - p1Ref.y) * (p2Ref.x - p1Ref.x) / (p2Ref.y - p1Ref.y));
+				}
+			}
+		}
+		std::sort(m_CrossingsArr.begin(), m_CrossingsArr.end());
+
+		for (size_t i = 0; i + 1 < m_CrossingsArr.size(); i += 2)
+		{
+			const int left = max(0, int(ceil(m_CrossingsArr[i] - 0.5)));
+			const int right = min(m_Width, int(ceil(m_CrossingsArr[i + 1] - 0.5)));
+			FillSpan(y, left, right);
+		}
+	}
+}
+
+void SoftwareRenderer::FillSpan(int y, int left, int right)
+{
+	if (left >= right) return;
+
+	const unsigned int alpha = m_Color >> 24;
+	if (alpha == 0) return;
+
+	unsigned int* dstPtr = &m_PixelsArr[y * m_Width + left];
+	const int count = right - left;
+
+	if (alpha < 255)
+	{
+		std::fill(m_SpanPixelsArr.begin(), m_SpanPixelsArr.begin() + count, m_Color);
+		BlendSpan(dstPtr, m_SpanPixelsArr.data(), count);
+		return;
+	}
+
+	// Opaque, four pixels at a time
+	const __m128i colors = _mm_set1_epi32(int(m_Color));
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_si128((__m128i*)(dstPtr + i), colors);
+	}
+	for (; i < count; ++i)
+	{
+		dstPtr[i] = m_Color;
+	}
+}
+
+void SoftwareRenderer::BlendSpan(unsigned int* dstPtr, const unsigned int* srcPtr, int count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i channelMax = _mm_set1_epi16(255);
+	const __m128i half = _mm_set1_epi16(128);
+	const __m128i alphaMask = _mm_set1_epi32(int(0xFF000000));
+
+	// Four pixels at a time: dst = src + dst * (255 - srcAlpha) / 255
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i src = _mm_loadu_si128((const __m128i*)(srcPtr + i));
+		const int opaqueMask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), alphaMask));
+		if (opaqueMask == 0xFFFF)
+		{
+			_mm_storeu_si128((__m128i*)(dstPtr + i), src);
+			continue;
+		}
+		const int transparentMask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero));
+		if (transparentMask == 0xFFFF) continue;
+
+		const __m128i dst = _mm_loadu_si128((const __m128i*)(dstPtr + i));
+
+		// Two pixels per register, each channel widened to 16 bits
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		__m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+		__m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+
+		// Alpha is the fourth channel of each pixel, copied into all four
+		const __m128i invAlphaLo = _mm_sub_epi16(channelMax, _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		const __m128i invAlphaHi = _mm_sub_epi16(channelMax, _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+
+		// x / 255 rounded is (x + 128 + ((x + 128) >> 8)) >> 8
+		dstLo = _mm_add_epi16(_mm_mullo_epi16(dstLo, invAlphaLo), half);
+		dstHi = _mm_add_epi16(_mm_mullo_epi16(dstHi, invAlphaHi), half);
+		dstLo = _mm_srli_epi16(_mm_add_epi16(dstLo, _mm_srli_epi16(dstLo, 8)), 8);
+		dstHi = _mm_srli_epi16(_mm_add_epi16(dstHi, _mm_srli_epi16(dstHi, 8)), 8);
+
+		_mm_storeu_si128((__m128i*)(dstPtr + i), _mm_packus_epi16(_mm_add_epi16(srcLo, dstLo), _mm_add_epi16(srcHi, dstHi)));
+	}
+	for (; i < count; ++i)
+	{
+		dstPtr[i] = BlendPixel(dstPtr[i], srcPtr[i]);
+	}
+}
+
+unsigned int SoftwareRenderer::BlendPixel(unsigned int dst, unsigned int src)
+{
+	const unsigned int invAlpha = 255 - (src >> 24);
+
+	// Red and blue, then green and alpha, two channels per multiply
+	unsigned int redBlue = (dst & 0x00FF00FF) * invAlpha + 0x00800080;
+	redBlue = ((redBlue + ((redBlue >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+	unsigned int greenAlpha = ((dst >> 8) & 0x00FF00FF) * invAlpha + 0x00800080;
+	greenAlpha = (greenAlpha + ((greenAlpha >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+	return src + redBlue + greenAlpha;
+}
+
+unsigned int SoftwareRenderer::ScalePixel(unsigned int pixel, unsigned int scale)
+{
+	const unsigned int redBlue = (((pixel & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF;
+	const unsigned int greenAlpha = (((pixel >> 8) & 0x00FF00FF) * scale) & 0xFF00FF00;
+	return redBlue | greenAlpha;
+}
+
+void SoftwareRenderer::ClipSpan(double start, double step, int size, int& beginRef, int& endRef)
+{
+	// Keeps the indices i in [beginRef, endRef) for which 0 <= start + i * step < size
+	if (step == 0.0)
+	{
+		if (start < 0.0 || start >= size) endRef = beginRef;
+		return;
+	}
+
+	double first, last;
+	if (step > 0.0)
+	{
+		first = ceil(-start / step);
+		last = ceil((size - start) / step);
+	}
+	else
+	{
+		first = floor((size - start) / step) + 1.0;
+		last = floor(-start / step) + 1.0;
+	}
+	// Clamped before converting, a step close to zero gives huge values
+	beginRef = max(beginRef, int(min(first, double(endRef))));
+	endRef = min(endRef, int(max(last, double(beginRef))));
+}
+
+bool SoftwareRenderer::WritePNG(const String& filePathRef) const
+{
+	// Each row starts with filter type 0 (none), followed by straight (not premultiplied) RGBA
+	std::vector<unsigned char> rowsArr;
+	rowsArr.reserve((m_Width * 4 + 1) * m_Height);
+	for (int y = 0; y < m_Height; ++y)
+	{
+		rowsArr.push_back(0);
+		for (int x = 0; x < m_Width; ++x)
+		{
+			const unsigned int pixel = m_PixelsArr[y * m_Width + x];
+			const unsigned int alpha = pixel >> 24;
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				const unsigned int value = (pixel >> (channel * 8)) & 0xFF;
+				rowsArr.push_back(static_cast<unsigned char>((alpha == 0) ? 0 : min(255u, (value * 255 + alpha / 2) / alpha)));
+			}
+			rowsArr.push_back(static_cast<unsigned char>(alpha));
+		}
+	}
+
+	// A zlib stream of stored (uncompressed) deflate blocks
+	std::vector<unsigned char> zlibArr;
+	zlibArr.reserve(rowsArr.size() + rowsArr.size() / MAX_STORED_BLOCK_SIZE * 5 + 16);
+	zlibArr.push_back(0x78);
+	zlibArr.push_back(0x01);
+	size_t offset = 0;
+	do
+	{
+		const size_t blockSize = min(rowsArr.size() - offset, size_t(MAX_STORED_BLOCK_SIZE));
+		const bool isLastBlock = (offset + blockSize == rowsArr.size());
+		zlibArr.push_back(isLastBlock ? 1 : 0);
+		zlibArr.push_back(static_cast<unsigned char>(blockSize & 0xFF));
+		zlibArr.push_back(static_cast<unsigned char>(blockSize >> 8));
+		zlibArr.push_back(static_cast<unsigned char>(~blockSize & 0xFF));
+		zlibArr.push_back(static_cast<unsigned char>((~blockSize >> 8) & 0xFF));
+		zlibArr.insert(zlibArr.end(), rowsArr.begin() + offset, rowsArr.begin() + offset + blockSize);
+		offset += blockSize;
+	} while (offset < rowsArr.size());
+
+	unsigned int adlerA = 1, adlerB = 0;
+	for (size_t i = 0; i < rowsArr.size(); ++i)
+	{
+		adlerA = (adlerA + rowsArr[i]) % 65521;
+		adlerB = (adlerB + adlerA) % 65521;
+	}
+	AppendBigEndian(zlibArr, (adlerB << 16) | adlerA);
+
+	std::vector<unsigned char> headerArr;
+	AppendBigEndian(headerArr, m_Width);
+	AppendBigEndian(headerArr, m_Height);
+	headerArr.push_back(8); // bits per channel
+	headerArr.push_back(6); // color type: RGBA
+	headerArr.push_back(0); // compression
+	headerArr.push_back(0); // filter
+	headerArr.push_back(0); // interlace
+
+	std::ofstream fileStream(filePathRef.C_str(), std::ios::binary);
+	if (fileStream.fail())
+	{
+		OutputDebugString(String("ERROR: Could not open ") + filePathRef + String(" for writing\n"));
+		return false;
+	}
+
+	const unsigned char signatureArr[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	fileStream.write((const char*)signatureArr, sizeof(signatureArr));
+	WritePNGChunk(fileStream, "IHDR", headerArr);
+	WritePNGChunk(fileStream, "IDAT", zlibArr);
+	WritePNGChunk(fileStream, "IEND", std::vector<unsigned char>());
+
+	return fileStream.good();
+}
+
+void SoftwareRenderer::WritePNGChunk(std::ofstream& fileStreamRef, const char* typePtr, const std::vector<unsigned char>& dataArrRef)
+{
+	static unsigned int crcTableArr[256] = {};
+	if (crcTableArr[1] == 0)
+	{
+		for (unsigned int i = 0; i < 256; ++i)
+		{
+			unsigned int crc = i;
+			for (int bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+			}
+			crcTableArr[i] = crc;
+		}
+	}
+
+	// The CRC covers the type and the data, not the length
+	std::vector<unsigned char> chunkArr;
+	AppendBigEndian(chunkArr, static_cast<unsigned int>(dataArrRef.size()));
+	chunkArr.insert(chunkArr.end(), typePtr, typePtr + 4);
+	chunkArr.insert(chunkArr.end(), dataArrRef.begin(), dataArrRef.end());
+
+	unsigned int crc = 0xFFFFFFFF;
+	for (size_t i = 4; i < chunkArr.size(); ++i)
+	{
+		crc = crcTableArr[(crc ^ chunkArr[i]) & 0xFF] ^ (crc >> 8);
+	}
+	AppendBigEndian(chunkArr, crc ^ 0xFFFFFFFF);
+
+	fileStreamRef.write((const char*)chunkArr.data(), chunkArr.size());
+}
+
+void SoftwareRenderer::AppendBigEndian(std::vector<unsigned char>& bytesArrRef, unsigned int value)
+{
+	bytesArrRef.push_back(static_cast<unsigned char>(value >> 24));
+	bytesArrRef.push_back(static_cast<unsigned char>((value >> 16) & 0xFF));
+	bytesArrRef.push_back(static_cast<unsigned char>((value >> 8) & 0xFF));
+	bytesArrRef.push_back(static_cast<unsigned char>(value & 0xFF));
+}
+
+int SoftwareRenderer::GetWidth() const
+{
+	return m_Width;
+}
+
+int SoftwareRenderer::GetHeight() const
+{
+	return m_Height;
+}
+
+const std::vector<unsigned int>& SoftwareRenderer::GetPixels() const
+{
+	return m_PixelsArr;
+}
+
+unsigned int SoftwareRenderer::ToPixel(COLOR color)
+{
+	const unsigned int alpha = color.alpha;
+	const unsigned int red = (color.red * alpha + 127) / 255;
+	const unsigned int green = (color.green * alpha + 127) / 255;
+	const unsigned int blue = (color.blue * alpha + 127) / 255;
+	return red | (green << 8) | (blue << 16) | (alpha << 24);
+}
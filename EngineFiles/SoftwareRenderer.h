@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Header - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// SoftwareRenderer Class
+//-----------------------------------------------------------------
+// Paints the GameEngine draw calls on the CPU into a framebuffer of premultiplied RGBA pixels, without
+// Direct2D or a video card. Used by RunHeadless to paint frames and write them as PNG files.
+// Bitmaps are sampled nearest neighbour, shapes are filled without anti aliasing and text is not painted
+class SoftwareRenderer
+{
+public:
+	SoftwareRenderer(int width, int height);
+	virtual ~SoftwareRenderer();
+
+	SoftwareRenderer(const SoftwareRenderer&) = delete;
+	SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+	//! Fills the whole framebuffer with color, ignoring the transform
+	void Clear(COLOR color);
+	//! Sets the color of every shape drawn after this
+	void SetColor(COLOR color);
+	//! Sets the matrix which maps world space to framebuffer pixels, usually world * view
+	void SetTransform(const MATRIX3X2& matRef);
+
+	void DrawBitmap(Bitmap* bitmapPtr, DOUBLE2 position, RECT2 srcRect, double opacity);
+	void DrawLine(DOUBLE2 p1, DOUBLE2 p2, double strokeWidth);
+	void DrawRect(RECT2 rect, double strokeWidth);
+	void FillRect(RECT2 rect);
+	void DrawEllipse(DOUBLE2 center, double radiusX, double radiusY, double strokeWidth);
+	void FillEllipse(DOUBLE2 center, double radiusX, double radiusY);
+	//! Fills the polygon using the even-odd rule, like Direct2D does
+	void FillPolygon(const std::vector<DOUBLE2>& ptsArrRef);
+
+	//! Writes the framebuffer as an uncompressed RGBA PNG file, returns false if the file couldn't be written
+	bool WritePNG(const String& filePathRef) const;
+
+	int GetWidth() const;
+	int GetHeight() const;
+	//! Rows top to bottom, each pixel is R, G, B, A from the lowest byte up, premultiplied by A
+	const std::vector<unsigned int>& GetPixels() const;
+
+	//! Converts a color to a premultiplied RGBA pixel
+	static unsigned int ToPixel(COLOR color);
+
+private:
+	//! Fills every contour (in framebuffer pixels) as one shape, using the even-odd rule
+	void FillContours(const std::vector<std::vector<DOUBLE2>>& contoursArrRef);
+	//! Transforms the corners of rect and fills the quad they make
+	void FillTransformedRect(double left, double top, double right, double bottom);
+	//! Adds the outline of an ellipse in framebuffer pixels
+	void AddEllipseContour(std::vector<std::vector<DOUBLE2>>& contoursArrRef, DOUBLE2 center, double radiusX, double radiusY);
+
+	//! Paints m_Color on the pixels [left, right) of row y
+	void FillSpan(int y, int left, int right);
+	//! Paints count premultiplied source pixels over the destination pixels
+	static void BlendSpan(unsigned int* dstPtr, const unsigned int* srcPtr, int count);
+	static unsigned int BlendPixel(unsigned int dst, unsigned int src);
+	//! Multiplies every channel of pixel by scale / 256
+	static unsigned int ScalePixel(unsigned int pixel, unsigned int scale);
+	//! Narrows [beginRef, endRef) to the indices i for which start + i * step lies in [0, size)
+	static void ClipSpan(double start, double step, int size, int& beginRef, int& endRef);
+
+	static void WritePNGChunk(std::ofstream& fileStreamRef, const char* typePtr, const std::vector<unsigned char>& dataArrRef);
+	static void AppendBigEndian(std::vector<unsigned char>& bytesArrRef, unsigned int value);
+
+	static const int MIN_ELLIPSE_SEGMENTS = 16;
+	static const int MAX_STORED_BLOCK_SIZE = 65535;
+
+	std::vector<unsigned int> m_PixelsArr;
+	int m_Width;
+	int m_Height;
+
+	MATRIX3X2 m_Transform;
+	MATRIX3X2 m_InverseTransform;
+	unsigned int m_Color;
+
+	// Scratch space reused between draw calls, so painting doesn't allocate
+	std::vector<unsigned int> m_SpanPixelsArr;
+	std::vector<double> m_CrossingsArr;
+	std::vector<std::vector<DOUBLE2>> m_ContoursArr;
+};
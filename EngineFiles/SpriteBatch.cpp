@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Source - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+#include "stdafx.h"
+#include "../stdafx.h"
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch()
+{
+	m_SpritesArr.reserve(INITIAL_CAPACITY);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+}
+
+void SpriteBatch::Add(ID2D1Bitmap* bitmapPtr, const D2D1_RECT_F& dstRectRef, const D2D1_RECT_F& srcRectRef,
+	FLOAT opacity, D2D1_BITMAP_INTERPOLATION_MODE interpolationMode, const D2D1::Matrix3x2F& transformRef)
+{
+	m_SpritesArr.push_back({ bitmapPtr, dstRectRef, srcRectRef, opacity, interpolationMode, transformRef });
+}
+
+bool SpriteBatch::IsEmpty() const
+{
+	return m_SpritesArr.empty();
+}
+
+void SpriteBatch::Flush(ID2D1RenderTarget* renderTargetPtr)
+{
+	size_t batchStart = 0;
+	while (batchStart < m_SpritesArr.size())
+	{
+		const Sprite& firstRef = m_SpritesArr[batchStart];
+		size_t batchEnd = batchStart + 1;
+		while (batchEnd < m_SpritesArr.size() &&
+			m_SpritesArr[batchEnd].m_BitmapPtr == firstRef.m_BitmapPtr &&
+			IsSameTransform(m_SpritesArr[batchEnd].m_Transform, firstRef.m_Transform))
+		{
+			++batchEnd;
+		}
+
+		renderTargetPtr->SetTransform(firstRef.m_Transform);
+		for (size_t i = batchStart; i < batchEnd; ++i)
+		{
+			const Sprite& spriteRef = m_SpritesArr[i];
+			renderTargetPtr->DrawBitmap(spriteRef.m_BitmapPtr, spriteRef.m_DstRect, spriteRef.m_Opacity, spriteRef.m_InterpolationMode, spriteRef.m_SrcRect);
+		}
+
+		m_NumSprites += int(batchEnd - batchStart);
+		++m_NumBatches;
+		batchStart = batchEnd;
+	}
+
+	m_SpritesArr.clear();
+}
+
+void SpriteBatch::EndFrame()
+{
+	m_NumSpritesLastFrame = m_NumSprites;
+	m_NumBatchesLastFrame = m_NumBatches;
+	m_NumSprites = 0;
+	m_NumBatches = 0;
+}
+
+int SpriteBatch::GetSpritesLastFrame() const
+{
+	return m_NumSpritesLastFrame;
+}
+
+int SpriteBatch::GetBatchesLastFrame() const
+{
+	return m_NumBatchesLastFrame;
+}
+
+bool SpriteBatch::IsSameTransform(const D2D1::Matrix3x2F& transform1Ref, const D2D1::Matrix3x2F& transform2Ref)
+{
+	return transform1Ref._11 == transform2Ref._11 && transform1Ref._12 == transform2Ref._12 &&
+		transform1Ref._21 == transform2Ref._21 && transform1Ref._22 == transform2Ref._22 &&
+		transform1Ref._31 == transform2Ref._31 && transform1Ref._32 == transform2Ref._32;
+}
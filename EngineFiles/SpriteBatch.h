@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------
+// Game Engine
+// C++ Header - version v2_18a march 2016
+// Copyright Kevin Hoefman, 2006 - 2011
+// Copyright DAE Programming Team, 2012 - 2016
+// http://www.digitalartsandentertainment.be/
+//-----------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------------
+// SpriteBatch Class
+//-----------------------------------------------------------------
+// Collects every bitmap GameEngine::DrawBitmap is asked to draw, and draws them when anything else
+// is drawn or the frame ends. Sprites are drawn in the order they were added, so painter's order is
+// kept. Consecutive sprites from the same bitmap with the same transform form one batch, which is
+// submitted with a single transform change. Counts sprites and batches per frame.
+class SpriteBatch
+{
+public:
+	SpriteBatch();
+	virtual ~SpriteBatch();
+
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	void Add(ID2D1Bitmap* bitmapPtr, const D2D1_RECT_F& dstRectRef, const D2D1_RECT_F& srcRectRef, 
+		FLOAT opacity, D2D1_BITMAP_INTERPOLATION_MODE interpolationMode, const D2D1::Matrix3x2F& transformRef);
+	bool IsEmpty() const;
+
+	//! Draws and forgets every sprite added since the last flush
+	//! NOTE: Leaves the transform of the last batch set on the render target
+	void Flush(ID2D1RenderTarget* renderTargetPtr);
+	//! Stores this frame's counters and starts counting the next frame
+	void EndFrame();
+
+	int GetSpritesLastFrame() const;
+	int GetBatchesLastFrame() const;
+
+	static const int INITIAL_CAPACITY = 1024;
+
+private:
+	struct Sprite
+	{
+		ID2D1Bitmap* m_BitmapPtr;
+		D2D1_RECT_F m_DstRect;
+		D2D1_RECT_F m_SrcRect;
+		FLOAT m_Opacity;
+		D2D1_BITMAP_INTERPOLATION_MODE m_InterpolationMode;
+		D2D1::Matrix3x2F m_Transform;
+	};
+
+	static bool IsSameTransform(const D2D1::Matrix3x2F& transform1Ref, const D2D1::Matrix3x2F& transform2Ref);
+
+	std::vector<Sprite> m_SpritesArr;
+
+	int m_NumSprites = 0;
+	int m_NumBatches = 0;
+	int m_NumSpritesLastFrame = 0;
+	int m_NumBatchesLastFrame = 0;
+};
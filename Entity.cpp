@@ -1,6 +1,8 @@
 #include "stdafx.h"
 
 #include "Entity.h"
+#include "Level.h"
+#include "ProbeService.h"
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
 
@@ -20,6 +22,8 @@ Entity::Entity(DOUBLE2 centerPos, BodyType bodyType,
 
 Entity::~Entity()
 {
+	if (m_HasSubmittedProbes) m_LevelPtr->CancelProbes(this);
+
 	delete m_ActPtr;
 }
 
@@ -28,6 +32,28 @@ bool Entity::Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, D
 	return m_ActPtr->Raycast(point1, point2, intersectionRef, normalRef, fractionRef);
 }
 
+void Entity::SubmitProbe(Probe& probeRef)
+{
+	m_HasSubmittedProbes = true;
+	m_LevelPtr->SubmitProbe(this, &probeRef);
+}
+
+void Entity::RunProbe(Probe& probeRef)
+{
+	// Some entities remove their actor while they're dying
+	if (m_ActPtr == nullptr)
+	{
+		probeRef.m_Hit = false;
+		return;
+	}
+
+	const DOUBLE2 point1 = m_ActPtr->GetPosition();
+	const DOUBLE2 point2 = point1 + probeRef.m_Offset;
+	DOUBLE2 intersection, normal;
+	double fraction = -1.0;
+	probeRef.m_Hit = m_LevelPtr->Raycast(point1, point2, probeRef.m_CollisionBits, intersection, normal, fraction);
+}
+
 void Entity::SetPaused(bool paused)
 {
 	m_ActPtr->SetActive(!paused);
@@ -47,3 +73,48 @@ DOUBLE2 Entity::GetPosition()
 {
 	return m_ActPtr->GetPosition();
 }
+
+int Entity::GetLevelDataIndex() const
+{
+	return m_LevelDataIndex;
+}
+
+void Entity::SetLevelDataIndex(int index)
+{
+	m_LevelDataIndex = index;
+}
+
+int Entity::GetPaintListIndex() const
+{
+	return m_PaintListIndex;
+}
+
+void Entity::SetPaintListIndex(int index)
+{
+	m_PaintListIndex = index;
+}
+
+void Entity::SetActivated(bool activated)
+{
+}
+
+double Entity::GetActivationX()
+{
+	return m_ActPtr->GetPosition().x;
+}
+
+bool Entity::IsMovedByPhysics()
+{
+	return m_ActPtr != nullptr && m_ActPtr->IsActive() && m_ActPtr->IsAwake() && m_ActPtr->GetBodyType() != BodyType::STATIC;
+}
+
+RECT2 Entity::GetPaintBounds()
+{
+	const DOUBLE2 pos = m_ActPtr->GetPosition();
+	return RECT2(pos.x - PAINT_EXTENT, pos.y - PAINT_EXTENT, pos.x + PAINT_EXTENT, pos.y + PAINT_EXTENT);
+}
+
+Entity::GridCell& Entity::GetGridCell()
+{
+	return m_GridCell;
+}
@@ -5,6 +5,7 @@
 
 class SpriteSheet;
 class Level;
+struct Probe;
 
 class Entity
 {
@@ -28,8 +29,50 @@ public:
 
 	virtual bool Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef);
 
+	// Has the level run this probe from this entity's center after the next physics step
+	void SubmitProbe(Probe& probeRef);
+	// Called by ProbeService
+	void RunProbe(Probe& probeRef);
+
+	// Where this entity is stored in LevelData, -1 when it isn't stored there (or has been removed)
+	int GetLevelDataIndex() const;
+	void SetLevelDataIndex(int index);
+	// Where this entity is in the LevelData paint list for its layer
+	int GetPaintListIndex() const;
+	void SetPaintListIndex(int index);
+
+	// Called by LevelData when the player comes close enough for this entity to be ticked, and when they leave again
+	virtual void SetActivated(bool activated);
+	// The x position the player's distance is measured from to decide whether this entity is activated
+	virtual double GetActivationX();
+	// Whether the physics step can still change the activation x while this entity isn't ticked
+	virtual bool IsMovedByPhysics();
+	// Everything this entity paints fits inside this rect, it isn't painted while the rect is off screen
+	virtual RECT2 GetPaintBounds();
+
+	// How far from their position most entities paint
+	static const int PAINT_EXTENT = 32;
+
+	// Where an ActivationGrid keeps this entity, only the grid should change this
+	struct GridCell
+	{
+		int m_Bucket = -1;
+		int m_IndexInBucket = -1;
+		int m_ActiveIndex = -1; // -1 while not activated
+		int m_MovingIndex = -1; // -1 unless this entity isn't activated but its body may still be moving
+		bool m_AlwaysActive = false; // Activated no matter how far away the player is, these aren't in a bucket
+		double m_X = 0.0; // The activation x when the grid last looked at this entity
+	};
+	GridCell& GetGridCell();
+
 protected:
 	PhysicsActor* m_ActPtr = nullptr;
 	Level* m_LevelPtr = nullptr;
 	AnimationInfo m_AnimInfo;
+
+private:
+	int m_LevelDataIndex = -1;
+	int m_PaintListIndex = -1;
+	GridCell m_GridCell;
+	bool m_HasSubmittedProbes = false;
 };
@@ -7,7 +7,9 @@ struct Constants
 
 enum class ActorId
 {
-	PLAYER, PLATFORM, PIPE, ENEMY, LEVEL, ITEM, YOSHI, YOSHI_TOUNGE
+	PLAYER, PLATFORM, PIPE, ENEMY, LEVEL, ITEM, YOSHI, YOSHI_TOUNGE,
+	// NOTE: All entries must be above this line
+	_LAST_ELEMENT
 };
 
 struct Direction
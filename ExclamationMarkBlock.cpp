@@ -88,3 +88,16 @@ void ExclamationMarkBlock::Hit()
 		SoundManager::PlaySoundEffect(SoundManager::Sound::BLOCK_HIT);
 	}
 }
+
+bool ExclamationMarkBlock::ResetToSpawnState()
+{
+	ResetBodyAndAnimation();
+
+	m_BumpAnimationTimer = SMWTimer(14);
+	m_yo = 0;
+	m_IsUsed = false;
+	m_ShouldSpawnSuperMushroom = false;
+	SetSolid(true);
+
+	return true;
+}
@@ -14,6 +14,7 @@ public:
 	void Paint();
 	void SetSolid(bool solid);
 	void Hit();
+	bool ResetToSpawnState();
 
 private:
 	Colour m_Colour;
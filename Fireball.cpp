@@ -4,7 +4,6 @@
 #include "Game.h"
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
-#include "Player.h"
 
 const double Fireball::VERTICAL_VEL = 25;
 const double Fireball::HORIZONTAL_VEL = 140;
@@ -57,9 +56,8 @@ void Fireball::Tick(double deltaTime)
 	m_AnimInfo.Tick(deltaTime);
 	m_AnimInfo.frameNumber %= 2;
 
-	const DOUBLE2 playerPos = m_LevelPtr->GetPlayer()->GetPosition();
-	const double dX = abs(m_ActPtr->GetPosition().x - playerPos.x);
-	if (dX > Game::WIDTH) m_LevelPtr->RemoveItem(this);
+	// Fireballs are removed once they are too far from the player to be activated
+	if (m_IsActive == false) m_LevelPtr->RemoveItem(this);
 }
 
 void Fireball::Paint()
@@ -20,6 +20,8 @@
 #include "GameState.h"
 #include "LevelProperties.h"
 #include "Keybindings.h"
+#include "ParticlePool.h"
+#include "SMWFont.h"
 
 // Static initializations
 Font* Game::Font12Ptr = nullptr;
@@ -36,6 +38,7 @@ MATRIX3X2 Game::matIdentity;
 bool Game::DEBUG_SHOWING_CAMERA_INFO = false;
 bool Game::DEBUG_SHOWING_PLAYER_INFO = false;
 bool Game::DEBUG_SHOWING_ENEMY_AI_INFO = false;
+bool Game::DEBUG_SHOWING_PROFILER_INFO = false;
 const bool Game::DEBUG_SKIP_MAIN_MENU = false;
 const bool Game::DEBUG_ZOOM_OUT = false;
 const bool Game::DEBUG_START_MUTED = false;
@@ -104,6 +107,8 @@ void Game::GameStart()
 		matIdentity = MATRIX3X2::CreateScalingMatrix(0.65) * MATRIX3X2::CreateTranslationMatrix(150, 0);
 	}
 
+	ParticlePool::ResetCounters();
+
 	m_StateManagerPtr = new StateManager(this);
 
 	Reset();
@@ -136,14 +141,27 @@ void Game::GameEnd()
 
 	LevelData::UnloadAllLevelData();
 	SpriteSheetManager::Unload();
+	// The cached layouts were laid out on the font sheets which were just unloaded
+	SMWFont::ClearLayoutCache();
 
 	SoundManager::UnloadSoundsAndSongs();
 
 	delete m_StateManagerPtr;
+
+	// Every level, and with it every particle, is gone now
+	ParticlePool::Shutdown();
+
+	const String& profileFilePath = Profiler::GetCSVFilePath();
+	if (profileFilePath.Length() > 0 && Profiler::WriteCSV(profileFilePath) == false)
+	{
+		OutputDebugString(String("ERROR: Unable to write profiler samples to ") + profileFilePath + String("\n"));
+	}
 }
 
 void Game::GameTick(double deltaTime)
 {	
+	ProfileScope profileScope(Profiler::Phase::GAME_TICK);
+
 	if (GAME_ENGINE->IsKeyboardKeyPressed(Keybindings::TOGGLE_MUTED))
 	{
 		SoundManager::ToggleMuted();
@@ -161,13 +179,32 @@ void Game::GameTick(double deltaTime)
 	{
 		DEBUG_SHOWING_ENEMY_AI_INFO = !DEBUG_SHOWING_ENEMY_AI_INFO;
 	}
+	if (GAME_ENGINE->IsKeyboardKeyPressed(Keybindings::DEBUG_TOGGLE_PROFILER_OVERLAY))
+	{
+		DEBUG_SHOWING_PROFILER_INFO = !DEBUG_SHOWING_PROFILER_INFO;
+	}
 
 	m_StateManagerPtr->Tick(deltaTime);
 }
 
-void Game::GamePaint()
+void Game::GamePaint(double alpha)
 {
+	m_InterpolationAlpha = alpha;
+
 	GAME_ENGINE->SetViewMatrix(matIdentity);
 
 	m_StateManagerPtr->Paint();
 }
+
+double Game::GetInterpolationAlpha() const
+{
+	return m_InterpolationAlpha;
+}
+
+Level* Game::GetCurrentLevel() const
+{
+	BaseState* currentStatePtr = m_StateManagerPtr->CurrentState();
+	if (currentStatePtr == nullptr || currentStatePtr->GetType() != StateType::GAME) return nullptr;
+
+	return ((GameState*)currentStatePtr)->GetCurrentLevel();
+}
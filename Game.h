@@ -39,11 +39,17 @@ public:
 	virtual void GameStart();
 	virtual void GameEnd();
 	virtual void GameTick(double deltaTime);
-	virtual void GamePaint();
+	virtual void GamePaint(double alpha);
 
 	virtual void GameSetSleeping(bool sleeping);
 
 	void Reset();
+
+	// How far (0 to 1) the frame being painted lies between the previous tick and the next one
+	double GetInterpolationAlpha() const;
+
+	// Returns nullptr when no level is being played, in the menus for example
+	Level* GetCurrentLevel() const;
 	
 	static Font *Font12Ptr;
 	static Font *Font9Ptr;
@@ -63,6 +69,7 @@ public:
 	static bool DEBUG_SHOWING_CAMERA_INFO;
 	static bool DEBUG_SHOWING_PLAYER_INFO;
 	static bool DEBUG_SHOWING_ENEMY_AI_INFO;
+	static bool DEBUG_SHOWING_PROFILER_INFO;
 	static const bool DEBUG_SKIP_MAIN_MENU;
 	static const bool DEBUG_ZOOM_OUT;
 	static const bool DEBUG_START_MUTED;
@@ -82,4 +89,6 @@ private:
 	bool m_WasMuted = false;
 
 	StateManager* m_StateManagerPtr = nullptr;
+
+	double m_InterpolationAlpha = 1.0;
 };
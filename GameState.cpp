@@ -10,6 +10,10 @@
 #include "SessionInfo.h"
 #include "Pipe.h"
 #include "Keybindings.h"
+#include "Player.h"
+
+DOUBLE2 GameState::m_FinalPlayerPos;
+bool GameState::m_HasFinalPlayerPos = false;
 
 GameState::GameState(StateManager* stateManagerPtr) :
 	BaseState(stateManagerPtr, StateType::GAME)
@@ -17,6 +21,14 @@ GameState::GameState(StateManager* stateManagerPtr) :
 	GameSession::ReadSessionInfoFromFile();
 
 	int levelIndex = 0; // Start the player in level 0
+	if (GAME_ENGINE->IsReplayingInput())
+	{
+		levelIndex = GAME_ENGINE->GetInputReplayLevelIndex();
+	}
+
+	// NOTE: This seeds rand() while recording and while replaying, so it must happen before the level spawns anything
+	GAME_ENGINE->BeginLevelInput(levelIndex);
+
 	m_CurrentLevelPtr = new Level(m_StateManagerPtr->GetGamePtr(), this, LevelProperties::Get(levelIndex));
 
 	ResetMembers();
@@ -26,8 +38,16 @@ GameState::GameState(StateManager* stateManagerPtr) :
 
 GameState::~GameState()
 {
+	if (m_HasFinalPlayerPos == false && (GAME_ENGINE->IsRecordingInput() || GAME_ENGINE->IsReplayingInput()))
+	{
+		m_FinalPlayerPos = m_CurrentLevelPtr->GetPlayer()->GetPosition();
+		m_HasFinalPlayerPos = true;
+	}
+
+	GAME_ENGINE->EndInputRecording();
 	GameSession::WriteSessionInfoToFile(m_CurrentLevelPtr);
 	delete m_CurrentLevelPtr;
+	DeleteSuspendedLevels();
 }
 
 void GameState::Reset()
@@ -97,6 +117,13 @@ void GameState::Tick(double deltaTime)
 	}
 
 	m_CurrentLevelPtr->Tick(deltaTime);
+
+	if (m_PendingWarpPipePtr != nullptr)
+	{
+		Pipe* warpPipePtr = m_PendingWarpPipePtr;
+		m_PendingWarpPipePtr = nullptr;
+		EnterNewLevel(warpPipePtr, m_PendingWarpSessionInfo);
+	}
 }
 
 void GameState::Paint()
@@ -121,10 +148,66 @@ void GameState::EnterNewLevel(Pipe* spawningPipePtr, SessionInfo sessionInfo)
 	m_CurrentLevelPtr->WarpPlayerToPipe(pipeIndex);
 }
 
+void GameState::RequestPipeWarp(Pipe* spawningPipePtr, SessionInfo sessionInfo)
+{
+	m_PendingWarpPipePtr = spawningPipePtr;
+	m_PendingWarpSessionInfo = sessionInfo;
+}
+
 void GameState::EnterNewLevel(int levelIndex, SessionInfo sessionInfo, Pipe* spawningPipePtr)
 {
-	delete m_CurrentLevelPtr;
-	m_CurrentLevelPtr = new Level(m_StateManagerPtr->GetGamePtr(), this, LevelProperties::Get(levelIndex), sessionInfo, spawningPipePtr);
+	Level* nextLevelPtr = nullptr;
+	for (size_t i = 0; i < m_SuspendedLevelsPtrArr.size(); ++i)
+	{
+		if (m_SuspendedLevelsPtrArr[i]->GetIndex() == levelIndex)
+		{
+			nextLevelPtr = m_SuspendedLevelsPtrArr[i];
+			m_SuspendedLevelsPtrArr.erase(m_SuspendedLevelsPtrArr.begin() + i);
+			break;
+		}
+	}
+
+	// NOTE: The current level must be suspended before the next one creates any bodies,
+	// since suspending deactivates every body which is active at the time
+	m_CurrentLevelPtr->Suspend();
+	m_SuspendedLevelsPtrArr.push_back(m_CurrentLevelPtr);
+	if (int(m_SuspendedLevelsPtrArr.size()) > MAX_SUSPENDED_LEVELS)
+	{
+		delete m_SuspendedLevelsPtrArr[0];
+		m_SuspendedLevelsPtrArr.erase(m_SuspendedLevelsPtrArr.begin());
+	}
+
+	if (nextLevelPtr != nullptr)
+	{
+		nextLevelPtr->Resume(sessionInfo, spawningPipePtr);
+	}
+	else
+	{
+		nextLevelPtr = new Level(m_StateManagerPtr->GetGamePtr(), this, LevelProperties::Get(levelIndex), sessionInfo, spawningPipePtr);
+	}
+	m_CurrentLevelPtr = nextLevelPtr;
+}
+
+bool GameState::GetFinalPlayerPosition(DOUBLE2& positionRef)
+{
+	if (m_HasFinalPlayerPos == false) return false;
+
+	positionRef = m_FinalPlayerPos;
+	return true;
+}
+
+Level* GameState::GetCurrentLevel() const
+{
+	return m_CurrentLevelPtr;
+}
+
+void GameState::DeleteSuspendedLevels()
+{
+	for (size_t i = 0; i < m_SuspendedLevelsPtrArr.size(); ++i)
+	{
+		delete m_SuspendedLevelsPtrArr[i];
+	}
+	m_SuspendedLevelsPtrArr.clear();
 }
 
 bool GameState::ShowingSessionInfo() const
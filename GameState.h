@@ -1,10 +1,10 @@
 #pragma once
 
 #include "BaseState.h"
+#include "SessionInfo.h"
 
 class Level;
 class Pipe;
-struct SessionInfo;
 
 class GameState : public BaseState
 {
@@ -23,15 +23,38 @@ public:
 
 	// Spawn at given pipe
 	void EnterNewLevel(Pipe* spawningPipePtr, SessionInfo sessionInfo);
+	// Enters the level spawningPipePtr leads to once the current level has finished its tick.
+	// Switching levels halfway through a tick would let the old level tick on after it was suspended
+	void RequestPipeWarp(Pipe* spawningPipePtr, SessionInfo sessionInfo);
 	// Spawn at beginning of level
 	void EnterNewLevel(int levelIndex, SessionInfo sessionInfo, Pipe* spawningPipePtr = nullptr);
 
+	void DeleteSuspendedLevels();
+
+	Level* GetCurrentLevel() const;
+
+	// Where the player was when the recorded or replayed game state ended, false if none has ended yet.
+	// A replay should end exactly where its recording did, the runner prints this so both runs can be compared
+	static bool GetFinalPlayerPosition(DOUBLE2& positionRef);
+
 private:
 	void Reset();
 	void ResetMembers();
 	
 	Level* m_CurrentLevelPtr = nullptr;
+
+	// Set by RequestPipeWarp, handled at the end of Tick
+	Pipe* m_PendingWarpPipePtr = nullptr;
+	SessionInfo m_PendingWarpSessionInfo;
+
+	// Levels the player left through a pipe, least recently used first
+	std::vector<Level*> m_SuspendedLevelsPtrArr;
+	static const int MAX_SUSPENDED_LEVELS = 2;
+
 	bool m_ShowingSessionInfo;
 	bool m_RenderDebugOverlay;
 	bool m_InFrameByFrameMode;
+
+	static DOUBLE2 m_FinalPlayerPos;
+	static bool m_HasFinalPlayerPos;
 };
@@ -17,6 +17,9 @@
 #include <dxgidebug.h>
 
 #include "Game.h"
+#include "Benchmark.h"
+#include "LevelDataFile.h"
+#include "GameState.h"
 
 //-----------------------------------------------------------------
 // Defines
@@ -55,8 +58,95 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, char * szCmdLin
 
 	int returnValue = 0;
 
-	GAME_ENGINE->SetGame(new Game());
-	returnValue = GAME_ENGINE->Run(hInstance, iCmdShow); // run the game engine and return the result
+	// Command line options:
+	//   -headless [ticks]  steps the game without a window, as fast as possible
+	//   -record <file>     records the keyboard state of every tick, starting when a level is entered
+	//   -replay <file>     feeds a recording back instead of the keyboard, combine with -headless to run un-throttled
+	//   -frames <folder> [ticksPerFrame]  with -headless, paints every ticksPerFrame'th tick on the CPU and writes it to folder as a PNG
+	//   -benchmark <file>  runs every benchmark scenario headless and writes the results to file as JSON
+	//   -compilelevels     compiles every level's level-data.txt into level-data.bin and exits
+	//   -profile <file>    writes the per tick profiler samples to file as CSV when the game ends
+	bool headless = false;
+	bool compileLevels = false;
+	int numTicks = 0;
+	std::string recordFilePath;
+	std::string replayFilePath;
+	std::string benchmarkFilePath;
+	std::istringstream commandLineStream(szCmdLine);
+	std::string option;
+	while (commandLineStream >> option)
+	{
+		if (option == "-headless")
+		{
+			headless = true;
+			commandLineStream >> std::ws;
+			if (isdigit(commandLineStream.peek())) commandLineStream >> numTicks;
+		}
+		else if (option == "-record")
+		{
+			commandLineStream >> recordFilePath;
+			GAME_ENGINE->SetInputRecordingFilePath(String(recordFilePath.c_str()));
+		}
+		else if (option == "-replay")
+		{
+			commandLineStream >> replayFilePath;
+			GAME_ENGINE->SetInputReplayFilePath(String(replayFilePath.c_str()));
+		}
+		else if (option == "-frames")
+		{
+			std::string folderPath;
+			int ticksPerFrame = 1;
+			commandLineStream >> folderPath >> std::ws;
+			if (isdigit(commandLineStream.peek())) commandLineStream >> ticksPerFrame;
+			GAME_ENGINE->SetHeadlessFrameOutput(String(folderPath.c_str()), ticksPerFrame);
+		}
+		else if (option == "-benchmark")
+		{
+			commandLineStream >> benchmarkFilePath;
+		}
+		else if (option == "-compilelevels")
+		{
+			compileLevels = true;
+		}
+		else if (option == "-profile")
+		{
+			std::string filePath;
+			commandLineStream >> filePath;
+			Profiler::SetCSVFilePath(String(filePath.c_str()));
+		}
+	}
+
+	if (compileLevels)
+	{
+		returnValue = LevelDataFile::CompileAllLevels() ? 0 : 1;
+	}
+	else if (benchmarkFilePath.empty() == false)
+	{
+		// Every scenario runs in a game of its own
+		returnValue = Benchmark::RunAllScenarios(String(benchmarkFilePath.c_str())) ? 0 : 1;
+	}
+	else if (headless)
+	{
+		GAME_ENGINE->SetGame(new Game());
+
+		// Without a replay to tell how long to run, run for a minute of game time
+		if (numTicks <= 0 && replayFilePath.empty()) numTicks = 60 * 60;
+		returnValue = GAME_ENGINE->RunHeadless(numTicks);
+	}
+	else
+	{
+		GAME_ENGINE->SetGame(new Game());
+		returnValue = GAME_ENGINE->Run(hInstance, iCmdShow); // run the game engine and return the result
+	}
+
+	// A replay should end exactly where its recording did, compare this line between both runs
+	DOUBLE2 finalPlayerPos;
+	if ((recordFilePath.empty() == false || replayFilePath.empty() == false) && GameState::GetFinalPlayerPosition(finalPlayerPos))
+	{
+		String text = String("Final player position: ") + String(finalPlayerPos.x, 2) + String(", ") + String(finalPlayerPos.y, 2) + String("\n");
+		OutputDebugString(text);
+		if (headless) std::cout << text.C_str();
+	}
 
 	// Destroy the game engine
 	GameEngine::Destroy();
@@ -126,6 +126,11 @@ void GoalGate::PaintFrontPole()
 	}
 }
 
+RECT2 GoalGate::GetPaintBounds()
+{
+	return RECT2(m_TopLeft.x, m_TopLeft.y, m_TopLeft.x + TILES_WIDE * TILE_SIZE, m_TopLeft.y + TILES_HIGH * TILE_SIZE);
+}
+
 void GoalGate::Hit()
 {
 	m_IsHit = true;
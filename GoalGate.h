@@ -14,6 +14,7 @@ public:
 	void Tick(double deltaTime);
 	void Paint();
 	void PaintFrontPole();
+	RECT2 GetPaintBounds();
 	void Hit();
 
 	bool IsHit();
@@ -5,8 +5,6 @@
 #include "SpriteSheet.h"
 #include "SoundManager.h"
 #include "Level.h"
-#include "EnemyDeathCloudParticle.h"
-#include "SplatParticle.h"
 #include "Player.h"
 #include "BlockBreakParticle.h"
 
@@ -42,8 +40,7 @@ void GrabBlock::Tick(double deltaTime)
 
 	if (m_LifeRemaining.Tick() && m_LifeRemaining.IsComplete())
 	{
-		EnemyDeathCloudParticle* cloudParticlePtr = new EnemyDeathCloudParticle(m_ActPtr->GetPosition());
-		m_LevelPtr->AddParticle(cloudParticlePtr);
+		m_LevelPtr->AddParticle(SpriteParticleStore::Kind::ENEMY_DEATH_CLOUD, m_ActPtr->GetPosition());
 
 		if (playerPtr->GetHeldItemPtr() == this)
 		{
@@ -98,8 +95,7 @@ void GrabBlock::KickVertically(double deltaTime, double horizontalVel)
 {
 	SoundManager::PlaySoundEffect(SoundManager::Sound::SHELL_KICK);
 
-	SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(splatParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition());
 
 	m_ActPtr->SetLinearVelocity(DOUBLE2(horizontalVel, VERTICAL_KICK_VEL * deltaTime));
 }
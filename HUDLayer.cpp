@@ -0,0 +1,150 @@
+#include "stdafx.h"
+
+#include "HUDLayer.h"
+#include "Game.h"
+#include "HUD.h"
+#include "SpriteSheetManager.h"
+
+bool HUDLayer::Values::operator==(const Values& otherRef) const
+{
+	return m_Lives == otherRef.m_Lives &&
+		m_DragonCoins == otherRef.m_DragonCoins &&
+		m_RedStars == otherRef.m_RedStars &&
+		m_TimeRemaining == otherRef.m_TimeRemaining &&
+		m_Coins == otherRef.m_Coins &&
+		m_Score == otherRef.m_Score;
+}
+
+HUDLayer::HUDLayer()
+{
+}
+
+HUDLayer::~HUDLayer()
+{
+}
+
+void HUDLayer::Paint(const Values& valuesRef)
+{
+	if (m_IsBuilt == false || (valuesRef == m_ValuesShown) == false)
+	{
+		Rebuild(valuesRef);
+	}
+
+	Bitmap* hudBmpPtr = SpriteSheetManager::GetBitmapPtr(SpriteSheetManager::HUD);
+	for (size_t i = 0; i < m_QuadsArr.size(); ++i)
+	{
+		const Quad& quadRef = m_QuadsArr[i];
+		GAME_ENGINE->DrawBitmap(hudBmpPtr, quadRef.m_Left, quadRef.m_Top, quadRef.m_SrcRect);
+	}
+}
+
+int HUDLayer::GetNumRebuilds() const
+{
+	return m_NumRebuilds;
+}
+
+void HUDLayer::Rebuild(const Values& valuesRef)
+{
+	m_QuadsArr.clear();
+	m_ValuesShown = valuesRef;
+	m_IsBuilt = true;
+	++m_NumRebuilds;
+
+	int x = 15;
+	int y = 15;
+
+	// MARIO
+	AddQuad(x, y, RECT2(1, 1, 41, 9));
+
+	// X
+	x += 9;
+	y += 8;
+	AddQuad(x, y, RECT2(10, 61, 10 + 7, 61 + 7));
+
+	// LIVES
+	x += 15;
+	AddNumber(x, y, valuesRef.m_Lives, false);
+
+	// DRAGON COINS
+	x += 24;
+	y = 15;
+	for (int i = 0; i < valuesRef.m_DragonCoins; ++i)
+	{
+		AddQuad(x, y, RECT2(1, 60, 1 + 8, 60 + 8));
+		x += 8;
+	}
+
+	// RED STAR
+	y += 8;
+	x = 70;
+	AddQuad(x, y, RECT2(19, 60, 19 + 8, 60 + 8));
+
+	// X
+	x += 10;
+	y += 2;
+	AddQuad(x, y, RECT2(10, 61, 10 + 7, 61 + 7));
+
+	// NUMBER OF STARS
+	x += 24;
+	y -= 7;
+	AddLargeNumber(x, y, valuesRef.m_RedStars);
+
+	// ITEM BOX (the reserve item itself is painted by the player)
+	x += 10;
+	y -= 7;
+	AddQuad(x, y, RECT2(36, 52, 36 + 28, 52 + 28));
+
+	// TIME LABEL
+	x += 37;
+	y = 15;
+	AddQuad(x, y, RECT2(1, 52, 1 + 24, 52 + 7));
+
+	// TIME VALUE
+	y += 9;
+	x += 16;
+	AddNumber(x, y, valuesRef.m_TimeRemaining, true);
+
+	// COIN LABEL
+	x += 33;
+	y = 15;
+	AddQuad(x, y, RECT2(1, 60, 1 + 16, 60 + 8));
+
+	// COINS
+	x += 30;
+	AddNumber(x, y, valuesRef.m_Coins, false);
+
+	// SCORE
+	y += 8;
+	AddNumber(x, y, valuesRef.m_Score, false);
+}
+
+void HUDLayer::AddQuad(int left, int top, RECT2 srcRect)
+{
+	Quad quad;
+	quad.m_Left = left;
+	quad.m_Top = top;
+	quad.m_SrcRect = srcRect;
+	m_QuadsArr.push_back(quad);
+}
+
+void HUDLayer::AddNumber(int x, int y, int number, bool yellow)
+{
+	number = abs(number);
+
+	do {
+		AddQuad(x, y, HUD::GetSmallSingleNumberSrcRect(number % 10, yellow));
+		x -= 8;
+		number /= 10;
+	} while (number > 0);
+}
+
+void HUDLayer::AddLargeNumber(int x, int y, int number)
+{
+	number = abs(number);
+
+	do {
+		AddQuad(x, y, HUD::GetLargeSingleNumberSrcRect(number % 10));
+		x -= 8;
+		number /= 10;
+	} while (number > 0);
+}
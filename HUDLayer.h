@@ -0,0 +1,50 @@
+#pragma once
+
+// The HUD painted along the top of the screen during a level. Every piece of it comes from the HUD bitmap,
+// so it's kept as a list of quads which is only laid out again when one of the values shown changes.
+// Every other frame the list is painted as is, which the sprite batch draws in one batch
+class HUDLayer
+{
+public:
+	struct Values
+	{
+		int m_Lives;
+		int m_DragonCoins;
+		int m_RedStars;
+		int m_TimeRemaining;
+		int m_Coins;
+		int m_Score;
+
+		bool operator==(const Values& otherRef) const;
+	};
+
+	HUDLayer();
+	virtual ~HUDLayer();
+
+	HUDLayer(const HUDLayer&) = delete;
+	HUDLayer& operator=(const HUDLayer&) = delete;
+
+	void Paint(const Values& valuesRef);
+
+	// How many times the quads were laid out again since this layer was made
+	int GetNumRebuilds() const;
+
+private:
+	struct Quad
+	{
+		int m_Left;
+		int m_Top;
+		RECT2 m_SrcRect;
+	};
+
+	void Rebuild(const Values& valuesRef);
+	void AddQuad(int left, int top, RECT2 srcRect);
+	// NOTE: Like HUD::PaintSeveralDigitNumber, x is the left of the right-most digit
+	void AddNumber(int x, int y, int number, bool yellow);
+	void AddLargeNumber(int x, int y, int number);
+
+	std::vector<Quad> m_QuadsArr;
+	Values m_ValuesShown;
+	bool m_IsBuilt = false;
+	int m_NumRebuilds = 0;
+};
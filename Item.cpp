@@ -30,22 +30,17 @@ Item::Item(DOUBLE2 topLeft, Type type, Level* levelPtr, int filterCategoryBits,
 
 Item::~Item() {}
 
-void Item::Tick(double deltaTime)
+void Item::SetActivated(bool activated)
 {
-	if (m_IsActive == false)
-	{
-		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_ActPtr->GetPosition().x) < MINIMUM_PLAYER_DISTANCE)
-		{
-			m_IsActive = true;
-		}
-	}
-	else
-	{
-		if (abs(m_LevelPtr->GetPlayer()->GetPosition().x - m_ActPtr->GetPosition().x) >= MINIMUM_PLAYER_DISTANCE)
-		{
-			m_IsActive = false;
-		}
-	}
+	m_IsActive = activated;
+}
+
+RECT2 Item::GetPaintBounds()
+{
+	const DOUBLE2 pos = m_ActPtr->GetPosition();
+	const double extentX = max(double(PAINT_EXTENT), WIDTH / 2.0 + TILE_SIZE);
+	const double extentY = max(double(PAINT_EXTENT), HEIGHT / 2.0 + TILE_SIZE);
+	return RECT2(pos.x - extentX, pos.y - extentY, pos.x + extentX, pos.y + extentY);
 }
 
 Item::Type Item::GetType()
@@ -63,6 +58,29 @@ void Item::SetLinearVelocity(DOUBLE2 newVel)
 	m_ActPtr->SetLinearVelocity(newVel);
 }
 
+bool Item::ResetToSpawnState()
+{
+	return false;
+}
+
+void Item::ResetBodyAndAnimation()
+{
+	m_ActPtr->SetPosition(m_SpawningPosition);
+	m_ActPtr->SetLinearVelocity(DOUBLE2(0, 0));
+	m_ActPtr->SetActive(true);
+	m_IsActive = m_IsAlwaysActive;
+
+	// NOTE: AnimationInfo::Reset also resets the frame rate, which every item sets itself
+	const double secondsPerFrame = m_AnimInfo.secondsPerFrame;
+	m_AnimInfo.Reset();
+	m_AnimInfo.secondsPerFrame = secondsPerFrame;
+}
+
+bool Item::IsAlwaysActive() const
+{
+	return m_IsAlwaysActive;
+}
+
 bool Item::IsBlock()
 {
 	return (m_Type == Type::EXCLAMATION_MARK_BLOCK ||
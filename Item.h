@@ -15,7 +15,9 @@ public:
 		BEANSTALK, CLOUD_BLOCK,
 		SUPER_MUSHROOM, FIRE_FLOWER, CAPE_FEATHER, STAR, POWER_BALLOON,
 		PRIZE_BLOCK, MESSAGE_BLOCK, ROTATING_BLOCK, EXCLAMATION_MARK_BLOCK, GRAB_BLOCK,
-		MIDWAY_GATE, GOAL_GATE
+		MIDWAY_GATE, GOAL_GATE,
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
 	};
 
 	Item(DOUBLE2 topLeft, Type type, Level* levelPtr,
@@ -26,12 +28,19 @@ public:
 	Item(const Item&) = delete;
 	Item& operator=(const Item&) = delete;
 
-	void Tick(double deltaTime);
 	virtual void Paint() = 0;
 
+	void SetActivated(bool activated) override;
+	// Covers the whole body, for items which are taller or wider than most
+	RECT2 GetPaintBounds();
+
 	void SetLinearVelocity(DOUBLE2 newVel);
 	void SetPosition(DOUBLE2 newPos);
 
+	// Puts this item back the way it was when the level was loaded so it can be reused after a reset.
+	// Returns false if this item can't be reset in place, it will be deleted and spawned again instead
+	virtual bool ResetToSpawnState();
+
 	static Type StringToTYPE(std::string string);
 	static std::string TYPEToString(Type type);
 
@@ -41,15 +50,26 @@ public:
 
 	Type GetType();
 	bool IsBlock();
+	// Blocks, beanstalks and gates are ticked even when the player is far away, like they always were:
+	// a block's bounce, a growing beanstalk and a gate's bar have to carry on while off screen
+	bool IsAlwaysActive() const;
 
 	static const int TILE_SIZE = 16;
+
 protected:
+	// LevelData builds its item activation grid with MINIMUM_PLAYER_DISTANCE
+	friend class LevelData;
+
 	static const int MINIMUM_PLAYER_DISTANCE; // how close the player needs to get for us to activate
 
+	// Moves the body back to where it spawned and restarts the animation
+	void ResetBodyAndAnimation();
+
 	const int WIDTH;
 	const int HEIGHT;
 	RECT2 m_Bounds;
 	bool m_IsActive;
+	bool m_IsAlwaysActive = false;
 	DOUBLE2 m_SpawningPosition;
 
 private:
@@ -31,6 +31,7 @@ int Keybindings::DEBUG_FRAME_BY_FRAME_ADVANCE;
 int Keybindings::DEBUG_TOGGLE_CAMERA_DEBUG_OVERLAY;
 int Keybindings::DEBUG_TOGGLE_PLAYER_INFO;
 int Keybindings::DEBUG_TOGGLE_ENEMY_AI_OVERLAY;
+int Keybindings::DEBUG_TOGGLE_PROFILER_OVERLAY;
 
 int Keybindings::LEFT_SHOULDER;
 int Keybindings::RIGHT_SHOULDER;
@@ -94,6 +95,7 @@ void Keybindings::StoreStringData(const std::string& fileContents)
 	DEBUG_TOGGLE_CAMERA_DEBUG_OVERLAY = RegisterKeycode(fileContents, "DEBUGToggleCameraDebugOverlay", VK_F9);
 	DEBUG_TOGGLE_PLAYER_INFO = RegisterKeycode(fileContents, "DEBUGTogglePlayerInfo", VK_F10);
 	DEBUG_TOGGLE_ENEMY_AI_OVERLAY = RegisterKeycode(fileContents, "DEBUGToggleEnemyAIInfo", VK_F11);
+	DEBUG_TOGGLE_PROFILER_OVERLAY = RegisterKeycode(fileContents, "DEBUGToggleProfilerOverlay", VK_F8);
 
 	LEFT_SHOULDER = RegisterKeycode(fileContents, "LeftShoulder", 'Q');
 	RIGHT_SHOULDER = RegisterKeycode(fileContents, "RightShoulder", 'E');
@@ -34,6 +34,7 @@ struct Keybindings
 	static int DEBUG_TOGGLE_CAMERA_DEBUG_OVERLAY;
 	static int DEBUG_TOGGLE_PLAYER_INFO;
 	static int DEBUG_TOGGLE_ENEMY_AI_OVERLAY;
+	static int DEBUG_TOGGLE_PROFILER_OVERLAY;
 
 private:
 	Keybindings() = delete;
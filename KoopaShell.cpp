@@ -4,10 +4,8 @@
 #include "Game.h"
 #include "SpriteSheet.h"
 #include "SpriteSheetManager.h"
-#include "SplatParticle.h"
 #include "Level.h"
 #include "Player.h"
-#include "EnemyPoofParticle.h"
 #include "SoundManager.h"
 
 const double KoopaShell::HORIZONTAL_KICK_BASE_VEL = 300;
@@ -35,7 +33,6 @@ KoopaShell::~KoopaShell()
 
 void KoopaShell::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
 	if (m_IsActive == false) m_ShouldBeRemoved = true;
 
 	if (m_ShouldBeRemoved)
@@ -69,17 +66,15 @@ void KoopaShell::Tick(double deltaTime)
 		m_AnimInfo.Tick(deltaTime);
 		m_AnimInfo.frameNumber %= 3;
 
-		DOUBLE2 point1 = m_ActPtr->GetPosition();
-		DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirMoving * (WIDTH / 2 + 2), 0);
-		DOUBLE2 intersection, normal;
-		double fraction = -1.0;
-		int collisionBits = Level::LEVEL | Level::BLOCK;
-
-		if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+		if (m_WallProbe.m_Hit)
 		{
 			m_DirMoving = -m_DirMoving;
 		}
 
+		m_WallProbe.m_Offset = DOUBLE2(m_DirMoving * (WIDTH / 2 + 2), 0);
+		m_WallProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+		SubmitProbe(m_WallProbe);
+
 		// Prevent moving off the left side of the level into infinity
 		if (m_ActPtr->GetPosition().x < -WIDTH)
 		{
@@ -123,8 +118,7 @@ void KoopaShell::KickHorizontally(int facingDir, bool wasThrown)
 
 	if (wasThrown)
 	{
-		SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition() + DOUBLE2(m_DirMoving * -3, 0));
-		m_LevelPtr->AddParticle(splatParticlePtr);
+		m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition() + DOUBLE2(m_DirMoving * -3, 0));
 	}
 }
 
@@ -132,8 +126,7 @@ void KoopaShell::KickVertically(double deltaTime, double horizontalVel)
 {
 	SoundManager::PlaySoundEffect(SoundManager::Sound::SHELL_KICK);
 
-	SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition() + DOUBLE2(m_DirMoving * -3, 0));
-	m_LevelPtr->AddParticle(splatParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition() + DOUBLE2(m_DirMoving * -3, 0));
 
 	m_ActPtr->SetLinearVelocity(DOUBLE2(horizontalVel, VERTICAL_KICK_VEL * deltaTime));
 	m_IsBouncing = true;
@@ -155,8 +148,7 @@ void KoopaShell::ShellHit(int dirX)
 
 void KoopaShell::Stomp()
 {
-	EnemyPoofParticle* poofParticlePtr = new EnemyPoofParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(poofParticlePtr);
+	m_LevelPtr->AddEnemyPoofParticles(m_ActPtr->GetPosition());
 
 	m_LevelPtr->GetPlayer()->AddScore(200, true, m_ActPtr->GetPosition());
 
@@ -43,6 +43,7 @@ private:
 	// NOTE: Moving is true when this shell is sliding on the ground, and animating
 	bool m_IsMoving = false;
 	int m_DirMoving;
+	Probe m_WallProbe;
 
 	// NOTE: This is true when this shell has been thrown into the air by the player
 	// and hasn't hit the ground yet
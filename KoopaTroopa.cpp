@@ -8,8 +8,6 @@
 #include "SpriteSheet.h"
 #include "SoundManager.h"
 
-#include "EnemyPoofParticle.h"
-#include "SplatParticle.h"
 
 KoopaTroopa::KoopaTroopa(DOUBLE2 startingPos, Level* levelPtr, Colour colour) :
 	Enemy(Type::KOOPA_TROOPA, startingPos, GetWidth(), GetHeight(), BodyType::DYNAMIC, levelPtr, this),
@@ -30,7 +28,6 @@ KoopaTroopa::~KoopaTroopa()
 
 void KoopaTroopa::Tick(double deltaTime)
 {
-	Enemy::Tick(deltaTime);
 	if (m_IsActive == false) return;
 
 	if (m_ShouldAddKoopaShell)
@@ -98,29 +95,25 @@ void KoopaTroopa::Tick(double deltaTime)
 	m_AnimInfo.frameNumber %= 2;
 
 	// NOTE: Checks if this koopa is near an obstacle, if true then turns around
-	DOUBLE2 point1 = m_ActPtr->GetPosition();
-	DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
-	DOUBLE2 intersection, normal;
-	double fraction = -1.0;
-	int collisionBits = Level::LEVEL | Level::BLOCK | Level::ENEMY | Level::SHELL;
-
-	if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+	if (m_WallProbe.m_Hit)
 	{
 		ChangeDirections();
 	}
-
-
 	// NOTE: Checks if this koopa about to walk off an edge, and turns around if so
-	point1 = m_ActPtr->GetPosition();
-	point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), GetHeight() / 2 + 4);
-	fraction = -1.0;
-	collisionBits = Level::LEVEL | Level::BLOCK;
-
-	if (!m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+	else if (m_LedgeProbe.m_Hit == false)
 	{
 		ChangeDirections();
 	}
 
+	// Both probes are run after the next physics step, and read on the next tick
+	m_WallProbe.m_Offset = DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
+	m_WallProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK | Level::ENEMY | Level::SHELL;
+	SubmitProbe(m_WallProbe);
+
+	m_LedgeProbe.m_Offset = DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), GetHeight() / 2 + 4);
+	m_LedgeProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_LedgeProbe);
+
 	double xVel = WALK_VEL;
 	if (m_DirFacing == Direction::LEFT)
 	{
@@ -287,8 +280,7 @@ void KoopaTroopa::ShellHit(bool shellWasBeingHeld)
 
 	SoundManager::PlaySoundEffect(SoundManager::Sound::SHELL_KICK);
 
-	SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(splatParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition());
 
 	int score = 200;
 	if (shellWasBeingHeld) score = 1000;
@@ -299,8 +291,7 @@ void KoopaTroopa::ShellHit(bool shellWasBeingHeld)
 
 void KoopaTroopa::StompKill()
 {
-	EnemyPoofParticle* poofParticlePtr = new EnemyPoofParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(poofParticlePtr);
+	m_LevelPtr->AddEnemyPoofParticles(m_ActPtr->GetPosition());
 
 	m_LevelPtr->GetPlayer()->AddScore(200, true, m_ActPtr->GetPosition());
 
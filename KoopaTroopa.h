@@ -76,6 +76,9 @@ private:
 	Colour m_Colour;
 	AnimationState m_AnimationState;
 
+	Probe m_WallProbe;
+	Probe m_LedgeProbe;
+
 	static const int FRAMES_OF_BEING_SHELLESS = 85;
 	int m_FramesSpentBeingShelless = -1;
 
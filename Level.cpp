@@ -6,7 +6,7 @@
 #include "Camera.h"
 #include "LevelData.h"
 #include "SpriteSheetManager.h"
-#include "HUD.h"
+#include "ChunkedBitmap.h"
 #include "LevelProperties.h"
 #include "SMWFont.h"
 #include "Keybindings.h"
@@ -25,6 +25,7 @@
 #include "GrabBlock.h"
 #include "Particle.h"
 #include "ParticleManager.h"
+#include "ParticlePool.h"
 #include "Player.h"
 #include "SuperMushroom.h"
 #include "KoopaShell.h"
@@ -43,6 +44,11 @@ const double Level::TIME_SCALE = 1.5;
 const int Level::TIME_UP_WARNING = 100;
 const int Level::MESSAGE_BLOCK_WARNING_TIME = 60;
 
+const int Level::FIRST_ITEM_CONTACT_KIND = int(ActorId::_LAST_ELEMENT);
+const int Level::FIRST_ENEMY_CONTACT_KIND = Level::FIRST_ITEM_CONTACT_KIND + int(Item::Type::_LAST_ELEMENT);
+const int Level::NUM_CONTACT_KINDS = Level::FIRST_ENEMY_CONTACT_KIND + int(Enemy::Type::_LAST_ELEMENT);
+std::vector<Level::ContactRules> Level::m_ContactRulesArr;
+
 Level::Level(Game* gamePtr, GameState* gameStatePtr, LevelProperties levelInfo, SessionInfo sessionInfo, Pipe* spawningPipePtr) :
 	m_GamePtr(gamePtr), 
 	INDEX(levelInfo.m_Index),
@@ -51,13 +57,16 @@ Level::Level(Game* gamePtr, GameState* gameStatePtr, LevelProperties levelInfo,
 	m_BmpBackgroundPtr((Bitmap*)levelInfo.m_BmpBackgroundPtr),
 	IS_BACKGROUND_ANIMATED(levelInfo.m_NumberOfBackgroundAnimationFrames > -1),
 	TOTAL_FRAMES_OF_BACKGROUND_ANIMATION(levelInfo.m_NumberOfBackgroundAnimationFrames),
-	m_BmpForegroundPtr((Bitmap*)levelInfo.m_BmpForegroundPtr),
+	m_BmpForegroundPtr(levelInfo.m_BmpForegroundPtr),
 	m_BackgroundSong(levelInfo.m_BackgroundMusic),
 	m_BackgroundSongFast(levelInfo.m_BackgroundMusicFast),
 	TOTAL_TIME(levelInfo.m_TotalTime),
 	m_GameStatePtr(gameStatePtr)
 {
+	if (m_ContactRulesArr.empty()) InitializeContactRules();
+
 	m_ParticleManagerPtr = new ParticleManager();
+	m_ProbeServicePtr = new ProbeService();
 	ResetMembers();
 
 	if (sessionInfo.m_PlayerLives == -1) // The session info hasn't been set, use defaults
@@ -75,16 +84,20 @@ Level::Level(Game* gamePtr, GameState* gameStatePtr, LevelProperties levelInfo,
 			DOUBLE2 yoshiPos(0, 0);
 			if (spawningPipePtr != nullptr) yoshiPos = spawningPipePtr->GetWarpToPosition();
 			m_YoshiPtr = new Yoshi(yoshiPos, this, true);
+			m_YoshiPrevPosition = yoshiPos;
 		}
 	}
 
 	m_PlayerPtr = new Player(this, gameStatePtr, sessionInfo);
+	m_PlayerPrevPosition = m_PlayerPtr->GetPosition();
 
 	m_ActLevelPtr = new PhysicsActor(DOUBLE2(0, 0), 0, BodyType::STATIC);
 	m_ActLevelPtr->AddSVGFixture(levelInfo.m_LevelSVGFilePath, 0.0);
 	m_ActLevelPtr->AddContactListener(this);
 	m_ActLevelPtr->SetUserData(int(ActorId::LEVEL));
 
+	BuildTileMap(levelInfo.m_LevelSVGFilePath);
+
 	m_CameraPtr = new Camera(Game::WIDTH, Game::HEIGHT, this);
 
 	m_CoinsToBlocksTimer = SMWTimer(480);
@@ -100,16 +113,94 @@ Level::~Level()
 	delete m_CameraPtr;
 	delete m_ParticleManagerPtr;
 	delete m_YoshiPtr;
+	delete m_TileMapPtr;
+	m_BmpForegroundPtr->ReleaseAllChunks();
+	// NOTE: Deleted last since every entity cancels its probes when it's deleted
+	delete m_ProbeServicePtr;
 }
 
 void Level::Reset()
 {
+	// Starting over, any other level the player went through should be fresh again too
+	m_GameStatePtr->DeleteSuspendedLevels();
+
 	m_PlayerPtr->Reset();
+	m_PlayerPrevPosition = m_PlayerPtr->GetPosition();
 	m_CameraPtr->Reset();
 
 	ResetMembers();
 }
 
+void Level::Suspend()
+{
+	// NOTE: Bodies of other suspended levels are already inactive, so every active body belongs to us
+	b2World* worldPtr = GameEngine::GetSingleton()->GetBox2DWorld();
+	for (b2Body* bodyPtr = worldPtr->GetBodyList(); bodyPtr != nullptr; bodyPtr = bodyPtr->GetNext())
+	{
+		if (bodyPtr->IsActive())
+		{
+			m_SuspendedBodiesPtrArr.push_back(bodyPtr);
+			bodyPtr->SetActive(false);
+		}
+	}
+
+	SoundManager::SetAllSongsPaused(true);
+}
+
+void Level::Resume(SessionInfo sessionInfo, Pipe* spawningPipePtr)
+{
+	for (size_t i = 0; i < m_SuspendedBodiesPtrArr.size(); ++i)
+	{
+		m_SuspendedBodiesPtrArr[i]->SetActive(true);
+	}
+	m_SuspendedBodiesPtrArr.clear();
+
+	// Whatever the player carried into the pipe went with them
+	if (m_PlayerPtr->IsHoldingItem())
+	{
+		m_LevelDataPtr->RemoveItem(m_PlayerPtr->GetHeldItemPtr());
+		m_LevelDataPtr->DeleteRemovedEntities();
+	}
+	if (m_YoshiPtr != nullptr && (m_PlayerPtr->IsRidingYoshi() || sessionInfo.m_PlayerRidingYoshi == 1))
+	{
+		delete m_YoshiPtr;
+		m_YoshiPtr = nullptr;
+	}
+	if (sessionInfo.m_PlayerRidingYoshi == 1)
+	{
+		DOUBLE2 yoshiPos(0, 0);
+		if (spawningPipePtr != nullptr) yoshiPos = spawningPipePtr->GetWarpToPosition();
+		m_YoshiPtr = new Yoshi(yoshiPos, this, true);
+		m_YoshiPrevPosition = yoshiPos;
+	}
+
+	m_PlayerPtr->Reset();
+	m_PlayerPtr->ApplySessionInfo(sessionInfo);
+	m_PlayerPrevPosition = m_PlayerPtr->GetPosition();
+	m_CameraPtr->Reset();
+	m_ParticleManagerPtr->Reset();
+
+	// The level was paused when the player entered the pipe
+	SetPaused(false, false);
+
+	if (sessionInfo.m_PlayerLives != -1)
+	{
+		m_TimeRemaining = sessionInfo.m_TimeRemaining;
+		m_SecondsElapsed = int((TOTAL_TIME - m_TimeRemaining + 1) * (1.0 / TIME_SCALE));
+		m_IsCheckpointCleared = (sessionInfo.m_CheckpointCleared == 1);
+	}
+	m_TimeWarningPlayed = false;
+	m_ActiveMessagePtr = nullptr;
+
+	SoundManager::RestartAndPauseSongs();
+	SoundManager::PlaySong(m_BackgroundSong);
+}
+
+int Level::GetIndex() const
+{
+	return INDEX;
+}
+
 void Level::ResetMembers()
 {
 	m_Paused = false;
@@ -119,15 +210,28 @@ void Level::ResetMembers()
 	m_TimeWarningPlayed = false;
 	m_PSwitchTimeWarningPlayed = false;
 
-	LevelData::UnloadLevelData(INDEX);
+	if (m_LevelDataPtr == nullptr)
+	{
+		LevelData::UnloadLevelData(INDEX);
+	}
+	else
+	{
+		// Restarting the level, no need to read it from disk again
+		m_LevelDataPtr->ResetToSpawnTemplate();
+	}
 	ReadLevelData(INDEX);
 
+	// Anything still waiting to be removed was either reset or deleted above
+	m_ItemsToBeRemovedPtrArr.clear();
+	m_EnemiesToBeRemovedPtrArr.clear();
+
 	delete m_YoshiPtr;
 	m_YoshiPtr = nullptr;
 	m_ActiveMessagePtr = nullptr;
 
 	m_SecondsElapsed = 0.0;
 	m_ParticleManagerPtr->Reset();
+	m_ProbeServicePtr->Reset();
 	m_FinalExtraScore = {};
 
 	SoundManager::RestartAndPauseSongs();
@@ -140,8 +244,8 @@ void Level::ReadLevelData(int levelIndex)
 
 	std::vector<Platform*> platformsData = m_LevelDataPtr->GetPlatforms();
 	std::vector<Pipe*> pipesData = m_LevelDataPtr->GetPipes();
-	std::vector<Item*> itemsData = m_LevelDataPtr->GetItems();
-	std::vector<Enemy*> enemiesData = m_LevelDataPtr->GetEnemies();
+	const std::vector<Item*>& itemsData = m_LevelDataPtr->GetItems();
+	const std::vector<Enemy*>& enemiesData = m_LevelDataPtr->GetEnemies();
 
 	for (size_t i = 0; i < platformsData.size(); ++i)
 	{
@@ -153,16 +257,52 @@ void Level::ReadLevelData(int levelIndex)
 	}
 	for (size_t i = 0; i < itemsData.size(); ++i)
 	{
-		itemsData[i]->AddContactListener(this);
+		if (itemsData[i] != nullptr) itemsData[i]->AddContactListener(this);
 	}
 	for (size_t i = 0; i < enemiesData.size(); ++i)
 	{
-		enemiesData[i]->AddContactListener(this);
+		if (enemiesData[i] != nullptr) enemiesData[i]->AddContactListener(this);
+	}
+}
+
+void Level::BuildTileMap(const String& svgFilePathRef)
+{
+	m_TileMapPtr = new TileMap(WIDTH, HEIGHT);
+
+	// NOTE: The level actor was just built from these chains, so they're already in the cache
+	const std::vector<std::vector<DOUBLE2>>* chainsArrPtr = SVGGeometryCache::GetGeometry(svgFilePathRef);
+	if (chainsArrPtr != nullptr)
+	{
+		m_TileMapPtr->AddChains(*chainsArrPtr);
+	}
+
+	const std::vector<Pipe*>& pipesPtrArrRef = m_LevelDataPtr->GetPipes();
+	for (size_t i = 0; i < pipesPtrArrRef.size(); ++i)
+	{
+		m_TileMapPtr->AddRect(pipesPtrArrRef[i]->GetBounds(), TileMap::Tile::SOLID);
+	}
+
+	const std::vector<Platform*>& platformsPtrArrRef = m_LevelDataPtr->GetPlatforms();
+	for (size_t i = 0; i < platformsPtrArrRef.size(); ++i)
+	{
+		m_TileMapPtr->AddRect(platformsPtrArrRef[i]->GetBounds(), TileMap::Tile::SEMI_SOLID);
 	}
 }
 
+const TileMap* Level::GetTileMap() const
+{
+	return m_TileMapPtr;
+}
+
 void Level::Tick(double deltaTime)
 {
+	// The world was stepped after the last tick, so this is the first chance to probe where everything ended up
+	m_ProbeServicePtr->Run();
+
+	m_CameraPtr->StorePreviousViewMatrix();
+	m_PlayerPrevPosition = m_PlayerPtr->GetPosition();
+	if (m_YoshiPtr != nullptr) m_YoshiPrevPosition = m_YoshiPtr->GetPosition();
+
 	if (m_GamePausedTimer.Tick() && m_GamePausedTimer.IsComplete())
 	{
 		SetPaused(false, false);
@@ -236,22 +376,27 @@ void Level::Tick(double deltaTime)
 	}
 
 	m_SecondsElapsed += (deltaTime);
+	m_TimeRemaining = TOTAL_TIME - (int(m_SecondsElapsed * TIME_SCALE));
+	if (m_TimeWarningPlayed == false && m_TimeRemaining <= TIME_UP_WARNING)
+	{
+		SpeedUpMusic();
+	}
 
-	for (size_t i = 0; i < m_ItemsToBeRemovedPtrArr.size(); ++i)
 	{
-		if (m_ItemsToBeRemovedPtrArr[i] != nullptr)
+		ProfileScope profileScope(Profiler::Phase::ITEM_ENEMY_REMOVAL);
+		for (size_t i = 0; i < m_ItemsToBeRemovedPtrArr.size(); ++i)
 		{
 			m_LevelDataPtr->RemoveItem(m_ItemsToBeRemovedPtrArr[i]);
-			m_ItemsToBeRemovedPtrArr[i] = nullptr;
 		}
-	}
-	for (size_t i = 0; i < m_EnemiesToBeRemovedPtrArr.size(); ++i)
-	{
-		if (m_EnemiesToBeRemovedPtrArr[i] != nullptr)
+		m_ItemsToBeRemovedPtrArr.clear();
+
+		for (size_t i = 0; i < m_EnemiesToBeRemovedPtrArr.size(); ++i)
 		{
 			m_LevelDataPtr->RemoveEnemy(m_EnemiesToBeRemovedPtrArr[i]);
-			m_EnemiesToBeRemovedPtrArr[i] = nullptr;
 		}
+		m_EnemiesToBeRemovedPtrArr.clear();
+
+		m_LevelDataPtr->DeleteRemovedEntities();
 	}
 
 	if (m_PlayerPtr->GetExtraItemType() != Item::Type::NONE &&
@@ -290,19 +435,33 @@ void Level::Tick(double deltaTime)
 		m_YoshiPtr->Tick(deltaTime);
 	}
 
-	m_PlayerPtr->Tick(deltaTime);
-	m_ParticleManagerPtr->Tick(deltaTime);
-	m_LevelDataPtr->TickItemsAndEnemies(deltaTime, this);
+	{
+		ProfileScope profileScope(Profiler::Phase::PLAYER_TICK);
+		m_PlayerPtr->Tick(deltaTime);
+	}
+	{
+		ProfileScope profileScope(Profiler::Phase::PARTICLES_TICK);
+		m_ParticleManagerPtr->Tick(deltaTime);
+	}
+	{
+		ProfileScope profileScope(Profiler::Phase::ITEMS_AND_ENEMIES_TICK);
+		m_LevelDataPtr->TickItemsAndEnemies(deltaTime, this);
+	}
 
+	ProfileScope profileScope(Profiler::Phase::CAMERA);
 	m_CameraPtr->CalculateViewMatrix(this, deltaTime);
 }
 
 void Level::Paint()
 {
-	const MATRIX3X2 matCameraView = m_CameraPtr->GetViewMatrix();
+	const double alpha = m_GamePtr->GetInterpolationAlpha();
+	const MATRIX3X2 matCameraView = m_CameraPtr->GetViewMatrix(alpha);
 	const MATRIX3X2 matTotalView = matCameraView *  Game::matIdentity;
 	GAME_ENGINE->SetViewMatrix(matTotalView);
 
+	m_ViewCulling.m_VisibleRect = m_CameraPtr->GetVisibleRect(alpha);
+	m_ViewCulling.ResetCounters();
+
 	const int bgWidth = m_BmpBackgroundPtr->GetWidth();
 	const double cameraX = -matCameraView.orig.x;
 	const double parallax = (1.0 - 0.50); // 50% of the speed of the camera
@@ -332,25 +491,26 @@ void Level::Paint()
 	{
 		GAME_ENGINE->DrawBitmap(m_BmpBackgroundPtr, DOUBLE2(xo + bgWidth, -32), bgSrcRect);
 	}
-	m_LevelDataPtr->PaintEnemiesInBackground();
+	m_LevelDataPtr->PaintBackgroundLayer(m_ViewCulling);
 	if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::IN_PIPE)
 	{
-		m_PlayerPtr->Paint();
+		PaintPlayer(alpha);
 	}
 
 	// Foreground
-	GAME_ENGINE->DrawBitmap(m_BmpForegroundPtr);
-	m_LevelDataPtr->PaintItemsAndEnemies();
+	m_BmpForegroundPtr->Paint(m_ViewCulling.m_VisibleRect);
+	// A held item moves with the player, so it's painted with the same offset
+	m_LevelDataPtr->PaintMainLayer(m_ViewCulling, m_PlayerPtr->GetHeldItemPtr(), GetPlayerPaintOffset(alpha));
 	if (m_YoshiPtr != nullptr && m_PlayerPtr->IsRidingYoshi() == false)
 	{
-		m_YoshiPtr->Paint();
+		PaintYoshi(alpha);
 	}
 	if (m_PlayerPtr->GetAnimationState() != Player::AnimationState::IN_PIPE)
 	{
-		m_PlayerPtr->Paint();
+		PaintPlayer(alpha);
 	}
-	m_LevelDataPtr->PaintItemsInForeground();
-	m_ParticleManagerPtr->Paint();
+	m_LevelDataPtr->PaintForegroundLayer(m_ViewCulling);
+	m_ParticleManagerPtr->Paint(m_ViewCulling);
 
 	GAME_ENGINE->SetViewMatrix(Game::matIdentity);
 
@@ -389,100 +549,75 @@ void Level::Paint()
 		}
 	}
 
+	if (Game::DEBUG_SHOWING_PROFILER_INFO)
+	{
+		GAME_ENGINE->SetColor(COLOR(0, 0, 0));
+		GAME_ENGINE->SetFont(Game::Font9Ptr);
+		// Sits right above the player info block
+		Profiler::Paint(10, 179, 9);
+		ParticlePool::Paint(150, 179, 9);
+		GAME_ENGINE->DrawString(String("sprites/batches: ") + String(GAME_ENGINE->GetSpritesDrawnLastFrame()) +
+			String("/") + String(GAME_ENGINE->GetSpriteBatchesLastFrame()), 150, 116);
+		GAME_ENGINE->DrawString(String("paints drawn/culled: ") + String(m_ViewCulling.m_NumDrawn) +
+			String("/") + String(m_ViewCulling.m_NumCulled), 150, 107);
+		GAME_ENGINE->DrawString(String("fg chunks loaded: ") + String(m_BmpForegroundPtr->GetNumLoadedChunks()), 150, 98);
+		GAME_ENGINE->DrawString(String("hud rebuilds: ") + String(m_HUDLayer.GetNumRebuilds()), 150, 89);
+	}
+
 	GAME_ENGINE->SetViewMatrix(matTotalView);
 }
 
-void Level::PaintHUD()
+void Level::PaintPlayer(double alpha)
 {
-	const int playerLives = m_PlayerPtr->GetLives();
-	const int playerDragonCoins = m_PlayerPtr->GetDragonCoinsCollected();
-	const int playerRedStars = m_PlayerPtr->GetRedStarsCollected();
-	const int playerCoins = m_PlayerPtr->GetCoinsCollected();
-	const int playerScore = m_PlayerPtr->GetScore();
-	const Item::Type playerExtraItemType = m_PlayerPtr->GetExtraItemType();
-
-	m_TimeRemaining = TOTAL_TIME - (int(m_SecondsElapsed * TIME_SCALE));
-	if (m_TimeWarningPlayed == false && m_TimeRemaining <= TIME_UP_WARNING)
+	// Yoshi is painted along with the player while being ridden
+	RECT2 bounds = m_PlayerPtr->GetPaintBounds();
+	if (m_PlayerPtr->IsRidingYoshi() && m_YoshiPtr != nullptr)
 	{
-		SpeedUpMusic();
+		const RECT2 yoshiBounds = m_YoshiPtr->GetPaintBounds();
+		bounds.left = min(bounds.left, yoshiBounds.left);
+		bounds.top = min(bounds.top, yoshiBounds.top);
+		bounds.right = max(bounds.right, yoshiBounds.right);
+		bounds.bottom = max(bounds.bottom, yoshiBounds.bottom);
 	}
+	if (m_ViewCulling.IsVisible(bounds) == false) return;
+
+	const MATRIX3X2 matPrevWorld = GAME_ENGINE->GetWorldMatrix();
+	GAME_ENGINE->SetWorldMatrix(MATRIX3X2::CreateTranslationMatrix(GetPlayerPaintOffset(alpha)) * matPrevWorld);
+	m_PlayerPtr->Paint();
+	GAME_ENGINE->SetWorldMatrix(matPrevWorld);
+}
+
+void Level::PaintYoshi(double alpha)
+{
+	if (m_ViewCulling.IsVisible(m_YoshiPtr->GetPaintBounds()) == false) return;
 
-	int x = 15;
-	int y = 15;
-	RECT2 srcRect;
-	Bitmap* hudBmpPtr = SpriteSheetManager::GetBitmapPtr(SpriteSheetManager::HUD);
+	// Painted where yoshi would be between the previous and the current tick, like the player
+	const DOUBLE2 yoshiPos = m_YoshiPtr->GetPosition();
+	const DOUBLE2 paintOffset = (m_YoshiPrevPosition - yoshiPos) * (1.0 - alpha);
 
-	// MARIO
-	srcRect = RECT2(1, 1, 41, 9);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-	
-	// X
-	x += 9;
-	y += 8;
-	srcRect = RECT2(10, 61, 10 + 7, 61 + 7);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// LIVES
-	x += 15;
-	HUD::PaintSeveralDigitNumber(x, y, playerLives, false);
-
-	// DRAGON COINS
-	x += 24;
-	y = 15;
-	for (int i = 0; i < playerDragonCoins; ++i)
-	{
-		srcRect = RECT2(1, 60, 1 + 8, 60 + 8);
-		GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-		x += 8;
-	}
-
-	// RED STAR
-	y += 8;
-	x = 70;
-	srcRect = RECT2(19, 60, 19 + 8, 60 + 8);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// X
-	x += 10;
-	y += 2;
-	srcRect = RECT2(10, 61, 10 + 7, 61 + 7);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// NUMBER OF STARS
-	x += 24;
-	y -= 7;
-	HUD::PaintSeveralDigitLargeNumber(x, y, playerRedStars);
-
-	// ITEM BOX
-	x += 10;
-	y -= 7;
-	srcRect = RECT2(36, 52, 36 + 28, 52 + 28);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// TIME LABEL
-	x += 37;
-	y = 15;
-	srcRect = RECT2(1, 52, 1 + 24, 52 + 7);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// TIME VALUE
-	y += 9;
-	x += 16;
-	HUD::PaintSeveralDigitNumber(x, y, m_TimeRemaining, true);
-
-	// COIN LABEL
-	x += 33;
-	y = 15;
-	srcRect = RECT2(1, 60, 1 + 16, 60 + 8);
-	GAME_ENGINE->DrawBitmap(hudBmpPtr, x, y, srcRect);
-
-	// COINS
-	x += 30;
-	HUD::PaintSeveralDigitNumber(x, y, playerCoins, false);
-
-	// SCORE
-	y += 8;
-	HUD::PaintSeveralDigitNumber(x, y, playerScore, false);
+	const MATRIX3X2 matPrevWorld = GAME_ENGINE->GetWorldMatrix();
+	GAME_ENGINE->SetWorldMatrix(MATRIX3X2::CreateTranslationMatrix(paintOffset) * matPrevWorld);
+	m_YoshiPtr->Paint();
+	GAME_ENGINE->SetWorldMatrix(matPrevWorld);
+}
+
+DOUBLE2 Level::GetPlayerPaintOffset(double alpha) const
+{
+	// The player is painted where it would be between the previous and the current tick
+	return (m_PlayerPrevPosition - m_PlayerPtr->GetPosition()) * (1.0 - alpha);
+}
+
+void Level::PaintHUD()
+{
+	HUDLayer::Values values;
+	values.m_Lives = m_PlayerPtr->GetLives();
+	values.m_DragonCoins = m_PlayerPtr->GetDragonCoinsCollected();
+	values.m_RedStars = m_PlayerPtr->GetRedStarsCollected();
+	values.m_TimeRemaining = m_TimeRemaining;
+	values.m_Coins = m_PlayerPtr->GetCoinsCollected();
+	values.m_Score = m_PlayerPtr->GetScore();
+
+	m_HUDLayer.Paint(values);
 }
 
 bool Level::ActorCanPassThroughPlatform(PhysicsActor *actPlatformPtr, DOUBLE2& actorPosRef, double actorWidth, double actorHeight)
@@ -524,716 +659,744 @@ void Level::CollidePlayerWithBlock(DOUBLE2 blockCenterPos, DOUBLE2 playerFeet, b
 	}
 }
 
-void Level::PreSolve(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+void Level::InitializeContactRules()
 {
-	const DOUBLE2 playerFeet(m_PlayerPtr->GetPosition().x, m_PlayerPtr->GetPosition().y + m_PlayerPtr->GetHeight() / 2);
+	m_ContactRulesArr.resize(NUM_CONTACT_KINDS * NUM_CONTACT_KINDS);
+
+	const int player = int(ActorId::PLAYER);
+	const int platform = int(ActorId::PLATFORM);
+	const int pipe = int(ActorId::PIPE);
+	const int yoshi = int(ActorId::YOSHI);
+	const int yoshiTongue = int(ActorId::YOSHI_TOUNGE);
+	const int shell = GetItemContactKind(int(Item::Type::KOOPA_SHELL));
+	const int grabBlock = GetItemContactKind(int(Item::Type::GRAB_BLOCK));
+	const int chuck = GetEnemyContactKind(int(Enemy::Type::CHARGIN_CHUCK));
+	const int montyMole = GetEnemyContactKind(int(Enemy::Type::MONTY_MOLE));
+
+	// NOTE: Later rules overwrite earlier rules for the same pair
+
+	// PRE SOLVE
+	GetContactRules(player, platform).m_PreSolve = &Level::PreSolvePlayerPlatform;
+	GetContactRules(player, int(ActorId::LEVEL)).m_PreSolve = &Level::PreSolvePlayerLevel;
+	GetContactRules(player, pipe).m_PreSolve = &Level::PreSolvePlayerPipe;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::PRIZE_BLOCK))).m_PreSolve = &Level::PreSolvePlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::MESSAGE_BLOCK))).m_PreSolve = &Level::PreSolvePlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::EXCLAMATION_MARK_BLOCK))).m_PreSolve = &Level::PreSolvePlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::CLOUD_BLOCK))).m_PreSolve = &Level::PreSolvePlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::ROTATING_BLOCK))).m_PreSolve = &Level::PreSolvePlayerRotatingBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::COIN))).m_PreSolve = &Level::PreSolvePlayerCoin;
+	GetContactRules(player, shell).m_PreSolve = &Level::DisableContact;
+	GetContactRules(player, grabBlock).m_PreSolve = &Level::PreSolvePlayerGrabBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::P_SWITCH))).m_PreSolve = &Level::PreSolvePlayerPSwitch;
+	GetContactRules(player, yoshi).m_PreSolve = &Level::PreSolvePlayerYoshi;
+	for (int enemyKind = FIRST_ENEMY_CONTACT_KIND; enemyKind < NUM_CONTACT_KINDS; ++enemyKind)
+	{
+		GetContactRules(player, enemyKind).m_PreSolve = &Level::PreSolvePlayerEnemy;
+	}
 
-	switch (actOtherPtr->GetUserData())
+	for (int thisKind = 0; thisKind < NUM_CONTACT_KINDS; ++thisKind)
 	{
-	case int(ActorId::PLAYER):
+		GetContactRules(chuck, thisKind).m_PreSolve = &Level::PreSolveCharginChuck;
+	}
+	for (int enemyKind = FIRST_ENEMY_CONTACT_KIND; enemyKind < NUM_CONTACT_KINDS; ++enemyKind)
 	{
-		if (m_PlayerPtr->IsDead())
-		{
-			break;
-		}
+		GetContactRules(enemyKind, platform).m_PreSolve = &Level::PreSolveEnemyPlatform;
+	}
+	GetContactRules(chuck, platform).m_PreSolve = &Level::PreSolveCharginChuckPlatform;
+	GetContactRules(montyMole, montyMole).m_PreSolve = &Level::DisableContact;
 
-		const bool playerIsRising = m_PlayerPtr->GetLinearVelocity().y < -0.001;
+	GetContactRules(GetItemContactKind(int(Item::Type::P_SWITCH)), GetItemContactKind(int(Item::Type::ROTATING_BLOCK))).m_PreSolve = &Level::PreSolvePSwitchRotatingBlock;
 
-		switch (actThisPtr->GetUserData())
-		{
-		case int(ActorId::PLATFORM):
-		{
-			if (ActorCanPassThroughPlatform(actThisPtr, m_PlayerPtr->GetPosition(), m_PlayerPtr->GetWidth(), m_PlayerPtr->GetHeight()))
-			{
-				enableContactRef = false;
-			}
-		} break;
-		case int(ActorId::LEVEL):
-		{
-			if (playerIsRising)
-			{
-				m_PlayerPtr->SetLinearVelocity(DOUBLE2(0, m_PlayerPtr->GetLinearVelocity().y));
-				enableContactRef = false;
-			}
-		} break;
-		case int(ActorId::PIPE):
-		{
-			if (playerIsRising && 
-				((Pipe*)actThisPtr->GetUserPointer())->GetOrientation() != Pipe::Orientation::DOWN)
-			{
-				m_PlayerPtr->SetLinearVelocity(DOUBLE2(0, m_PlayerPtr->GetLinearVelocity().y));
-				enableContactRef = false;
-			}
-		} break;
-		case int(ActorId::ITEM):
-		{
-			Item* itemPtr = (Item*)actThisPtr->GetUserPointer();
-			switch (itemPtr->GetType())
-			{
-			case Item::Type::PRIZE_BLOCK:
-			case Item::Type::MESSAGE_BLOCK:
-			case Item::Type::EXCLAMATION_MARK_BLOCK:
-			case Item::Type::CLOUD_BLOCK:
-			{
-				CollidePlayerWithBlock(itemPtr->GetPosition(), playerFeet, enableContactRef);
-			} break;
-			case Item::Type::ROTATING_BLOCK:
-			{
-				if (((RotatingBlock*)itemPtr)->IsRotating())
-				{
-					enableContactRef = false;
-					return;
-				}
-				else
-				{
-					CollidePlayerWithBlock(itemPtr->GetPosition(), playerFeet, enableContactRef);
-				}
-			} break;
-			case Item::Type::KOOPA_SHELL:
-			{
-				enableContactRef = false;
-			} break;
-			case Item::Type::GRAB_BLOCK:
-			{
-				const bool grabBlockIsBeingHeld = m_PlayerPtr->GetHeldItemPtr() == itemPtr;
-				if (grabBlockIsBeingHeld) enableContactRef = false;
-			} break;
-			case Item::Type::COIN:
-			{
-				if (((Coin*)itemPtr)->IsBlock())
-				{
-					CollidePlayerWithBlock(itemPtr->GetPosition(), playerFeet, enableContactRef);
-				}
-			} break;
-			case Item::Type::P_SWITCH:
-			{
-				if (playerFeet.y > actThisPtr->GetPosition().y) enableContactRef = false;
-			} break;
-			}
-		} break;
-		case int(ActorId::YOSHI):
-		{
-			if (m_PlayerPtr->IsRidingYoshi() ||
-				m_YoshiPtr->IsHatching() || 
-				m_PlayerPtr->IsAirborne() == false || // On the ground
-				(m_PlayerPtr->IsAirborne() && m_PlayerPtr->GetLinearVelocity().y <= 0)) // Going upwards
-			{
-				enableContactRef = false;
-			}
-		} break;
-		case int(ActorId::ENEMY):
-		{
-			if (m_PlayerPtr->IsInvincible()) enableContactRef = false;
-		} break;
-		}
-	} break;
-	case int(ActorId::ENEMY):
+	for (int thisKind = 0; thisKind < NUM_CONTACT_KINDS; ++thisKind)
 	{
-		Enemy* enemyPtr = (Enemy*)actOtherPtr->GetUserPointer();
-
-		// Fixes chargin chuck's jumping:
-		if (enemyPtr->GetType() == Enemy::Type::CHARGIN_CHUCK)
-		{
-			CharginChuck* charginChuckPtr = (CharginChuck*)enemyPtr;
-			if (charginChuckPtr->GetAnimationState() == CharginChuck::AnimationState::JUMPING)
-			{
-				enableContactRef = false;
-			}
-		}
+		if (thisKind >= FIRST_ENEMY_CONTACT_KIND) GetContactRules(shell, thisKind).m_PreSolve = &Level::PreSolveShellEnemy;
+		else GetContactRules(shell, thisKind).m_PreSolve = &Level::PreSolveShell;
+	}
+	GetContactRules(shell, player).m_PreSolve = &Level::PreSolveShellPlayer;
+	GetContactRules(shell, yoshi).m_PreSolve = &Level::DisableContact;
+	GetContactRules(platform, shell).m_PreSolve = &Level::PreSolvePlatformShell;
 
-		switch (actThisPtr->GetUserData())
-		{
-		case int(ActorId::PLATFORM):
-		{
-			double enemyWidth = enemyPtr->GetWidth();
-			double enemyHeight = enemyPtr->GetHeight();
-			if (ActorCanPassThroughPlatform(actThisPtr, enemyPtr->GetPosition(), enemyWidth, enemyHeight))
-			{
-				enableContactRef = false;
-			}
-		} break;
-		case int(ActorId::ENEMY):
-		{
-			Enemy* thisEnemyPtr = (Enemy*)actThisPtr->GetUserPointer();
-			if (enemyPtr->GetType() == Enemy::Type::MONTY_MOLE &&
-				thisEnemyPtr->GetType() == Enemy::Type::MONTY_MOLE)
-			{
-				enableContactRef = false;
-			}
-		} break;
-		}
-	} break;
-	case int(ActorId::ITEM):
+	// BEGIN CONTACT
+	GetContactRules(player, GetItemContactKind(int(Item::Type::COIN))).m_BeginContact = &Level::BeginPlayerCoin;
+	const Item::Type pickupTypesArr[] = 
 	{
-		Item* otherItemPtr = (Item*)actOtherPtr->GetUserPointer();
-		switch (otherItemPtr->GetType())
-		{
-		case Item::Type::P_SWITCH:
-		{
-			if (actThisPtr->GetUserData() == int(ActorId::ITEM))
-			{
-				Item* thisItemPtr = (Item*)actThisPtr->GetUserPointer();
-				if (thisItemPtr->GetType() == Item::Type::ROTATING_BLOCK)
-				{
-					// NOTE: Only let p-switches fall through if the rotating block is spinning
-					if (((RotatingBlock*)thisItemPtr)->IsRotating())
-					{
-						enableContactRef = false;
-					}
-				}
-			}
-		} break;
-		case Item::Type::KOOPA_SHELL:
-		{
-			KoopaShell* koopaShellPtr = (KoopaShell*)otherItemPtr;
-			// When the player is holding a shell, it doesn't collide with anything except enemies
-			const bool shellIsBeingHeld = m_PlayerPtr->GetHeldItemPtr() == koopaShellPtr;
-			const bool shellIsMovingUpwards = actOtherPtr->GetLinearVelocity().y < 0.0;
-			const bool shellIsHittingYoshi = actThisPtr->GetUserData() == int(ActorId::YOSHI);
-			const bool shellIsHittingYoshiWithPlayer = actThisPtr->GetUserData() == int(ActorId::PLAYER) &&
-														m_PlayerPtr->IsRidingYoshi();
-
-			if ((actThisPtr->GetUserData() != int(ActorId::ENEMY) && shellIsBeingHeld) ||
-				shellIsMovingUpwards || 
-				shellIsHittingYoshi || 
-				shellIsHittingYoshiWithPlayer)
-			{
-				enableContactRef = false;
-			}
-		} break;
-		}
-	} break;
-	case int(ActorId::PLATFORM):
+		Item::Type::DRAGON_COIN, Item::Type::SUPER_MUSHROOM, Item::Type::STAR, Item::Type::FIRE_FLOWER,
+		Item::Type::CAPE_FEATHER, Item::Type::POWER_BALLOON, Item::Type::ONE_UP_MUSHROOM, Item::Type::THREE_UP_MOON
+	};
+	for (Item::Type pickupType : pickupTypesArr)
 	{
-		if (actThisPtr->GetUserData() == int(ActorId::ITEM))
-		{
-			Item* itemPtr = (Item*)actThisPtr->GetUserPointer();
-			if (itemPtr->GetType() == Item::Type::KOOPA_SHELL)
-			{
-				if (ActorCanPassThroughPlatform(actOtherPtr, actThisPtr->GetPosition(), Item::TILE_SIZE, Item::TILE_SIZE))
-				{
-					enableContactRef = false;
-				}
-			}
-		}
-	} break;
+		GetContactRules(player, GetItemContactKind(int(pickupType))).m_BeginContact = &Level::BeginPlayerPickup;
 	}
-}
-
-void Level::BeginContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
-{
-	switch (actOtherPtr->GetUserData())
+	GetContactRules(player, GetItemContactKind(int(Item::Type::PRIZE_BLOCK))).m_BeginContact = &Level::BeginPlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::EXCLAMATION_MARK_BLOCK))).m_BeginContact = &Level::BeginPlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::MESSAGE_BLOCK))).m_BeginContact = &Level::BeginPlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::CLOUD_BLOCK))).m_BeginContact = &Level::BeginPlayerBlock;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::ROTATING_BLOCK))).m_BeginContact = &Level::BeginPlayerRotatingBlock;
+	GetContactRules(player, grabBlock).m_BeginContact = &Level::BeginPlayerGrabBlock;
+	GetContactRules(player, shell).m_BeginContact = &Level::BeginPlayerShell;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::BEANSTALK))).m_BeginContact = &Level::BeginPlayerBeanstalk;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::MIDWAY_GATE))).m_BeginContact = &Level::BeginPlayerMidwayGate;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::GOAL_GATE))).m_BeginContact = &Level::BeginPlayerGoalGate;
+	GetContactRules(player, GetItemContactKind(int(Item::Type::P_SWITCH))).m_BeginContact = &Level::BeginPlayerPSwitch;
+	GetContactRules(player, pipe).m_BeginContact = &Level::BeginPlayerPipe;
+	GetContactRules(player, GetEnemyContactKind(int(Enemy::Type::KOOPA_TROOPA))).m_BeginContact = &Level::BeginPlayerKoopaTroopa;
+	GetContactRules(player, montyMole).m_BeginContact = &Level::BeginPlayerMontyMole;
+	GetContactRules(player, GetEnemyContactKind(int(Enemy::Type::PIRHANA_PLANT))).m_BeginContact = &Level::BeginPlayerPirhanaPlant;
+	GetContactRules(player, chuck).m_BeginContact = &Level::BeginPlayerCharginChuck;
+	GetContactRules(player, yoshi).m_BeginContact = &Level::BeginPlayerYoshi;
+
+	const Item::Type blockTypesArr[] = 
 	{
-	case int(ActorId::PLAYER):
+		Item::Type::PRIZE_BLOCK, Item::Type::MESSAGE_BLOCK, Item::Type::ROTATING_BLOCK, Item::Type::EXCLAMATION_MARK_BLOCK,
+		Item::Type::CLOUD_BLOCK, Item::Type::GRAB_BLOCK, Item::Type::COIN // NOTE: Coins are only blocks while a p-switch is active
+	};
+	for (Item::Type blockType : blockTypesArr)
 	{
-		if (m_PlayerPtr->IsDead())
-		{
-			break;
-		}
+		GetContactRules(shell, GetItemContactKind(int(blockType))).m_BeginContact = &Level::BeginShellBlock;
+	}
+	GetContactRules(shell, shell).m_BeginContact = &Level::BeginShellShell;
+	GetContactRules(shell, GetEnemyContactKind(int(Enemy::Type::KOOPA_TROOPA))).m_BeginContact = &Level::BeginShellKoopaTroopa;
+	GetContactRules(shell, player).m_BeginContact = &Level::BeginShellPlayer;
 
-		const bool playerIsRising = actOtherPtr->GetLinearVelocity().y < -0.001;
-		const DOUBLE2 playerFeet = DOUBLE2(actOtherPtr->GetPosition().x, actOtherPtr->GetPosition().y + ((Player*)actOtherPtr)->GetHeight() / 2);
+	for (int thisKind = 0; thisKind < NUM_CONTACT_KINDS; ++thisKind)
+	{
+		const bool thisIsItem = thisKind >= FIRST_ITEM_CONTACT_KIND && thisKind < FIRST_ENEMY_CONTACT_KIND;
+		if (thisIsItem == false) GetContactRules(grabBlock, thisKind).m_BeginContact = &Level::BeginGrabBlock;
+	}
+	GetContactRules(grabBlock, GetItemContactKind(int(Item::Type::PRIZE_BLOCK))).m_BeginContact = &Level::BeginGrabBlockPrizeBlock;
 
-		switch (actThisPtr->GetUserData())
-		{
-		case int(ActorId::ITEM):
-		{
-			Item* itemPtr = (Item*)actThisPtr->GetUserPointer();
-			switch (itemPtr->GetType())
-			{
-			case Item::Type::COIN:
-			{
-				if (((Coin*)itemPtr)->IsBlock())
-				{
-					break;
-				}
-			} // NOTE: No break here! Let it fallthrough
-			case Item::Type::DRAGON_COIN:
-			case Item::Type::SUPER_MUSHROOM:
-			case Item::Type::STAR:
-			case Item::Type::FIRE_FLOWER:
-			case Item::Type::CAPE_FEATHER:
-			case Item::Type::POWER_BALLOON:
-			case Item::Type::ONE_UP_MUSHROOM:
-			case Item::Type::THREE_UP_MOON:
-			{
-				m_PlayerPtr->OnItemPickup(itemPtr);
-				m_ItemsToBeRemovedPtrArr.push_back(itemPtr);
-			} break;
-			case Item::Type::PRIZE_BLOCK:
-			case Item::Type::EXCLAMATION_MARK_BLOCK:
-			case Item::Type::MESSAGE_BLOCK:
-			case Item::Type::CLOUD_BLOCK:
-			{
-				const bool playerCenterIsBelowBlock = m_PlayerPtr->GetPosition().y > (actThisPtr->GetPosition().y + Block::HEIGHT / 2);
-				const bool playerCenterIsAboveBlock = m_PlayerPtr->GetPosition().y < (actThisPtr->GetPosition().y - Block::HEIGHT / 2);
-
-				if (playerIsRising && playerCenterIsBelowBlock)
-				{
-					((Block*)itemPtr)->Hit();
-
-					// NOTE: This line prevents the player from slowly floating down after hitting a block
-					m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, 0.0));
-				}
-			} break;
-			case Item::Type::ROTATING_BLOCK:
-			{
-				RotatingBlock* rotatingBlockPtr = (RotatingBlock*)itemPtr;
-				if (rotatingBlockPtr->IsRotating()) break;
+	for (int enemyKind = FIRST_ENEMY_CONTACT_KIND; enemyKind < NUM_CONTACT_KINDS; ++enemyKind)
+	{
+		GetContactRules(GetItemContactKind(int(Item::Type::FIREBALL)), enemyKind).m_BeginContact = &Level::BeginFireballEnemy;
+		GetContactRules(yoshiTongue, enemyKind).m_BeginContact = &Level::BeginTongueEnemy;
+	}
+	for (int itemKind = FIRST_ITEM_CONTACT_KIND; itemKind < FIRST_ENEMY_CONTACT_KIND; ++itemKind)
+	{
+		GetContactRules(yoshiTongue, itemKind).m_BeginContact = &Level::BeginTongueItem;
+	}
 
-				const bool playerCenterIsBelowBlock = m_PlayerPtr->GetPosition().y > (rotatingBlockPtr->GetPosition().y + Block::HEIGHT / 2);
-				const bool playerCenterIsAboveBlock = m_PlayerPtr->GetPosition().y < (rotatingBlockPtr->GetPosition().y - Block::HEIGHT / 2);
+	// END CONTACT
+	GetContactRules(player, GetItemContactKind(int(Item::Type::BEANSTALK))).m_EndContact = &Level::EndPlayerBeanstalk;
+	GetContactRules(player, grabBlock).m_EndContact = &Level::EndPlayerGrabBlock;
+	GetContactRules(player, pipe).m_EndContact = &Level::EndPlayerPipe;
+}
 
-				if (playerIsRising && playerCenterIsBelowBlock)
-				{
-					rotatingBlockPtr->Hit();
+Level::ContactRules& Level::GetContactRules(int otherKind, int thisKind)
+{
+	return m_ContactRulesArr[otherKind * NUM_CONTACT_KINDS + thisKind];
+}
 
-					// NOTE: This line prevents the player from slowly floating down after hitting a block
-					m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, 0.0));
-				}
-			} break;
-			case Item::Type::GRAB_BLOCK:
-			{
-				GrabBlock* grabBlockPtr = (GrabBlock*)itemPtr;
-				if (grabBlockPtr->IsFlashing())
-				{
-					const DOUBLE2 grabBlockVel(300 * m_PlayerPtr->GetDirectionFacing(), 0);
-					grabBlockPtr->SetMoving(grabBlockVel);
-				}
-				else
-				{
-					m_PlayerPtr->SetTouchingGrabBlock(true, grabBlockPtr);
-				}
-			} break;
-			case Item::Type::KOOPA_SHELL:
-			{
-				KoopaShell* koopaShellPtr = (KoopaShell*)itemPtr;
-				if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
-				{
-					koopaShellPtr->Stomp();
-				}
-				else if (koopaShellPtr->IsMoving())
-				{
-					if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::FALLING)
-					{
-						koopaShellPtr->SetMoving(false);
-						m_PlayerPtr->Bounce(false);
-					}
-					else
-					{
-						m_PlayerPtr->TakeDamage();
-					}
-				}
-				else if (m_PlayerPtr->IsRunButtonHeldDown() && m_PlayerPtr->IsHoldingItem() == false)
-				{
-					if (koopaShellPtr->IsFallingOffScreen() == false)
-					{
-						koopaShellPtr->SetMoving(false);
-						m_PlayerPtr->AddItemToBeHeld(itemPtr);
-					}
-				}
-				else
-				{
-					bool wasThrown = m_PlayerPtr->GetHeldItemPtr() != nullptr;
-					m_PlayerPtr->KickShell(koopaShellPtr, wasThrown);
-				}
-			} break;
-			case Item::Type::BEANSTALK:
-			{
-				m_PlayerPtr->SetOverlappingWithBeanstalk(true);
-			} break;
-			case Item::Type::MIDWAY_GATE:
-			{
-				MidwayGate* midwayGatePtr = (MidwayGate*)itemPtr;
-				if (midwayGatePtr->IsHit() == false)
-				{
-					m_PlayerPtr->MidwayGatePasshrough();
-					midwayGatePtr->Hit();
-					m_IsCheckpointCleared = true;
-				}
-			} break;
-			case Item::Type::GOAL_GATE:
-			{
-				GoalGate* goalGatePtr = (GoalGate*)itemPtr;
-				if (goalGatePtr->IsHit() == false)
-				{
-					goalGatePtr->Hit();
-				}
-			} break;
-			case Item::Type::P_SWITCH:
-			{
-				PSwitch* pSwitchPtr = (PSwitch*)itemPtr;
-
-				if (m_PlayerPtr->IsRunButtonHeldDown() && m_PlayerPtr->IsHoldingItem() == false)
-				{
-					m_PlayerPtr->AddItemToBeHeld(pSwitchPtr);
-				}
-				else
-				{
-					if (m_PlayerPtr->GetLinearVelocity().y > 0)
-					{
-						pSwitchPtr->Hit();
-						TurnCoinsToBlocks(true);
-					}
-				}
-			} break;
-			}
-		} break;
-		case int(ActorId::PIPE):
-		{
-			m_PlayerPtr->SetTouchingPipe(true, (Pipe*)actThisPtr->GetUserPointer());
-		} break;
-		case int(ActorId::ENEMY):
-		{
-			Enemy* enemyPtr = (Enemy*)actThisPtr->GetUserPointer();
-			const DOUBLE2 enemyFeet = enemyPtr->GetPosition() + DOUBLE2(0, enemyPtr->GetHeight() / 2);
-			switch (enemyPtr->GetType())
-			{
-			case Enemy::Type::KOOPA_TROOPA:
-			{
-				KoopaTroopa* koopaTroopaPtr = (KoopaTroopa*)enemyPtr;
-				if (playerFeet.y < koopaTroopaPtr->GetPosition().y)
-				{
-					if (m_PlayerPtr->IsHoldingItem() == false &&
-						m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
-					{
-						koopaTroopaPtr->StompKill();
-						m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, -58));
-					}
-					else
-					{
-						koopaTroopaPtr->HeadBonk();
-						m_PlayerPtr->Bounce(false);
-					}
-				}
-				else
-				{
-					// NOTE: If the koopa is shelless (aka laying helplessly and crying on the ground) then
-					// all the player needs to do is touch them and they die
-					// Once the shelless koopa starts walking (ANIMATION_STATE::WALKING_SHELLESS) then the player
-					// needs to jump on their head, the player will die if they touch the side of a walking shelless koopa
-					if (koopaTroopaPtr->GetAnimationState() == KoopaTroopa::AnimationState::SHELLESS)
-					{
-						koopaTroopaPtr->ShellHit();
-					}
-					else
-					{
-						m_PlayerPtr->TakeDamage();
-					}
-				}
-			} break;
-			case Enemy::Type::MONTY_MOLE:
-			{
-				MontyMole* montyMolePtr = (MontyMole*)enemyPtr;
-				if (montyMolePtr->IsAlive())
-				{
-					if (playerFeet.y < montyMolePtr->GetPosition().y)
-					{
-						if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
-						{
-							montyMolePtr->StompKill();
-							m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, 0));
-						}
-						else
-						{
-							montyMolePtr->HeadBonk();
-							m_PlayerPtr->Bounce(false);
-						}
-					}
-					else
-					{
-						m_PlayerPtr->TakeDamage();
-					}
-				}
-			} break;
-			case Enemy::Type::PIRHANA_PLANT:
-			{
-				m_PlayerPtr->TakeDamage();
-			} break;
-			case Enemy::Type::CHARGIN_CHUCK:
-			{
-				CharginChuck* charginChuckPtr = (CharginChuck*)enemyPtr;
-				if (charginChuckPtr->GetAnimationState() != CharginChuck::AnimationState::DEAD &&
-					m_PlayerPtr->IsAirborne())
-				{
-					charginChuckPtr->HeadBonk();
-					const int horizontalDir = playerFeet.x < charginChuckPtr->GetPosition().x ? -1 : 1;
-					m_PlayerPtr->Bounce(true, horizontalDir);
-				}
-				else
-				{
-					m_PlayerPtr->TakeDamage();
-				}
-			} break;
-			}
-		} break;
-		case int(ActorId::YOSHI):
-		{
-			assert(m_YoshiPtr != nullptr);
-			if (m_YoshiPtr->IsHatching() == false && 
-				m_PlayerPtr->IsRidingYoshi() == false && 
-				m_PlayerPtr->IsHoldingItem() == false &&
-				(m_PlayerPtr->IsAirborne() && m_PlayerPtr->GetLinearVelocity().y >= 0))
-			{
-				m_PlayerPtr->RideYoshi(m_YoshiPtr);
-			}
-		} break;
-		}
-	} break;
-	case int(ActorId::ITEM):
+int Level::GetContactKind(PhysicsActor* actPtr)
+{
+	const int actorId = actPtr->GetUserData();
+	if (actorId == int(ActorId::ITEM))
 	{
-		Item* otherItemPtr = (Item*)actOtherPtr->GetUserPointer();
-		switch (otherItemPtr->GetType())
-		{
-		case Item::Type::KOOPA_SHELL:
-		{
-			KoopaShell* otherKoopaShellPtr = (KoopaShell*)otherItemPtr;
-			switch (actThisPtr->GetUserData())
-			{
-			case int(ActorId::ITEM):
-			{
-				Item* thisItemPtr = (Item*)actThisPtr->GetUserPointer();
-				if (thisItemPtr->IsBlock() && m_PlayerPtr->GetHeldItemPtr() != otherKoopaShellPtr)
-				{
-					Block* blockPtr = (Block*)thisItemPtr;
-					DOUBLE2 koopaShellPos = otherKoopaShellPtr->GetPosition();
-					DOUBLE2 blockPos = blockPtr->GetPosition();
-					bool shellBelowBlock = koopaShellPos.y > blockPos.y;
-					bool shellBesideBlock = koopaShellPos.x + KoopaShell::WIDTH / 2 <= blockPos.x - Block::WIDTH / 2 ||
-						koopaShellPos.x - KoopaShell::WIDTH / 2 >= blockPos.x + Block::WIDTH / 2;
-
-					if (shellBelowBlock || shellBesideBlock)
-					{
-						DOUBLE2 koopaShellVel = actOtherPtr->GetLinearVelocity();
-						otherKoopaShellPtr->SetLinearVelocity(DOUBLE2(-koopaShellVel.x, koopaShellVel.y));
-						// When a shell hits a block it "hits" it as if the player hit it with their head
-						blockPtr->Hit();
-					}
-				}
-				else if (thisItemPtr->GetType() == Item::Type::KOOPA_SHELL)
-				{
-					KoopaShell* thisKoopaShellPtr = (KoopaShell*)thisItemPtr;
-					if (m_PlayerPtr->GetHeldItemPtr() == otherKoopaShellPtr)
-					{
-						m_PlayerPtr->DropHeldItem();
-						thisKoopaShellPtr->ShellHit(m_PlayerPtr->GetDirectionFacing());
-						m_PlayerPtr->AddScore(1000, false, thisKoopaShellPtr->GetPosition());
-					}
-					else if (!otherKoopaShellPtr->IsMoving())
-					{
-						otherKoopaShellPtr->ShellHit();
-					}
-				}
-			} break;
-			case int(ActorId::ENEMY):
-			{
-				Enemy* enemyPtr = (Enemy*)actThisPtr->GetUserPointer();
-				switch (enemyPtr->GetType())
-				{
-				case Enemy::Type::KOOPA_TROOPA:
-				{
-					if (m_PlayerPtr->GetHeldItemPtr() == otherKoopaShellPtr)
-					{
-						m_PlayerPtr->DropHeldItem();
-						((KoopaTroopa*)enemyPtr)->ShellHit(true);
-					}
-					else if (otherKoopaShellPtr->IsMoving() || otherKoopaShellPtr->IsBouncing())
-					{
-						((KoopaTroopa*)enemyPtr)->ShellHit();
-					}
-				} break;
-				}
-			} break;
-			case int(ActorId::PLAYER):
-			{
-				if (m_PlayerPtr->IsRidingYoshi())
-				{
-					m_PlayerPtr->DismountYoshi(true);
-				}
-			} break;
-			}
-		} break;
-		case Item::Type::GRAB_BLOCK:
-		{
-			GrabBlock* grabBlockPtr = (GrabBlock*)otherItemPtr;
-			if (actThisPtr->GetUserData() == int(ActorId::ITEM)) 
-			{
-				Item* thisItemPtr = (Item*)actThisPtr->GetUserPointer();
-				if (thisItemPtr->GetType() == Item::Type::PRIZE_BLOCK)
-				{
-					PrizeBlock* prizeBlockPtr = (PrizeBlock*)thisItemPtr;
-					if (prizeBlockPtr->IsFlying())
-					{
-						prizeBlockPtr->Hit();
-					}
-				}
-			}
-			else 
-			{
-				const int grabBlockDir = actOtherPtr->GetLinearVelocity().x > 0 ? Direction::RIGHT : Direction::LEFT;
-				const DOUBLE2 point1 = grabBlockPtr->GetPosition();
-				const DOUBLE2 point2 = grabBlockPtr->GetPosition() + DOUBLE2((Block::WIDTH / 2 + 3) * grabBlockDir, 0);
-				DOUBLE2 intersection, normal;
-				double fraction = -1.0;
-				int collisionBits = Level::LEVEL | Level::BLOCK;
-
-				if (Raycast(point1, point2, collisionBits, intersection, normal, fraction))
-				{
-					// Explode when hitting things head on
-					grabBlockPtr->Explode();
-				}
-			}
-		} break;
-		case Item::Type::FIREBALL:
-		{
-			if (actThisPtr->GetUserData() == int(ActorId::ENEMY))
-			{
-				Enemy* enemyPtr = (Enemy*)actThisPtr->GetUserPointer();
-				m_EnemiesToBeRemovedPtrArr.push_back(enemyPtr);
-				SoundManager::PlaySoundEffect(SoundManager::Sound::SHELL_KICK);
-				m_PlayerPtr->AddScore(200, false, enemyPtr->GetPosition() + DOUBLE2(0, -10));
-			}
-		} break;
-		}
-	} break;
-	case int(ActorId::YOSHI_TOUNGE):
+		return GetItemContactKind(int(((Item*)actPtr->GetUserPointer())->GetType()));
+	}
+	else if (actorId == int(ActorId::ENEMY))
 	{
-		switch (actThisPtr->GetUserData())
-		{
-		case int(ActorId::ENEMY):
-		{
-			if (m_PlayerPtr->IsRidingYoshi() &&
-				m_YoshiPtr->IsTongueStuckOut() == false) 
-			{
-				m_PlayerPtr->TakeDamage();
-			}
-			else
-			{
-				Enemy* enemyPtr = (Enemy*)actThisPtr->GetUserPointer();
-				m_YoshiPtr->TongueTouchedEnemy(enemyPtr);
-			}
-		} break;
-		case int(ActorId::ITEM):
-		{
-			Item* itemPtr = (Item*)actThisPtr->GetUserPointer();
-			m_YoshiPtr->TongueTouchedItem(itemPtr);
-		} break;
-		}
-	} break;
+		return GetEnemyContactKind(int(((Enemy*)actPtr->GetUserPointer())->GetType()));
 	}
+	return actorId;
 }
 
-void Level::EndContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+int Level::GetItemContactKind(int itemType)
 {
-	if (actOtherPtr->GetUserData() == int(ActorId::PLAYER))
-	{
-		switch (actThisPtr->GetUserData())
-		{
-		case int(ActorId::ITEM):
-		{
-			Item* otherItemPtr = (Item*)actThisPtr->GetUserPointer();
-			switch (otherItemPtr->GetType())
-			{
-			case Item::Type::BEANSTALK:
-			{
-				m_PlayerPtr->SetOverlappingWithBeanstalk(false);
-			} break;
-			case Item::Type::GRAB_BLOCK:
-			{
-				m_PlayerPtr->SetTouchingGrabBlock(false, (GrabBlock*)otherItemPtr);
-			} break;
-			}
-		} break;
-		case int(ActorId::PIPE):
-		{
-			m_PlayerPtr->SetTouchingPipe(false);
-		} break;
-		}
-	}
+	return FIRST_ITEM_CONTACT_KIND + itemType;
 }
 
-bool Level::Raycast(DOUBLE2 point1, DOUBLE2 point2, int collisionBits, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef)
+int Level::GetEnemyContactKind(int enemyType)
 {
-	if (collisionBits & LEVEL)
-	{
-		if (m_ActLevelPtr->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
-		{
-			return true;
-		}
+	return FIRST_ENEMY_CONTACT_KIND + enemyType;
+}
 
-		std::vector<Pipe*> pipesPtrArr = m_LevelDataPtr->GetPipes();
-		for (size_t i = 0; i < pipesPtrArr.size(); ++i)
-		{
-			if (pipesPtrArr[i]->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
-			{
-				return true;
-			}
-		}
+DOUBLE2 Level::GetPlayerFeet() const
+{
+	return DOUBLE2(m_PlayerPtr->GetPosition().x, m_PlayerPtr->GetPosition().y + m_PlayerPtr->GetHeight() / 2);
+}
 
-		std::vector<Platform*> platformsPtrArr = m_LevelDataPtr->GetPlatforms();
-		for (size_t i = 0; i < platformsPtrArr.size(); ++i)
-		{
-			if (platformsPtrArr[i]->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
-			{
-				return true;
-			}
+bool Level::IsPlayerRising() const
+{
+	return m_PlayerPtr->GetLinearVelocity().y < -0.001;
+}
+
+void Level::PreSolve(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	const int otherKind = GetContactKind(actOtherPtr);
+	const PreSolveRule rule = GetContactRules(otherKind, GetContactKind(actThisPtr)).m_PreSolve;
+	if (rule == nullptr) return;
+	if (otherKind == int(ActorId::PLAYER) && m_PlayerPtr->IsDead()) return;
+
+	(this->*rule)(actThisPtr, actOtherPtr, enableContactRef);
+}
+
+void Level::BeginContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	const int otherKind = GetContactKind(actOtherPtr);
+	const ContactRule rule = GetContactRules(otherKind, GetContactKind(actThisPtr)).m_BeginContact;
+	if (rule == nullptr) return;
+	if (otherKind == int(ActorId::PLAYER) && m_PlayerPtr->IsDead()) return;
+
+	(this->*rule)(actThisPtr, actOtherPtr);
+}
+
+void Level::EndContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	const ContactRule rule = GetContactRules(GetContactKind(actOtherPtr), GetContactKind(actThisPtr)).m_EndContact;
+	if (rule == nullptr) return;
+
+	(this->*rule)(actThisPtr, actOtherPtr);
+}
+
+void Level::DisableContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	enableContactRef = false;
+}
+
+void Level::PreSolvePlayerPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (ActorCanPassThroughPlatform(actThisPtr, m_PlayerPtr->GetPosition(), m_PlayerPtr->GetWidth(), m_PlayerPtr->GetHeight()))
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolvePlayerLevel(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (IsPlayerRising())
+	{
+		m_PlayerPtr->SetLinearVelocity(DOUBLE2(0, m_PlayerPtr->GetLinearVelocity().y));
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolvePlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (IsPlayerRising() && 
+		((Pipe*)actThisPtr->GetUserPointer())->GetOrientation() != Pipe::Orientation::DOWN)
+	{
+		m_PlayerPtr->SetLinearVelocity(DOUBLE2(0, m_PlayerPtr->GetLinearVelocity().y));
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolvePlayerBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	CollidePlayerWithBlock(actThisPtr->GetPosition(), GetPlayerFeet(), enableContactRef);
+}
+
+void Level::PreSolvePlayerRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (((RotatingBlock*)actThisPtr->GetUserPointer())->IsRotating())
+	{
+		enableContactRef = false;
+	}
+	else
+	{
+		CollidePlayerWithBlock(actThisPtr->GetPosition(), GetPlayerFeet(), enableContactRef);
+	}
+}
+
+void Level::PreSolvePlayerCoin(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (((Coin*)actThisPtr->GetUserPointer())->IsBlock())
+	{
+		CollidePlayerWithBlock(actThisPtr->GetPosition(), GetPlayerFeet(), enableContactRef);
+	}
+}
+
+void Level::PreSolvePlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	const bool grabBlockIsBeingHeld = m_PlayerPtr->GetHeldItemPtr() == (Item*)actThisPtr->GetUserPointer();
+	if (grabBlockIsBeingHeld) enableContactRef = false;
+}
+
+void Level::PreSolvePlayerPSwitch(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (GetPlayerFeet().y > actThisPtr->GetPosition().y) enableContactRef = false;
+}
+
+void Level::PreSolvePlayerYoshi(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (m_PlayerPtr->IsRidingYoshi() ||
+		m_YoshiPtr->IsHatching() || 
+		m_PlayerPtr->IsAirborne() == false || // On the ground
+		(m_PlayerPtr->IsAirborne() && m_PlayerPtr->GetLinearVelocity().y <= 0)) // Going upwards
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolvePlayerEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (m_PlayerPtr->IsInvincible()) enableContactRef = false;
+}
+
+void Level::PreSolveCharginChuck(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	// Fixes chargin chuck's jumping:
+	CharginChuck* charginChuckPtr = (CharginChuck*)actOtherPtr->GetUserPointer();
+	if (charginChuckPtr->GetAnimationState() == CharginChuck::AnimationState::JUMPING)
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolveEnemyPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	Enemy* enemyPtr = (Enemy*)actOtherPtr->GetUserPointer();
+	if (ActorCanPassThroughPlatform(actThisPtr, enemyPtr->GetPosition(), enemyPtr->GetWidth(), enemyPtr->GetHeight()))
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolveCharginChuckPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	PreSolveCharginChuck(actThisPtr, actOtherPtr, enableContactRef);
+	PreSolveEnemyPlatform(actThisPtr, actOtherPtr, enableContactRef);
+}
+
+void Level::PreSolvePSwitchRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	// NOTE: Only let p-switches fall through if the rotating block is spinning
+	if (((RotatingBlock*)actThisPtr->GetUserPointer())->IsRotating())
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::PreSolveShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	// When the player is holding a shell, it doesn't collide with anything except enemies
+	const bool shellIsBeingHeld = m_PlayerPtr->GetHeldItemPtr() == (Item*)actOtherPtr->GetUserPointer();
+	if (shellIsBeingHeld) enableContactRef = false;
+
+	PreSolveShellEnemy(actThisPtr, actOtherPtr, enableContactRef);
+}
+
+void Level::PreSolveShellEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	const bool shellIsMovingUpwards = actOtherPtr->GetLinearVelocity().y < 0.0;
+	if (shellIsMovingUpwards) enableContactRef = false;
+}
+
+void Level::PreSolveShellPlayer(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (m_PlayerPtr->IsRidingYoshi()) enableContactRef = false;
+
+	PreSolveShell(actThisPtr, actOtherPtr, enableContactRef);
+}
+
+void Level::PreSolvePlatformShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef)
+{
+	if (ActorCanPassThroughPlatform(actOtherPtr, actThisPtr->GetPosition(), Item::TILE_SIZE, Item::TILE_SIZE))
+	{
+		enableContactRef = false;
+	}
+}
+
+void Level::BeginPlayerCoin(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	if (((Coin*)actThisPtr->GetUserPointer())->IsBlock() == false)
+	{
+		BeginPlayerPickup(actThisPtr, actOtherPtr);
+	}
+}
+
+void Level::BeginPlayerPickup(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	Item* itemPtr = (Item*)actThisPtr->GetUserPointer();
+	m_PlayerPtr->OnItemPickup(itemPtr);
+	m_ItemsToBeRemovedPtrArr.push_back(itemPtr);
+}
+
+void Level::BeginPlayerBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	const bool playerCenterIsBelowBlock = m_PlayerPtr->GetPosition().y > (actThisPtr->GetPosition().y + Block::HEIGHT / 2);
+	if (IsPlayerRising() && playerCenterIsBelowBlock)
+	{
+		((Block*)actThisPtr->GetUserPointer())->Hit();
+
+		// NOTE: This line prevents the player from slowly floating down after hitting a block
+		m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, 0.0));
+	}
+}
+
+void Level::BeginPlayerRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	if (((RotatingBlock*)actThisPtr->GetUserPointer())->IsRotating()) return;
+
+	BeginPlayerBlock(actThisPtr, actOtherPtr);
+}
+
+void Level::BeginPlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	GrabBlock* grabBlockPtr = (GrabBlock*)actThisPtr->GetUserPointer();
+	if (grabBlockPtr->IsFlashing())
+	{
+		const DOUBLE2 grabBlockVel(300 * m_PlayerPtr->GetDirectionFacing(), 0);
+		grabBlockPtr->SetMoving(grabBlockVel);
+	}
+	else
+	{
+		m_PlayerPtr->SetTouchingGrabBlock(true, grabBlockPtr);
+	}
+}
+
+void Level::BeginPlayerShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	KoopaShell* koopaShellPtr = (KoopaShell*)actThisPtr->GetUserPointer();
+	if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
+	{
+		koopaShellPtr->Stomp();
+	}
+	else if (koopaShellPtr->IsMoving())
+	{
+		if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::FALLING)
+		{
+			koopaShellPtr->SetMoving(false);
+			m_PlayerPtr->Bounce(false);
+		}
+		else
+		{
+			m_PlayerPtr->TakeDamage();
+		}
+	}
+	else if (m_PlayerPtr->IsRunButtonHeldDown() && m_PlayerPtr->IsHoldingItem() == false)
+	{
+		if (koopaShellPtr->IsFallingOffScreen() == false)
+		{
+			koopaShellPtr->SetMoving(false);
+			m_PlayerPtr->AddItemToBeHeld(koopaShellPtr);
+		}
+	}
+	else
+	{
+		bool wasThrown = m_PlayerPtr->GetHeldItemPtr() != nullptr;
+		m_PlayerPtr->KickShell(koopaShellPtr, wasThrown);
+	}
+}
+
+void Level::BeginPlayerBeanstalk(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->SetOverlappingWithBeanstalk(true);
+}
+
+void Level::BeginPlayerMidwayGate(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	MidwayGate* midwayGatePtr = (MidwayGate*)actThisPtr->GetUserPointer();
+	if (midwayGatePtr->IsHit() == false)
+	{
+		m_PlayerPtr->MidwayGatePasshrough();
+		midwayGatePtr->Hit();
+		m_IsCheckpointCleared = true;
+	}
+}
+
+void Level::BeginPlayerGoalGate(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	GoalGate* goalGatePtr = (GoalGate*)actThisPtr->GetUserPointer();
+	if (goalGatePtr->IsHit() == false)
+	{
+		goalGatePtr->Hit();
+	}
+}
+
+void Level::BeginPlayerPSwitch(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	PSwitch* pSwitchPtr = (PSwitch*)actThisPtr->GetUserPointer();
+
+	if (m_PlayerPtr->IsRunButtonHeldDown() && m_PlayerPtr->IsHoldingItem() == false)
+	{
+		m_PlayerPtr->AddItemToBeHeld(pSwitchPtr);
+	}
+	else
+	{
+		if (m_PlayerPtr->GetLinearVelocity().y > 0)
+		{
+			pSwitchPtr->Hit();
+			TurnCoinsToBlocks(true);
 		}
 	}
+}
+
+void Level::BeginPlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->SetTouchingPipe(true, (Pipe*)actThisPtr->GetUserPointer());
+}
 
-	if (collisionBits & ENEMY)
+void Level::BeginPlayerKoopaTroopa(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	KoopaTroopa* koopaTroopaPtr = (KoopaTroopa*)actThisPtr->GetUserPointer();
+	if (GetPlayerFeet().y < koopaTroopaPtr->GetPosition().y)
 	{
-		std::vector<Enemy*> enemiesPtrArr = m_LevelDataPtr->GetEnemies();
-		for (size_t i = 0; i < enemiesPtrArr.size(); ++i)
+		if (m_PlayerPtr->IsHoldingItem() == false &&
+			m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
 		{
-			if (enemiesPtrArr[i] != nullptr)
-			{
-				if (enemiesPtrArr[i]->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
-				{
-					return true;
-				}
-			}
+			koopaTroopaPtr->StompKill();
+			m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, -58));
+		}
+		else
+		{
+			koopaTroopaPtr->HeadBonk();
+			m_PlayerPtr->Bounce(false);
+		}
+	}
+	else
+	{
+		// NOTE: If the koopa is shelless (aka laying helplessly and crying on the ground) then
+		// all the player needs to do is touch them and they die
+		// Once the shelless koopa starts walking (ANIMATION_STATE::WALKING_SHELLESS) then the player
+		// needs to jump on their head, the player will die if they touch the side of a walking shelless koopa
+		if (koopaTroopaPtr->GetAnimationState() == KoopaTroopa::AnimationState::SHELLESS)
+		{
+			koopaTroopaPtr->ShellHit();
+		}
+		else
+		{
+			m_PlayerPtr->TakeDamage();
 		}
 	}
+}
+
+void Level::BeginPlayerMontyMole(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	MontyMole* montyMolePtr = (MontyMole*)actThisPtr->GetUserPointer();
+	if (montyMolePtr->IsAlive() == false) return;
 
-	if (collisionBits & PLAYER)
+	if (GetPlayerFeet().y < montyMolePtr->GetPosition().y)
 	{
-		if (m_PlayerPtr->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
+		if (m_PlayerPtr->GetAnimationState() == Player::AnimationState::SPIN_JUMPING)
+		{
+			montyMolePtr->StompKill();
+			m_PlayerPtr->SetLinearVelocity(DOUBLE2(m_PlayerPtr->GetLinearVelocity().x, 0));
+		}
+		else
 		{
-			return true;
+			montyMolePtr->HeadBonk();
+			m_PlayerPtr->Bounce(false);
 		}
 	}
+	else
+	{
+		m_PlayerPtr->TakeDamage();
+	}
+}
 
-	if (collisionBits & BLOCK || collisionBits & SHELL)
+void Level::BeginPlayerPirhanaPlant(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->TakeDamage();
+}
+
+void Level::BeginPlayerCharginChuck(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	CharginChuck* charginChuckPtr = (CharginChuck*)actThisPtr->GetUserPointer();
+	if (charginChuckPtr->GetAnimationState() != CharginChuck::AnimationState::DEAD &&
+		m_PlayerPtr->IsAirborne())
+	{
+		charginChuckPtr->HeadBonk();
+		const int horizontalDir = GetPlayerFeet().x < charginChuckPtr->GetPosition().x ? -1 : 1;
+		m_PlayerPtr->Bounce(true, horizontalDir);
+	}
+	else
+	{
+		m_PlayerPtr->TakeDamage();
+	}
+}
+
+void Level::BeginPlayerYoshi(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	assert(m_YoshiPtr != nullptr);
+	if (m_YoshiPtr->IsHatching() == false && 
+		m_PlayerPtr->IsRidingYoshi() == false && 
+		m_PlayerPtr->IsHoldingItem() == false &&
+		(m_PlayerPtr->IsAirborne() && m_PlayerPtr->GetLinearVelocity().y >= 0))
+	{
+		m_PlayerPtr->RideYoshi(m_YoshiPtr);
+	}
+}
+
+void Level::BeginShellBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	KoopaShell* koopaShellPtr = (KoopaShell*)actOtherPtr->GetUserPointer();
+	Item* thisItemPtr = (Item*)actThisPtr->GetUserPointer();
+	if (thisItemPtr->IsBlock() == false || m_PlayerPtr->GetHeldItemPtr() == koopaShellPtr) return;
+
+	Block* blockPtr = (Block*)thisItemPtr;
+	DOUBLE2 koopaShellPos = koopaShellPtr->GetPosition();
+	DOUBLE2 blockPos = blockPtr->GetPosition();
+	bool shellBelowBlock = koopaShellPos.y > blockPos.y;
+	bool shellBesideBlock = koopaShellPos.x + KoopaShell::WIDTH / 2 <= blockPos.x - Block::WIDTH / 2 ||
+		koopaShellPos.x - KoopaShell::WIDTH / 2 >= blockPos.x + Block::WIDTH / 2;
+
+	if (shellBelowBlock || shellBesideBlock)
+	{
+		DOUBLE2 koopaShellVel = actOtherPtr->GetLinearVelocity();
+		koopaShellPtr->SetLinearVelocity(DOUBLE2(-koopaShellVel.x, koopaShellVel.y));
+		// When a shell hits a block it "hits" it as if the player hit it with their head
+		blockPtr->Hit();
+	}
+}
+
+void Level::BeginShellShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	KoopaShell* otherKoopaShellPtr = (KoopaShell*)actOtherPtr->GetUserPointer();
+	KoopaShell* thisKoopaShellPtr = (KoopaShell*)actThisPtr->GetUserPointer();
+	if (m_PlayerPtr->GetHeldItemPtr() == otherKoopaShellPtr)
+	{
+		m_PlayerPtr->DropHeldItem();
+		thisKoopaShellPtr->ShellHit(m_PlayerPtr->GetDirectionFacing());
+		m_PlayerPtr->AddScore(1000, false, thisKoopaShellPtr->GetPosition());
+	}
+	else if (!otherKoopaShellPtr->IsMoving())
+	{
+		otherKoopaShellPtr->ShellHit();
+	}
+}
+
+void Level::BeginShellKoopaTroopa(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	KoopaShell* koopaShellPtr = (KoopaShell*)actOtherPtr->GetUserPointer();
+	KoopaTroopa* koopaTroopaPtr = (KoopaTroopa*)actThisPtr->GetUserPointer();
+	if (m_PlayerPtr->GetHeldItemPtr() == koopaShellPtr)
 	{
-		std::vector<Item*> itemsPtrArr = m_LevelDataPtr->GetItems();
-		for (size_t i = 0; i < itemsPtrArr.size(); ++i)
+		m_PlayerPtr->DropHeldItem();
+		koopaTroopaPtr->ShellHit(true);
+	}
+	else if (koopaShellPtr->IsMoving() || koopaShellPtr->IsBouncing())
+	{
+		koopaTroopaPtr->ShellHit();
+	}
+}
+
+void Level::BeginShellPlayer(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	if (m_PlayerPtr->IsRidingYoshi())
+	{
+		m_PlayerPtr->DismountYoshi(true);
+	}
+}
+
+void Level::BeginGrabBlockPrizeBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	PrizeBlock* prizeBlockPtr = (PrizeBlock*)actThisPtr->GetUserPointer();
+	if (prizeBlockPtr->IsFlying())
+	{
+		prizeBlockPtr->Hit();
+	}
+}
+
+void Level::BeginGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	GrabBlock* grabBlockPtr = (GrabBlock*)actOtherPtr->GetUserPointer();
+	const int grabBlockDir = actOtherPtr->GetLinearVelocity().x > 0 ? Direction::RIGHT : Direction::LEFT;
+	const DOUBLE2 point1 = grabBlockPtr->GetPosition();
+	const DOUBLE2 point2 = grabBlockPtr->GetPosition() + DOUBLE2((Block::WIDTH / 2 + 3) * grabBlockDir, 0);
+	DOUBLE2 intersection, normal;
+	double fraction = -1.0;
+	int collisionBits = Level::LEVEL | Level::BLOCK;
+
+	if (Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+	{
+		// Explode when hitting things head on
+		grabBlockPtr->Explode();
+	}
+}
+
+void Level::BeginFireballEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	Enemy* enemyPtr = (Enemy*)actThisPtr->GetUserPointer();
+	m_EnemiesToBeRemovedPtrArr.push_back(enemyPtr);
+	SoundManager::PlaySoundEffect(SoundManager::Sound::SHELL_KICK);
+	m_PlayerPtr->AddScore(200, false, enemyPtr->GetPosition() + DOUBLE2(0, -10));
+}
+
+void Level::BeginTongueEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	if (m_PlayerPtr->IsRidingYoshi() &&
+		m_YoshiPtr->IsTongueStuckOut() == false) 
+	{
+		m_PlayerPtr->TakeDamage();
+	}
+	else
+	{
+		m_YoshiPtr->TongueTouchedEnemy((Enemy*)actThisPtr->GetUserPointer());
+	}
+}
+
+void Level::BeginTongueItem(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_YoshiPtr->TongueTouchedItem((Item*)actThisPtr->GetUserPointer());
+}
+
+void Level::EndPlayerBeanstalk(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->SetOverlappingWithBeanstalk(false);
+}
+
+void Level::EndPlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->SetTouchingGrabBlock(false, (GrabBlock*)actThisPtr->GetUserPointer());
+}
+
+void Level::EndPlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr)
+{
+	m_PlayerPtr->SetTouchingPipe(false);
+}
+
+bool Level::Raycast(DOUBLE2 point1, DOUBLE2 point2, int collisionBits, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef)
+{
+	if (point1 == point2) return false;
+
+	m_RaycastCollisionBits = collisionBits;
+	m_RaycastHit = false;
+	m_RaycastFraction = 1.0f;
+
+	// NOTE: The world only walks the nodes of its dynamic tree which the ray overlaps
+	const b2Vec2 p1 = b2Vec2(float32(point1.x / PhysicsActor::SCALE), float32(point1.y / PhysicsActor::SCALE));
+	const b2Vec2 p2 = b2Vec2(float32(point2.x / PhysicsActor::SCALE), float32(point2.y / PhysicsActor::SCALE));
+	GAME_ENGINE->GetBox2DWorld()->RayCast(this, p1, p2);
+
+	if (m_RaycastHit)
+	{
+		intersectionRef = DOUBLE2(m_RaycastPoint.x, m_RaycastPoint.y) * PhysicsActor::SCALE;
+		normalRef = DOUBLE2(m_RaycastNormal.x, m_RaycastNormal.y);
+		fractionRef = m_RaycastFraction;
+	}
+
+	return m_RaycastHit;
+}
+
+float32 Level::ReportFixture(b2Fixture* fixturePtr, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+{
+	const int categoryBits = fixturePtr->GetFilterData().categoryBits;
+	bool collides = (categoryBits & m_RaycastCollisionBits) != 0;
+
+	PhysicsActor* actPtr = (PhysicsActor*)fixturePtr->GetUserData();
+	if (actPtr != nullptr && actPtr->GetUserData() == int(ActorId::ITEM))
+	{
+		Item* itemPtr = (Item*)actPtr->GetUserPointer();
+		if (itemPtr->GetType() == Item::Type::ROTATING_BLOCK && ((RotatingBlock*)itemPtr)->IsRotating())
 		{
-			if (itemsPtrArr[i] != nullptr)
-			{
-				bool blockCollision = collisionBits & BLOCK && itemsPtrArr[i]->IsBlock();
-
-				if (blockCollision && itemsPtrArr[i]->GetType() == Item::Type::ROTATING_BLOCK)
-				{
-					if (((RotatingBlock*)itemsPtrArr[i])->IsRotating())
-					{
-						blockCollision = false;
-					}
-				}
-
-				bool shellCollision = collisionBits & SHELL && itemsPtrArr[i]->GetType() == Item::Type::KOOPA_SHELL;
-
-				if (blockCollision || shellCollision)
-				{
-					if (itemsPtrArr[i]->Raycast(point1, point2, intersectionRef, normalRef, fractionRef))
-					{
-						return true;
-					}
-				}
-			}
+			collides = false;
+		}
+		else if (itemPtr->GetType() == Item::Type::COIN && (m_RaycastCollisionBits & BLOCK))
+		{
+			// Coins are in the item category, but act like blocks while a p-switch is active
+			collides = ((Coin*)itemPtr)->IsBlock();
 		}
 	}
 
-	return false;
+	if (collides == false) return -1.0f;
+
+	m_RaycastHit = true;
+	m_RaycastPoint = point;
+	m_RaycastNormal = normal;
+	m_RaycastFraction = fraction;
+
+	// Clip the ray here so only closer fixtures are reported from now on
+	return fraction;
 }
 
 void Level::TriggerEndScreen(int barHitHeight)
@@ -1251,14 +1414,34 @@ void Level::TriggerEndScreen(int barHitHeight)
 	SoundManager::SetAllSongsPaused(true);
 }
 
-void Level::AddParticle(Particle* particlePtr)
+ParticleHandle Level::AddParticle(Particle* particlePtr)
+{
+	return m_ParticleManagerPtr->AddParticle(particlePtr);
+}
+
+void Level::AddParticle(SpriteParticleStore::Kind kind, DOUBLE2 position, DOUBLE2 velocity)
+{
+	m_ParticleManagerPtr->AddParticle(kind, position, velocity);
+}
+
+void Level::AddEnemyPoofParticles(DOUBLE2 position)
 {
-	m_ParticleManagerPtr->AddParticle(particlePtr);
+	m_ParticleManagerPtr->AddEnemyPoofParticles(position);
 }
 
-void Level::RemoveParticle(Particle* particlePtr)
+void Level::RemoveParticle(ParticleHandle handle)
 {
-	m_ParticleManagerPtr->RemoveParticle(particlePtr);
+	m_ParticleManagerPtr->RemoveParticle(handle);
+}
+
+void Level::SubmitProbe(Entity* entityPtr, Probe* probePtr)
+{
+	m_ProbeServicePtr->Submit(entityPtr, probePtr);
+}
+
+void Level::CancelProbes(Entity* entityPtr)
+{
+	m_ProbeServicePtr->Cancel(entityPtr);
 }
 
 void Level::WarpPlayerToPipe(int pipeIndex)
@@ -1293,6 +1476,7 @@ void Level::AddYoshi(Yoshi* yoshiPtr)
 	}
 
 	m_YoshiPtr = yoshiPtr;
+	m_YoshiPrevPosition = yoshiPtr->GetPosition();
 	yoshiPtr->AddContactListener(this);
 }
 
@@ -1356,12 +1540,12 @@ void Level::SetActiveMessage(Message* activeMessagePtr)
 
 void Level::TurnCoinsToBlocks(bool toBlocks)
 {
-	std::vector<Item*> itemsPtrArr = m_LevelDataPtr->GetItems();
-	for (size_t i = 0; i < itemsPtrArr.size(); ++i)
+	const std::vector<Item*>& itemsPtrArrRef = m_LevelDataPtr->GetItems();
+	for (size_t i = 0; i < itemsPtrArrRef.size(); ++i)
 	{
-		if (itemsPtrArr[i] != nullptr && itemsPtrArr[i]->GetType() == Item::Type::COIN)
+		if (itemsPtrArrRef[i] != nullptr && itemsPtrArrRef[i]->GetType() == Item::Type::COIN)
 		{
-			((Coin*)itemsPtrArr[i])->TurnToBlock(toBlocks);
+			((Coin*)itemsPtrArrRef[i])->TurnToBlock(toBlocks);
 		}
 	}
 	
@@ -1402,6 +1586,11 @@ bool Level::IsCheckpointCleared() const
 	return m_IsCheckpointCleared;
 }
 
+bool Level::IsPSwitchActive() const
+{
+	return m_CoinsToBlocksTimer.IsActive();
+}
+
 int Level::GetTimeRemaining() const
 {
 	return m_TimeRemaining;
@@ -6,26 +6,31 @@
 #include "SoundManager.h"
 #include "AnimationInfo.h"
 #include "SessionInfo.h"
+#include "ParticleManager.h"
+#include "ProbeService.h"
+#include "TileMap.h"
+#include "Camera.h"
+#include "HUDLayer.h"
 
 class Game;
 class GameState;
 class LevelData;
 class Platform;
 class Pipe;
+class Entity;
 class Item;
 class Enemy;
 class Player;
 class Yoshi;
 class Message;
 
-class Camera;
 class Particle;
-class ParticleManager;
 class SpriteSheet;
+class ChunkedBitmap;
 
 struct LevelProperties;
 
-class Level : public ContactListener
+class Level : public ContactListener, public b2RayCastCallback
 {
 public:
 	enum CollisionFilter
@@ -64,6 +69,13 @@ public:
 	void Paint();
 	void Reset();
 
+	// Called when the player leaves this level through a pipe, deactivates every physics body this level owns
+	// so the level can be kept around and resumed later, instead of being loaded again
+	void Suspend();
+	// Called when the player comes back to this level through a pipe
+	void Resume(SessionInfo sessionInfo, Pipe* spawningPipePtr = nullptr);
+	int GetIndex() const;
+
 	void AddItem(Item* newItemPtr, bool addContactListener = false);
 	void RemoveItem(Item* itemPtr);
 	void AddEnemy(Enemy* newEnemyPtr);
@@ -79,6 +91,8 @@ public:
 	bool IsPaused() const;
 
 	bool IsCheckpointCleared() const;
+	// Whether a p switch has turned the coins into blocks
+	bool IsPSwitchActive() const;
 	Player* GetPlayer() const;
 	DOUBLE2 GetCameraOffset(double deltaTime);
 	void SpeedUpMusic();
@@ -87,18 +101,100 @@ public:
 	void WarpPlayerToPipe(int pipeIndex);
 
 	void GiveItemToPlayer(Item* itemPtr);
-	void RemoveParticle(Particle* particlePtr);
-	void AddParticle(Particle* particlePtr);
+	void RemoveParticle(ParticleHandle handle);
+	ParticleHandle AddParticle(Particle* particlePtr);
+	void AddParticle(SpriteParticleStore::Kind kind, DOUBLE2 position, DOUBLE2 velocity = DOUBLE2(0, 0));
+	void AddEnemyPoofParticles(DOUBLE2 position);
+	// Finds the closest fixture along the ray whose collision category is in collisionBits
 	bool Raycast(DOUBLE2 point1, DOUBLE2 point2, int collisionBits, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef);
 	void TriggerEndScreen(int barHitHeight = -1);
 
+	// The level's terrain as tiles, for ground questions which don't need an exact answer from the physics world
+	const TileMap* GetTileMap() const;
+
+	void SubmitProbe(Entity* entityPtr, Probe* probePtr);
+	void CancelProbes(Entity* entityPtr);
+
 private:
+	typedef void (Level::*PreSolveRule)(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	typedef void (Level::*ContactRule)(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+
+	// What happens when an actor of one kind touches an actor of another kind, nullptr if nothing does
+	struct ContactRules
+	{
+		PreSolveRule m_PreSolve = nullptr;
+		ContactRule m_BeginContact = nullptr;
+		ContactRule m_EndContact = nullptr;
+	};
+
 	void PreSolve(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool & enableContactRef);
 	void BeginContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
 	void EndContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
 
+	static void InitializeContactRules();
+	static ContactRules& GetContactRules(int otherKind, int thisKind);
+	// Items and enemies are keyed by their type, every other actor by its ActorId
+	static int GetContactKind(PhysicsActor* actPtr);
+	static int GetItemContactKind(int itemType);
+	static int GetEnemyContactKind(int enemyType);
+
+	void DisableContact(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerLevel(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerCoin(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerPSwitch(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerYoshi(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlayerEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveCharginChuck(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveEnemyPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveCharginChuckPlatform(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePSwitchRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveShellEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolveShellPlayer(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+	void PreSolvePlatformShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr, bool& enableContactRef);
+
+	void BeginPlayerCoin(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerPickup(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerRotatingBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerBeanstalk(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerMidwayGate(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerGoalGate(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerPSwitch(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerKoopaTroopa(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerMontyMole(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerPirhanaPlant(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerCharginChuck(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginPlayerYoshi(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginShellBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginShellShell(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginShellKoopaTroopa(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginShellPlayer(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginGrabBlockPrizeBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginFireballEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginTongueEnemy(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void BeginTongueItem(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+
+	void EndPlayerBeanstalk(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void EndPlayerGrabBlock(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+	void EndPlayerPipe(PhysicsActor *actThisPtr, PhysicsActor *actOtherPtr);
+
+	// Called by b2World::RayCast for every fixture the ray in Raycast passes through
+	float32 ReportFixture(b2Fixture* fixturePtr, const b2Vec2& point, const b2Vec2& normal, float32 fraction);
+
 	bool ActorCanPassThroughPlatform(PhysicsActor *actPlatformPtr, DOUBLE2& actorPosRef, double actorWidth, double actorHeight);
 	void CollidePlayerWithBlock(DOUBLE2 blockCenterPos, DOUBLE2 playerFeet, bool& enableContactRef);
+	DOUBLE2 GetPlayerFeet() const;
+	bool IsPlayerRising() const;
 
 	void DEBUGPaintZoomedOut();
 	void ResetMembers();
@@ -106,13 +202,25 @@ private:
 	void TogglePaused(bool pauseSongs);
 	void TurnCoinsToBlocks(bool toBlocks);
 	void ReadLevelData(int levelIndex);
+	void BuildTileMap(const String& svgFilePathRef);
 	void PaintHUD();
+	void PaintPlayer(double alpha);
+	void PaintYoshi(double alpha);
+	// How far the player is painted from where it is this tick
+	DOUBLE2 GetPlayerPaintOffset(double alpha) const;
 	void PaintEnclosingCircle(DOUBLE2 circleCenter, double innerCircleRadius);
 
 	static const double TIME_SCALE; // How fast an in-game second is compared to a real life second
 	static const int TIME_UP_WARNING; // When this many in game seconds are remaining a sound is played
 	static const int MESSAGE_BLOCK_WARNING_TIME; // Play a warning sound when this many frames are remaining in the pressed timer
 
+	// Contact kinds are every ActorId, followed by every item type, followed by every enemy type
+	static const int FIRST_ITEM_CONTACT_KIND;
+	static const int FIRST_ENEMY_CONTACT_KIND;
+	static const int NUM_CONTACT_KINDS;
+	// Indexed by [other kind][this kind], filled in once when the first level is created
+	static std::vector<ContactRules> m_ContactRulesArr;
+
 	const int INDEX;
 
 	bool m_IsShowingEndScreen;
@@ -129,7 +237,7 @@ private:
 	const int TOTAL_FRAMES_OF_BACKGROUND_ANIMATION;
 	AnimationInfo m_BackgroundAnimInfo;
 
-	Bitmap* m_BmpForegroundPtr = nullptr;
+	ChunkedBitmap* m_BmpForegroundPtr = nullptr;
 	Bitmap* m_BmpBackgroundPtr = nullptr;
 
 	std::vector<Item*> m_ItemsToBeRemovedPtrArr;
@@ -137,6 +245,16 @@ private:
 
 	PhysicsActor* m_ActLevelPtr = nullptr;
 
+	// The state of the raycast currently in progress, see ReportFixture
+	int m_RaycastCollisionBits = 0;
+	bool m_RaycastHit = false;
+	b2Vec2 m_RaycastPoint;
+	b2Vec2 m_RaycastNormal;
+	float32 m_RaycastFraction = 1.0f;
+
+	// Every body which was active when this level was suspended, these are reactivated on resume
+	std::vector<b2Body*> m_SuspendedBodiesPtrArr;
+
 	bool m_TimeWarningPlayed;
 	bool m_PSwitchTimeWarningPlayed;
 	bool m_Paused;
@@ -146,7 +264,9 @@ private:
 	double m_SecondsElapsed; // How many real-time seconds have elapsed
 	
 	const int TOTAL_TIME; // How many in-game seconds the player has to complete this level
-	int m_TimeRemaining; // How many in-game seconds are remaining
+	int m_TimeRemaining; // How many in-game seconds are remaining, updated every tick
+
+	HUDLayer m_HUDLayer;
 	
 	// How many pixels wide the foreground of the level is
 	const double WIDTH;
@@ -161,7 +281,14 @@ private:
 	SMWTimer m_CoinsToBlocksTimer;
 
 	Player *m_PlayerPtr = nullptr;
+	// Where the player and yoshi were at the start of this tick, used to smooth out painting between ticks
+	DOUBLE2 m_PlayerPrevPosition;
+	DOUBLE2 m_YoshiPrevPosition;
 	Camera* m_CameraPtr = nullptr;
+	// What is on screen during Paint, and how many paint calls were culled this frame
+	ViewCulling m_ViewCulling;
 	ParticleManager* m_ParticleManagerPtr = nullptr;
+	ProbeService* m_ProbeServicePtr = nullptr;
+	TileMap* m_TileMapPtr = nullptr;
 	Yoshi* m_YoshiPtr = nullptr;
 };
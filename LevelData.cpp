@@ -4,8 +4,9 @@
 #include "Game.h"
 #include "Enumerations.h"
 #include "Level.h"
+#include "Camera.h"
 #include "Player.h"
-#include "FileIO.h"
+#include "LevelDataFile.h"
 #include "SMWColour.h"
 
 #include "Entity.h"
@@ -37,183 +38,166 @@
 #include "GoalGate.h"
 
 std::vector<LevelData*> LevelData::m_LevelDataPtrArr = std::vector<LevelData*>(Constants::NUM_LEVELS);
+std::vector<LevelDataFile*> LevelData::m_SpawnTemplatePtrArr = std::vector<LevelDataFile*>(Constants::NUM_LEVELS);
 
-LevelData::LevelData(const std::string& platforms, const std::string& pipes, const std::string& items, const std::string& enemies, Level* levelPtr) :
-	m_LevelPtr(levelPtr)
+LevelData::LevelData(const LevelDataFile* spawnTemplatePtr, Level* levelPtr) :
+	m_LevelPtr(levelPtr),
+	m_SpawnTemplatePtr(spawnTemplatePtr),
+	m_ItemActivationGrid(Item::MINIMUM_PLAYER_DISTANCE),
+	m_EnemyActivationGrid(Enemy::MINIMUM_PLAYER_DISTANCE)
 {
-	std::string line;
-
 	// PLATFORMS
-	int platformTagBeginIndex = -1;
-	while ((platformTagBeginIndex = platforms.find("<Platform>", platformTagBeginIndex + 1)) != std::string::npos)
+	const LevelDataFile::PlatformRecord* platformRecordsPtr = m_SpawnTemplatePtr->GetPlatforms();
+	for (int i = 0; i < m_SpawnTemplatePtr->GetNumPlatforms(); ++i)
 	{
-		std::string platformContent = FileIO::GetTagContent(platforms, "Platform", platformTagBeginIndex);
-
-		int comma1 = platformContent.find(",");
-		int comma2 = platformContent.find(",", comma1 + 1);
-		int left = stoi(platformContent.substr(0, comma1)) * TILE_SIZE;
-		int top = stoi(platformContent.substr(comma1 + 1, comma2 - comma1 - 1)) * TILE_SIZE;
-		int right = stoi(platformContent.substr(comma2 + 1)) * TILE_SIZE;
-
-		m_PlatformsPtrArr.push_back(new Platform(left, top, right));
+		const LevelDataFile::PlatformRecord& recordRef = platformRecordsPtr[i];
+		m_PlatformsPtrArr.push_back(new Platform(recordRef.m_Left * TILE_SIZE, recordRef.m_Top * TILE_SIZE, recordRef.m_Right * TILE_SIZE));
 	}
 
-
 	// PIPES
-	int pipeTagBeginIndex = -1;
-	int pipeIndex = 0; // Keep track of how many pipes we've added so far
-	while ((pipeTagBeginIndex = pipes.find("<Pipe>", pipeTagBeginIndex + 1)) != std::string::npos)
+	const LevelDataFile::PipeRecord* pipeRecordsPtr = m_SpawnTemplatePtr->GetPipes();
+	for (int pipeIndex = 0; pipeIndex < m_SpawnTemplatePtr->GetNumPipes(); ++pipeIndex)
 	{
-		std::string pipeContent = FileIO::GetTagContent(pipes, "Pipe", pipeTagBeginIndex);
+		const LevelDataFile::PipeRecord& recordRef = pipeRecordsPtr[pipeIndex];
+		DOUBLE2 topLeft = DOUBLE2(recordRef.m_Left, recordRef.m_Top) * TILE_SIZE;
+		DOUBLE2 bottomRight = DOUBLE2(recordRef.m_Right, recordRef.m_Bottom) * TILE_SIZE;
 
-		std::string boundingBoxString = FileIO::GetTagContent(pipeContent, "BoundingBox");
-		RECT2 boundingBox = FileIO::StringToRECT2(boundingBoxString);
-		DOUBLE2 topLeft = DOUBLE2(boundingBox.left, boundingBox.top) * TILE_SIZE;
-		DOUBLE2 bottomRight = DOUBLE2(boundingBox.right, boundingBox.bottom) * TILE_SIZE;
-
-		Pipe::Orientation pipeOrientation = Pipe::StringToOrientation(FileIO::GetTagContent(pipeContent, "Orientation"));
-		bool pipeIsEnterable = FileIO::GetTagContent(pipeContent, "Enterable") == "1";
+		m_PipesPtrArr.push_back(new Pipe(topLeft, bottomRight, levelPtr, Pipe::Orientation(recordRef.m_Orientation), 
+			pipeIndex, recordRef.m_WarpLevelIndex, recordRef.m_WarpPipeIndex));
+	}
 
-		std::string spawnsString = FileIO::GetTagContent(pipeContent, "Spawns");
-		bool spawnsPiranhaPlant = false;
-		if (spawnsString.length() > 0 && !spawnsString.compare("PiranhaPlant"))
+	// ITEMS
+	const LevelDataFile::ItemRecord* itemRecordsPtr = m_SpawnTemplatePtr->GetItems();
+	for (int i = 0; i < m_SpawnTemplatePtr->GetNumItems(); ++i)
+	{
+		Item* itemPtr = SpawnItem(itemRecordsPtr[i]);
+		if (itemPtr != nullptr)
 		{
-			int pipeWidth = int(bottomRight.x - topLeft.x);
-			m_EnemiesPtrArr.push_back(new PiranhaPlant(topLeft + DOUBLE2(pipeWidth / 2, Item::TILE_SIZE * 2), levelPtr));
+			AddItem(itemPtr, i);
 		}
+	}
 
-		int warpLevelIndex = -1;
-		std::string warpLevelIndexStr = FileIO::GetTagContent(pipeContent, "WarpLevelIndex");
-		if (warpLevelIndexStr.length() > 0) warpLevelIndex = stoi(warpLevelIndexStr);
+	// ENEMIES
+	SpawnEnemies();
+}
 
-		int warpPipeIndex = -1;
-		std::string warpPipeIndexStr = FileIO::GetTagContent(pipeContent, "WarpPipeIndex");
-		if (warpPipeIndexStr.length() > 0) warpPipeIndex = stoi(warpPipeIndexStr);
+Item* LevelData::SpawnItem(const LevelDataFile::ItemRecord& recordRef)
+{
+	DOUBLE2 topLeft = DOUBLE2(recordRef.m_Left, recordRef.m_Top) * TILE_SIZE;
+	Colour itemColour = Colour(recordRef.m_Colour);
 
-		m_PipesPtrArr.push_back(new Pipe(topLeft, bottomRight, levelPtr, pipeOrientation, pipeIndex, warpLevelIndex, warpPipeIndex));
-		++pipeIndex;
+	switch (recordRef.m_Type)
+	{
+	case int(Item::Type::PRIZE_BLOCK):
+	{
+		std::string spawnsString = m_SpawnTemplatePtr->GetString(recordRef.m_SpawnsOffset);
+		return new PrizeBlock(topLeft, m_LevelPtr, spawnsString, recordRef.m_IsFlyer != 0);
 	}
-
-
-	// ITEMS
-	int itemTagBeginIndex = -1;
-	while ((itemTagBeginIndex = items.find("<Item>", itemTagBeginIndex + 1)) != std::string::npos)
+	case int(Item::Type::EXCLAMATION_MARK_BLOCK):
 	{
-		std::string itemContent = FileIO::GetTagContent(items, "Item", itemTagBeginIndex);
-
-		// GENERAL PROPERTIES
-		DOUBLE2 topLeft = StringToDOUBLE2(FileIO::GetTagContent(itemContent, "TopLeft")) * TILE_SIZE;
-		std::string itemTypeString = FileIO::GetTagContent(itemContent, "Type");
-		int itemType = int(Item::StringToTYPE(itemTypeString));
+		// LATER: Check if the yellow p-switch has been pressed to determine if ! blocks are solid or not
+		return new ExclamationMarkBlock(topLeft, itemColour, true, m_LevelPtr);
+	}
+	case int(Item::Type::COIN):
+	{
+		return new Coin(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::DRAGON_COIN):
+	{
+		return new DragonCoin(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::MESSAGE_BLOCK):
+	{
+		std::string messageText = m_SpawnTemplatePtr->GetString(recordRef.m_MessageTextOffset);
+		return new MessageBlock(topLeft, messageText, m_LevelPtr);
+	}
+	case int(Item::Type::ROTATING_BLOCK):
+	{
+		bool spawnsBeanstalk = !strcmp(m_SpawnTemplatePtr->GetString(recordRef.m_SpawnsOffset), "Beanstalk");
+		return new RotatingBlock(topLeft, m_LevelPtr, spawnsBeanstalk);
+	}
+	case int(Item::Type::CLOUD_BLOCK):
+	{
+		return new CloudBlock(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::GRAB_BLOCK):
+	{
+		return new GrabBlock(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::P_SWITCH):
+	{
+		return new PSwitch(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::BERRY):
+	{
+		return new Berry(topLeft, m_LevelPtr, itemColour);
+	}
+	case int(Item::Type::KOOPA_SHELL):
+	{
+		return new KoopaShell(topLeft, m_LevelPtr, itemColour);
+	}
+	case int(Item::Type::THREE_UP_MOON):
+	{
+		return new ThreeUpMoon(topLeft, m_LevelPtr);
+	}
+	case int(Item::Type::MIDWAY_GATE):
+	{
+		return new MidwayGate(topLeft, m_LevelPtr, recordRef.m_BarHeight);
+	}
+	case int(Item::Type::GOAL_GATE):
+	{
+		return new GoalGate(topLeft, m_LevelPtr);
+	}
+	default:
+	{
+		OutputDebugString(String("ERROR: Unhandled item passed to LevelData::SpawnItem(): ") + String(recordRef.m_Type) + String("\n"));
+	} break;
+	}
 
-		// UNIQUE PROPERTIES
-		// NOTE: Not all items have the following properties, but there is no harm is seeing if a tag is there
-		Colour itemColour = SMWColour::StringToCOLOUR(FileIO::GetTagContent(itemContent, "Colour"));
+	return nullptr;
+}
 
-		switch (itemType)
-		{
-		case int(Item::Type::PRIZE_BLOCK):
-		{
-			std::string spawnsString = FileIO::GetTagContent(itemContent, "Spawns");
-			std::string isFlyerString = FileIO::GetTagContent(itemContent, "Flyer");
-			bool isFlyer = (isFlyerString.length() > 0);
-			m_ItemsPtrArr.push_back(new PrizeBlock(topLeft, levelPtr, spawnsString, isFlyer));
-		} break;
-		case int(Item::Type::EXCLAMATION_MARK_BLOCK):
-		{
-			// LATER: Check if the yellow p-switch has been pressed to determine if ! blocks are solid or not
-			m_ItemsPtrArr.push_back(new ExclamationMarkBlock(topLeft, itemColour, true, levelPtr));
-		} break;
-		case int(Item::Type::COIN):
-		{
-			m_ItemsPtrArr.push_back(new Coin(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::DRAGON_COIN):
-		{
-			m_ItemsPtrArr.push_back(new DragonCoin(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::MESSAGE_BLOCK):
-		{
-			std::string messageText = FileIO::GetTagContent(itemContent, "MessageText");
-			m_ItemsPtrArr.push_back(new MessageBlock(topLeft, messageText, levelPtr));
-		} break;
-		case int(Item::Type::ROTATING_BLOCK):
-		{
-			std::string spawnItem = FileIO::GetTagContent(itemContent, "Spawns");
-			bool spawnsBeanstalk = !spawnItem.compare("Beanstalk");
-			m_ItemsPtrArr.push_back(new RotatingBlock(topLeft, levelPtr, spawnsBeanstalk));
-		} break;
-		case int(Item::Type::CLOUD_BLOCK):
-		{
-			m_ItemsPtrArr.push_back(new CloudBlock(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::GRAB_BLOCK):
-		{
-			m_ItemsPtrArr.push_back(new GrabBlock(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::P_SWITCH):
-		{
-			m_ItemsPtrArr.push_back(new PSwitch(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::BERRY):
-		{
-			m_ItemsPtrArr.push_back(new Berry(topLeft, levelPtr, itemColour));
-		} break;
-		case int(Item::Type::KOOPA_SHELL):
-		{
-			m_ItemsPtrArr.push_back(new KoopaShell(topLeft, levelPtr, itemColour));
-		} break;
-		case int(Item::Type::THREE_UP_MOON):
-		{
-			m_ItemsPtrArr.push_back(new ThreeUpMoon(topLeft, levelPtr));
-		} break;
-		case int(Item::Type::MIDWAY_GATE):
-		{
-			int barHeight = stoi(FileIO::GetTagContent(itemContent, "BarHeight"));
-			m_ItemsPtrArr.push_back(new MidwayGate(topLeft, levelPtr, barHeight));
-		} break;
-		case int(Item::Type::GOAL_GATE):
-		{
-			m_ItemsPtrArr.push_back(new GoalGate(topLeft, levelPtr));
-		} break;
-		default:
+void LevelData::SpawnEnemies()
+{
+	// Piranha plants live in pipes, they come first
+	const LevelDataFile::PipeRecord* pipeRecordsPtr = m_SpawnTemplatePtr->GetPipes();
+	for (int i = 0; i < m_SpawnTemplatePtr->GetNumPipes(); ++i)
+	{
+		const LevelDataFile::PipeRecord& recordRef = pipeRecordsPtr[i];
+		if (recordRef.m_SpawnsPiranhaPlant)
 		{
-			OutputDebugString(String("ERROR: Unhandled item passed LevelData(): ") + String(itemTypeString.c_str()) + String("\n"));
-		} break;
+			DOUBLE2 topLeft = DOUBLE2(recordRef.m_Left, recordRef.m_Top) * TILE_SIZE;
+			int pipeWidth = int((recordRef.m_Right - recordRef.m_Left) * TILE_SIZE);
+			AddEnemy(new PiranhaPlant(topLeft + DOUBLE2(pipeWidth / 2, Item::TILE_SIZE * 2), m_LevelPtr));
 		}
 	}
 
-	// ENEMIES
-	int enemyTagBeginIndex = -1;
-	while ((enemyTagBeginIndex = enemies.find("<Enemy>", enemyTagBeginIndex + 1)) != std::string::npos)
+	const LevelDataFile::EnemyRecord* enemyRecordsPtr = m_SpawnTemplatePtr->GetEnemies();
+	for (int i = 0; i < m_SpawnTemplatePtr->GetNumEnemies(); ++i)
 	{
-		std::string enemyContent = FileIO::GetTagContent(enemies, "Enemy", enemyTagBeginIndex);
+		const LevelDataFile::EnemyRecord& recordRef = enemyRecordsPtr[i];
+		DOUBLE2 topLeft = (DOUBLE2(recordRef.m_Left, recordRef.m_Top) * TILE_SIZE) + DOUBLE2(0, -2);
+		Colour enemyColour = Colour(recordRef.m_Colour);
 
-		DOUBLE2 topLeft = (StringToDOUBLE2(FileIO::GetTagContent(enemyContent, "TopLeft")) * TILE_SIZE) + DOUBLE2(0, -2);
-		std::string enemyTypeString = FileIO::GetTagContent(enemyContent, "Type");
-		int enemyType = int(Enemy::StringToTYPE(enemyTypeString));
-
-		Colour enemyColour = SMWColour::StringToCOLOUR(FileIO::GetTagContent(enemyContent, "Colour"));
-
-		switch (enemyType)
+		switch (recordRef.m_Type)
 		{
 		case int(Enemy::Type::KOOPA_TROOPA):
 		{
-			m_EnemiesPtrArr.push_back(new KoopaTroopa(topLeft, levelPtr, enemyColour));
+			AddEnemy(new KoopaTroopa(topLeft, m_LevelPtr, enemyColour));
 		} break;
 		case int(Enemy::Type::MONTY_MOLE):
 		{
-			MontyMole::AIType aiType = MontyMole::StringToAIType(FileIO::GetTagContent(enemyContent, "AIType"));
-			MontyMole::SpawnLocationType spawnLocationType = MontyMole::StringToSpawnLocationType(FileIO::GetTagContent(enemyContent, "SpawnLocationType"));
-			m_EnemiesPtrArr.push_back(new MontyMole(topLeft, levelPtr, spawnLocationType, aiType));
+			MontyMole::AIType aiType = MontyMole::AIType(recordRef.m_AIType);
+			MontyMole::SpawnLocationType spawnLocationType = MontyMole::SpawnLocationType(recordRef.m_SpawnLocationType);
+			AddEnemy(new MontyMole(topLeft, m_LevelPtr, spawnLocationType, aiType));
 		} break;
 		case int(Enemy::Type::CHARGIN_CHUCK):
 		{
-			m_EnemiesPtrArr.push_back(new CharginChuck(topLeft, levelPtr));
+			AddEnemy(new CharginChuck(topLeft, m_LevelPtr));
 		} break;
 		default:
 		{
-			OutputDebugString(String("ERROR: Unhandled enemy passed to LevelData(): ") + String(enemyTypeString.c_str()) + String("\n"));
+			OutputDebugString(String("ERROR: Unhandled enemy passed to LevelData::SpawnEnemies(): ") + String(recordRef.m_Type) + String("\n"));
 		} break;
 		}
 	}
@@ -221,6 +205,9 @@ LevelData::LevelData(const std::string& platforms, const std::string& pipes, con
 
 LevelData::~LevelData()
 {
+	// Before the entities below are deleted, closing the holes touches every one of them
+	DeleteRemovedEntities();
+
 	for (size_t i = 0; i < m_PlatformsPtrArr.size(); ++i)
 	{
 		delete m_PlatformsPtrArr[i];
@@ -256,6 +243,9 @@ void LevelData::UnloadAllLevelData()
 	for (size_t i = 0; i < m_LevelDataPtrArr.size(); ++i)
 	{
 		UnloadLevelData(i);
+
+		delete m_SpawnTemplatePtrArr[i];
+		m_SpawnTemplatePtrArr[i] = nullptr;
 	}
 }
 
@@ -270,221 +260,336 @@ void LevelData::UnloadLevelData(int index)
 
 LevelData* LevelData::CreateLevelData(int levelIndex, Level* levelPtr)
 {
-	std::ifstream fileInStream;
-	std::stringstream stringStream;
-
-	std::stringstream levelIndexStr;
-	levelIndexStr << std::setw(2) << std::setfill('0') << levelIndex;
-	fileInStream.open("Resources/levels/" + levelIndexStr.str() + "/level-data.txt");
-	
-	if (fileInStream.fail())
+	if (m_SpawnTemplatePtrArr[levelIndex] == nullptr)
 	{
-		GAME_ENGINE->MessageBox(String(("Invalid level index: " + levelIndexStr.str() + "\n").c_str()));
-		return nullptr;
-	}
+		LevelDataFile* spawnTemplatePtr = new LevelDataFile();
+		if (spawnTemplatePtr->Load(levelIndex) == false)
+		{
+			delete spawnTemplatePtr;
+			GAME_ENGINE->MessageBox(String("Invalid level index: ") + String(levelIndex) + String("\n"));
+			return nullptr;
+		}
 
-	std::string line;
-	while (fileInStream.eof() == false)
-	{
-		std::getline(fileInStream, line);
-		stringStream << line << "\n";
+		m_SpawnTemplatePtrArr[levelIndex] = spawnTemplatePtr;
 	}
-	fileInStream.close();
-
-	std::string entireFileContents = stringStream.str();
-	
-	std::string platformsString = FileIO::GetTagContent(entireFileContents, "Platforms");
-	platformsString.erase(std::remove_if(platformsString.begin(), platformsString.end(), IsWhitespace()), platformsString.end());
-
-	std::string pipesString = FileIO::GetTagContent(entireFileContents, "Pipes");
-	pipesString.erase(std::remove_if(pipesString.begin(), pipesString.end(), IsWhitespace()), pipesString.end());
-
-	std::string itemsString = FileIO::GetTagContent(entireFileContents, "Items");
-	itemsString.erase(std::remove_if(itemsString.begin(), itemsString.end(), IsWhitespace()), itemsString.end());
 
-	std::string enemiesString = FileIO::GetTagContent(entireFileContents, "Enemies");
-	enemiesString.erase(std::remove_if(enemiesString.begin(), enemiesString.end(), IsWhitespace()), enemiesString.end());
-
-	return new LevelData(platformsString, pipesString, itemsString, enemiesString, levelPtr);
+	return new LevelData(m_SpawnTemplatePtrArr[levelIndex], levelPtr);
 }
 
-void LevelData::AddItem(Item* newItemPtr)
+void LevelData::ResetToSpawnTemplate()
 {
+	DeleteRemovedEntities();
+
+	// Everything which is kept is added back below, as though it had just spawned
+	m_ItemActivationGrid.Clear();
+	m_EnemyActivationGrid.Clear();
+	m_BackgroundEnemiesPtrArr.clear();
+	m_MainEnemiesPtrArr.clear();
+	m_ForegroundGatesPtrArr.clear();
+
+	// Every item that can reset itself is kept for the record it was spawned from
+	std::vector<Item*> spawnedItemsPtrArr(m_SpawnTemplatePtr->GetNumItems(), nullptr);
 	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
 	{
-		if (m_ItemsPtrArr[i] == nullptr)
+		const int recordIndex = m_ItemSlotRecordArr[i];
+		if (recordIndex != -1 && m_ItemsPtrArr[i]->ResetToSpawnState())
+		{
+			spawnedItemsPtrArr[recordIndex] = m_ItemsPtrArr[i];
+		}
+		else
 		{
-			m_ItemsPtrArr[i] = newItemPtr;
-			return;
+			delete m_ItemsPtrArr[i];
 		}
 	}
 
-	m_ItemsPtrArr.push_back(newItemPtr);
-}
-
-void LevelData::RemoveItem(Item* itemPtr)
-{
-	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+	// Items are put back in record order, the same order they were in when the level was first loaded
+	m_ItemsPtrArr.clear();
+	m_ItemSlotRecordArr.clear();
+	const LevelDataFile::ItemRecord* itemRecordsPtr = m_SpawnTemplatePtr->GetItems();
+	for (int i = 0; i < m_SpawnTemplatePtr->GetNumItems(); ++i)
 	{
-		if (m_ItemsPtrArr[i] == itemPtr)
+		Item* itemPtr = spawnedItemsPtrArr[i];
+		if (itemPtr == nullptr) itemPtr = SpawnItem(itemRecordsPtr[i]);
+
+		if (itemPtr != nullptr)
 		{
-			delete m_ItemsPtrArr[i];
-			m_ItemsPtrArr[i] = nullptr;
-			return;
+			AddItem(itemPtr, i);
 		}
 	}
 
-	OutputDebugString(String("ERROR: Could not delete item in LevelData::RemoveItem\n"));
+	// NOTE: Enemies carry too much AI state to reset in place, they are always spawned again
+	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
+	{
+		delete m_EnemiesPtrArr[i];
+	}
+	m_EnemiesPtrArr.clear();
+	SpawnEnemies();
 }
 
-void LevelData::RemoveItem(int itemIndex)
+void LevelData::AddItem(Item* newItemPtr)
+{
+	AddItem(newItemPtr, -1);
+}
+
+void LevelData::AddItem(Item* newItemPtr, int recordIndex)
 {
-	assert(itemIndex >= 0 && itemIndex < int(m_ItemsPtrArr.size()));
+	newItemPtr->SetLevelDataIndex(int(m_ItemsPtrArr.size()));
+	m_ItemsPtrArr.push_back(newItemPtr);
+	m_ItemSlotRecordArr.push_back(recordIndex);
+	m_ItemActivationGrid.Add(newItemPtr, newItemPtr->IsAlwaysActive());
+	if (newItemPtr->IsAlwaysActive()) newItemPtr->SetActivated(true);
 
-	delete m_ItemsPtrArr[itemIndex];
-	m_ItemsPtrArr[itemIndex] = nullptr;
+	if (newItemPtr->GetType() == Item::Type::GOAL_GATE ||
+		newItemPtr->GetType() == Item::Type::MIDWAY_GATE)
+	{
+		m_ForegroundGatesPtrArr.push_back((Gate*)newItemPtr);
+	}
 }
 
-void LevelData::AddEnemy(Enemy* newEnemyPtr)
+void LevelData::RemoveItem(Item* itemPtr)
 {
-	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
+	const int index = itemPtr->GetLevelDataIndex();
+	if (index == -1) return; // Already removed, items picked up by the player often remove themselves too
+
+	assert(m_ItemsPtrArr[index] == itemPtr);
+
+	// The hole is closed by DeleteRemovedEntities, moving another item into it would change the paint order
+	m_ItemsPtrArr[index] = nullptr;
+
+	itemPtr->SetLevelDataIndex(-1);
+	m_ItemActivationGrid.Remove(itemPtr);
+	m_RemovedItemsPtrArr.push_back(itemPtr);
+
+	// NOTE: There are only ever a couple of gates, and they are hardly ever removed
+	for (size_t i = 0; i < m_ForegroundGatesPtrArr.size(); ++i)
 	{
-		if (m_EnemiesPtrArr[i] == nullptr)
+		if (m_ForegroundGatesPtrArr[i] == itemPtr)
 		{
-			m_EnemiesPtrArr[i] = newEnemyPtr;
-			return;
+			m_ForegroundGatesPtrArr.erase(m_ForegroundGatesPtrArr.begin() + i);
+			break;
 		}
 	}
+}
 
+void LevelData::AddEnemy(Enemy* newEnemyPtr)
+{
+	newEnemyPtr->SetLevelDataIndex(int(m_EnemiesPtrArr.size()));
 	m_EnemiesPtrArr.push_back(newEnemyPtr);
+	m_EnemyActivationGrid.Add(newEnemyPtr);
+
+	// NOTE: Enemies never change type, so which list they're painted from is decided once
+	std::vector<Enemy*>& paintListRef = (newEnemyPtr->GetType() == Enemy::Type::PIRHANA_PLANT) ? m_BackgroundEnemiesPtrArr : m_MainEnemiesPtrArr;
+	newEnemyPtr->SetPaintListIndex(int(paintListRef.size()));
+	paintListRef.push_back(newEnemyPtr);
 }
 
 void LevelData::RemoveEnemy(Enemy* enemyPtr)
 {
-	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
-	{
-		if (m_EnemiesPtrArr[i] == enemyPtr)
-		{
-			delete m_EnemiesPtrArr[i];
-			m_EnemiesPtrArr[i] = nullptr;
-			return;
-		}
-	}
+	const int index = enemyPtr->GetLevelDataIndex();
+	if (index == -1) return;
+
+	assert(m_EnemiesPtrArr[index] == enemyPtr);
+
+	m_EnemiesPtrArr[index] = nullptr;
 
-	OutputDebugString(String("ERROR: Could not delete item in LevelData::RemoveItem\n"));
-	assert(false);
+	enemyPtr->SetLevelDataIndex(-1);
+	m_EnemyActivationGrid.Remove(enemyPtr);
+	m_RemovedEnemiesPtrArr.push_back(enemyPtr);
+
+	RemoveFromPaintList((enemyPtr->GetType() == Enemy::Type::PIRHANA_PLANT) ? m_BackgroundEnemiesPtrArr : m_MainEnemiesPtrArr, enemyPtr);
 }
 
-void LevelData::RemoveEnemy(int enemyIndex)
+void LevelData::RemoveFromPaintList(std::vector<Enemy*>& paintListRef, Enemy* enemyPtr)
 {
-	assert(enemyIndex >= 0 && enemyIndex < int(m_EnemiesPtrArr.size()));
+	const int index = enemyPtr->GetPaintListIndex();
+	assert(paintListRef[index] == enemyPtr);
+
+	paintListRef[index] = nullptr;
 
-	delete m_EnemiesPtrArr[enemyIndex];
-	m_EnemiesPtrArr[enemyIndex] = nullptr;
+	enemyPtr->SetPaintListIndex(-1);
 }
 
-void LevelData::TickItemsAndEnemies(double deltaTime, Level* levelPtr)
+void LevelData::DeleteRemovedEntities()
 {
-	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+	if (m_RemovedItemsPtrArr.empty() == false)
 	{
-		if (m_ItemsPtrArr[i] != nullptr)
+		// Close the holes in one pass, keeping the order the items are painted in
+		size_t numKept = 0;
+		for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+		{
+			if (m_ItemsPtrArr[i] == nullptr) continue;
+
+			m_ItemsPtrArr[numKept] = m_ItemsPtrArr[i];
+			m_ItemSlotRecordArr[numKept] = m_ItemSlotRecordArr[i];
+			m_ItemsPtrArr[numKept]->SetLevelDataIndex(int(numKept));
+			++numKept;
+		}
+		m_ItemsPtrArr.resize(numKept);
+		m_ItemSlotRecordArr.resize(numKept);
+
+		for (size_t i = 0; i < m_RemovedItemsPtrArr.size(); ++i)
 		{
-			m_ItemsPtrArr[i]->Tick(deltaTime);
+			delete m_RemovedItemsPtrArr[i];
 		}
+		m_RemovedItemsPtrArr.clear();
 	}
 
-	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
+	if (m_RemovedEnemiesPtrArr.empty() == false)
 	{
-		if (m_EnemiesPtrArr[i] != nullptr)
+		size_t numKept = 0;
+		for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
 		{
-			m_EnemiesPtrArr[i]->Tick(deltaTime);
+			if (m_EnemiesPtrArr[i] == nullptr) continue;
+
+			m_EnemiesPtrArr[numKept] = m_EnemiesPtrArr[i];
+			m_EnemiesPtrArr[numKept]->SetLevelDataIndex(int(numKept));
+			++numKept;
 		}
+		m_EnemiesPtrArr.resize(numKept);
+
+		CompactPaintList(m_BackgroundEnemiesPtrArr);
+		CompactPaintList(m_MainEnemiesPtrArr);
+
+		for (size_t i = 0; i < m_RemovedEnemiesPtrArr.size(); ++i)
+		{
+			delete m_RemovedEnemiesPtrArr[i];
+		}
+		m_RemovedEnemiesPtrArr.clear();
 	}
 }
 
-void LevelData::PaintItemsAndEnemies()
+void LevelData::CompactPaintList(std::vector<Enemy*>& paintListRef)
 {
-	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+	size_t numKept = 0;
+	for (size_t i = 0; i < paintListRef.size(); ++i)
 	{
-		if (m_ItemsPtrArr[i] != nullptr)
+		if (paintListRef[i] == nullptr) continue;
+
+		paintListRef[numKept] = paintListRef[i];
+		paintListRef[numKept]->SetPaintListIndex(int(numKept));
+		++numKept;
+	}
+	paintListRef.resize(numKept);
+}
+
+void LevelData::TickItemsAndEnemies(double deltaTime, Level* levelPtr)
+{
+	const double playerX = levelPtr->GetPlayer()->GetPosition().x;
+	TickEntitiesNearPlayer(m_ItemActivationGrid, playerX, deltaTime);
+	TickEntitiesNearPlayer(m_EnemyActivationGrid, playerX, deltaTime);
+
+	DeleteRemovedEntities();
+}
+
+void LevelData::TickEntitiesNearPlayer(ActivationGrid& gridRef, double playerX, double deltaTime)
+{
+	m_EnteredPtrArr.clear();
+	m_LeftPtrArr.clear();
+	gridRef.Update(playerX, m_EnteredPtrArr, m_LeftPtrArr);
+
+	for (size_t i = 0; i < m_EnteredPtrArr.size(); ++i)
+	{
+		m_EnteredPtrArr[i]->SetActivated(true);
+	}
+	for (size_t i = 0; i < m_LeftPtrArr.size(); ++i)
+	{
+		m_LeftPtrArr[i]->SetActivated(false);
+	}
+
+	// Entities which just went out of range are ticked one last time so they can despawn
+	for (size_t i = 0; i < m_LeftPtrArr.size(); ++i)
+	{
+		if (m_LeftPtrArr[i]->GetLevelDataIndex() != -1)
 		{
-			m_ItemsPtrArr[i]->Paint();
+			m_LeftPtrArr[i]->Tick(deltaTime);
 		}
 	}
 
-	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
+	// NOTE: Walking backwards means an entity which removes itself is replaced by one which has already been ticked.
+	// Entities can remove others as well, so the index has to be checked against the current size each time
+	const std::vector<Entity*>& activePtrArrRef = gridRef.GetActiveEntities();
+	for (int i = int(activePtrArrRef.size()) - 1; i >= 0; --i)
 	{
-		// NOTE: Piranha plants are drawn behind everything else, they are not drawn here!
-		if (m_EnemiesPtrArr[i] != nullptr && m_EnemiesPtrArr[i]->GetType() != Enemy::Type::PIRHANA_PLANT)
+		if (i < int(activePtrArrRef.size()))
 		{
-			m_EnemiesPtrArr[i]->Paint();
+			activePtrArrRef[i]->Tick(deltaTime);
 		}
 	}
-}
 
-void LevelData::PaintItemsInForeground()
-{
-	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+	// Anything which was ticked may have moved into another bucket
+	for (size_t i = 0; i < m_LeftPtrArr.size(); ++i)
 	{
-		if (m_ItemsPtrArr[i] != nullptr)
+		if (m_LeftPtrArr[i]->GetLevelDataIndex() != -1)
 		{
-			if (m_ItemsPtrArr[i]->GetType() == Item::Type::GOAL_GATE ||
-				m_ItemsPtrArr[i]->GetType() == Item::Type::MIDWAY_GATE)
-			{
-				((Gate*)m_ItemsPtrArr[i])->PaintFrontPole();
-			}
+			gridRef.Refresh(m_LeftPtrArr[i]);
 		}
 	}
+	for (size_t i = 0; i < activePtrArrRef.size(); ++i)
+	{
+		gridRef.Refresh(activePtrArrRef[i]);
+	}
 }
 
-void LevelData::PaintEnemiesInBackground()
+void LevelData::PaintBackgroundLayer(ViewCulling& viewCullingRef)
 {
-	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
+	for (size_t i = 0; i < m_BackgroundEnemiesPtrArr.size(); ++i)
 	{
-		if (m_EnemiesPtrArr[i] != nullptr)
+		if (m_BackgroundEnemiesPtrArr[i] != nullptr && viewCullingRef.IsVisible(m_BackgroundEnemiesPtrArr[i]->GetPaintBounds()))
 		{
-			if (m_EnemiesPtrArr[i]->GetType() == Enemy::Type::PIRHANA_PLANT)
-			{
-				m_EnemiesPtrArr[i]->Paint();
-			}
+			m_BackgroundEnemiesPtrArr[i]->Paint();
 		}
 	}
 }
 
-DOUBLE2 LevelData::StringToDOUBLE2(const std::string& DOUBLE2String) const
+void LevelData::PaintMainLayer(ViewCulling& viewCullingRef, Item* heldItemPtr, DOUBLE2 heldItemOffset)
 {
-	DOUBLE2 result;
+	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
+	{
+		if (m_ItemsPtrArr[i] == nullptr || viewCullingRef.IsVisible(m_ItemsPtrArr[i]->GetPaintBounds()) == false) continue;
 
-	int comma = DOUBLE2String.find(',');
+		if (m_ItemsPtrArr[i] == heldItemPtr)
+		{
+			const MATRIX3X2 matPrevWorld = GAME_ENGINE->GetWorldMatrix();
+			GAME_ENGINE->SetWorldMatrix(MATRIX3X2::CreateTranslationMatrix(heldItemOffset) * matPrevWorld);
+			m_ItemsPtrArr[i]->Paint();
+			GAME_ENGINE->SetWorldMatrix(matPrevWorld);
+		}
+		else
+		{
+			m_ItemsPtrArr[i]->Paint();
+		}
+	}
 
-	if (comma != std::string::npos)
+	for (size_t i = 0; i < m_MainEnemiesPtrArr.size(); ++i)
 	{
-		result = DOUBLE2(stod(DOUBLE2String.substr(0, comma)), stod(DOUBLE2String.substr(comma + 1)));
+		if (m_MainEnemiesPtrArr[i] != nullptr && viewCullingRef.IsVisible(m_MainEnemiesPtrArr[i]->GetPaintBounds()))
+		{
+			m_MainEnemiesPtrArr[i]->Paint();
+		}
 	}
-	else
+}
+
+void LevelData::PaintForegroundLayer(ViewCulling& viewCullingRef)
+{
+	for (size_t i = 0; i < m_ForegroundGatesPtrArr.size(); ++i)
 	{
-		OutputDebugString(String("\nERROR: Malformed platform data string: \n") + String(DOUBLE2String.c_str()) + String("\n"));
+		if (viewCullingRef.IsVisible(m_ForegroundGatesPtrArr[i]->GetPaintBounds()))
+		{
+			m_ForegroundGatesPtrArr[i]->PaintFrontPole();
+		}
 	}
-
-	return result;
 }
 
 void LevelData::SetItemsAndEnemiesPaused(bool paused)
 {
 	for (size_t i = 0; i < m_ItemsPtrArr.size(); ++i)
 	{
-		if (m_ItemsPtrArr[i] != nullptr)
-		{
-			m_ItemsPtrArr[i]->SetPaused(paused);
-		}
+		if (m_ItemsPtrArr[i] != nullptr) m_ItemsPtrArr[i]->SetPaused(paused);
 	}
 
 	for (size_t i = 0; i < m_EnemiesPtrArr.size(); ++i)
 	{
-		if (m_EnemiesPtrArr[i] != nullptr)
-		{
-			m_EnemiesPtrArr[i]->SetPaused(paused);
-		}
+		if (m_EnemiesPtrArr[i] != nullptr) m_EnemiesPtrArr[i]->SetPaused(paused);
 	}
 }
 
@@ -512,12 +617,12 @@ std::vector<Pipe*>& LevelData::GetPipes()
 	return m_PipesPtrArr;
 }
 
-std::vector<Item*>& LevelData::GetItems()
+const std::vector<Item*>& LevelData::GetItems() const
 {
 	return m_ItemsPtrArr;
 }
 
-std::vector<Enemy*>& LevelData::GetEnemies()
+const std::vector<Enemy*>& LevelData::GetEnemies() const
 {
 	return m_EnemiesPtrArr;
 }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "LevelDataFile.h"
+#include "ActivationGrid.h"
+
 class Level;
 class Player;
 class Item;
 class Enemy;
 class Platform;
 class Pipe;
+class Entity;
+class Gate;
+struct ViewCulling;
 
 // Holds/updates/paints all entities in the game
 class LevelData
@@ -20,45 +26,86 @@ public:
 	static void UnloadAllLevelData();
 	static void UnloadLevelData(int levelIndex);
 
+	// NOTE: Removed items and enemies stop being ticked and painted straight away, but they are only
+	// deleted once DeleteRemovedEntities is called, so they can safely remove themselves while ticking.
+	// Removing something which has already been removed does nothing
 	void AddItem(Item* newItemPtr);
 	void RemoveItem(Item* itemPtr);
-	void RemoveItem(int itemIndex);
 
 	void AddEnemy(Enemy* newEnemyPtr);
 	void RemoveEnemy(Enemy* enemyPtr);
-	void RemoveEnemy(int enemyIndex);
+
+	void DeleteRemovedEntities();
 
 	Pipe* GetPipeWithIndex(int index) const;
 
-	void PaintEnemiesInBackground(); // These enemies are drawn behind the level image (piranha plants)
-	void PaintItemsAndEnemies();
-	void PaintItemsInForeground(); // These items are drawn in front of the player (Goal gates/ midway gates)
+	// Puts every item and enemy back where the level's spawn data has them, without reading the level from disk.
+	// Platforms and pipes never change so they are kept, items which can reset themselves are reused,
+	// everything else is deleted and spawned again from the spawn template
+	void ResetToSpawnTemplate();
+
+	// Each layer keeps its own list which is updated as entities are added and removed, so painting one is a single walk.
+	// Entities whose paint bounds are outside viewCullingRef's visible rect are skipped
+	void PaintBackgroundLayer(ViewCulling& viewCullingRef); // Drawn behind the level image (piranha plants)
+	// Every item, then every other enemy. heldItemPtr (may be nullptr) is painted moved by heldItemOffset
+	void PaintMainLayer(ViewCulling& viewCullingRef, Item* heldItemPtr, DOUBLE2 heldItemOffset);
+	void PaintForegroundLayer(ViewCulling& viewCullingRef); // Drawn in front of the player (goal gate and midway gate front poles)
+	// Only items and enemies near the player are ticked, see ActivationGrid. Items for which IsAlwaysActive is true are always ticked
 	void TickItemsAndEnemies(double deltaTime, Level* levelPtr);
 
 	void SetItemsAndEnemiesPaused(bool paused);
 
 	std::vector<Platform*>& GetPlatforms();
 	std::vector<Pipe*>& GetPipes();
-	std::vector<Item*>& GetItems();
-	std::vector<Enemy*>& GetEnemies();
+	// NOTE: Entities removed since the last DeleteRemovedEntities leave nullptr in their place,
+	// the rest stay in the order they were added
+	const std::vector<Item*>& GetItems() const;
+	const std::vector<Enemy*>& GetEnemies() const;
 
 private:
-	LevelData(const std::string& platforms, const std::string& pipes, const std::string& items, const std::string& enemies, Level* levelPtr);
+	LevelData(const LevelDataFile* spawnTemplatePtr, Level* levelPtr);
 
 	static LevelData* CreateLevelData(int levelIndex, Level* levelPtr);
 
+	Item* SpawnItem(const LevelDataFile::ItemRecord& recordRef);
+	void SpawnEnemies();
+	void AddItem(Item* newItemPtr, int recordIndex);
+	void RemoveFromPaintList(std::vector<Enemy*>& paintListRef, Enemy* enemyPtr);
+	static void CompactPaintList(std::vector<Enemy*>& paintListRef);
+	void TickEntitiesNearPlayer(ActivationGrid& gridRef, double playerX, double deltaTime);
+
 	static std::vector<LevelData*> m_LevelDataPtrArr;
+	// Each level's spawn data is only read once, it stays loaded until UnloadAllLevelData is called
+	static std::vector<LevelDataFile*> m_SpawnTemplatePtrArr;
 
 	// Everything is stored in terms of tile col/row, we need to multiply by
 	// this scale to get actual world coordinates
 	static const int TILE_SIZE = 16;
 
 	Level* m_LevelPtr = nullptr;
-
-	DOUBLE2 StringToDOUBLE2(const std::string& double2String) const;
+	const LevelDataFile* m_SpawnTemplatePtr = nullptr;
 
 	std::vector<Platform*> m_PlatformsPtrArr;
 	std::vector<Pipe*> m_PipesPtrArr;
+	// Every live item and enemy, in the order they were added. Each one knows its own index so it can be removed in constant time
 	std::vector<Item*> m_ItemsPtrArr;
+	// The index of the spawn template record each item slot was spawned from, -1 for items added during play
+	std::vector<int> m_ItemSlotRecordArr;
 	std::vector<Enemy*> m_EnemiesPtrArr;
+
+	// Removed, waiting for DeleteRemovedEntities
+	std::vector<Item*> m_RemovedItemsPtrArr;
+	std::vector<Enemy*> m_RemovedEnemiesPtrArr;
+
+	// Paint lists, items are all on the main layer so m_ItemsPtrArr is painted directly
+	std::vector<Enemy*> m_BackgroundEnemiesPtrArr;
+	std::vector<Enemy*> m_MainEnemiesPtrArr;
+	std::vector<Gate*> m_ForegroundGatesPtrArr;
+
+	// Items and enemies are activated at different distances from the player
+	ActivationGrid m_ItemActivationGrid;
+	ActivationGrid m_EnemyActivationGrid;
+	// Filled by the activation grids every tick, kept around so they don't have to allocate
+	std::vector<Entity*> m_EnteredPtrArr;
+	std::vector<Entity*> m_LeftPtrArr;
 };
@@ -0,0 +1,477 @@
+#include "stdafx.h"
+
+#include "LevelDataFile.h"
+#include "Enumerations.h"
+#include "FileIO.h"
+#include "SMWColour.h"
+#include "Pipe.h"
+#include "Item.h"
+#include "Enemy.h"
+#include "MontyMole.h"
+
+#include <cerrno>
+#include <climits>
+
+const char LevelDataFile::MAGIC[4] = { 'S', 'M', 'W', 'L' };
+
+LevelDataFile::LevelDataFile()
+{
+}
+
+LevelDataFile::~LevelDataFile()
+{
+	Unload();
+}
+
+bool LevelDataFile::CompileAllLevels()
+{
+	bool succeeded = true;
+	for (int i = 0; i < Constants::NUM_LEVELS; ++i)
+	{
+		succeeded = CompileLevel(i) && succeeded;
+	}
+	return succeeded;
+}
+
+bool LevelDataFile::CompileLevel(int levelIndex)
+{
+	const std::string levelDirectory = GetLevelDirectory(levelIndex);
+
+	std::vector<char> dataArr;
+	if (ParseText(levelDirectory + "level-data.txt", dataArr) == false)
+	{
+		OutputDebugString(String(("ERROR: Unable to compile " + levelDirectory + "level-data.txt\n").c_str()));
+		return false;
+	}
+
+	std::ofstream fileOutStream;
+	fileOutStream.open(levelDirectory + "level-data.bin", std::ios::binary);
+	if (fileOutStream.fail())
+	{
+		OutputDebugString(String(("ERROR: Unable to write " + levelDirectory + "level-data.bin\n").c_str()));
+		return false;
+	}
+
+	fileOutStream.write(dataArr.data(), dataArr.size());
+	fileOutStream.close();
+
+	return true;
+}
+
+bool LevelDataFile::Load(int levelIndex)
+{
+	Unload();
+
+	const std::string levelDirectory = GetLevelDirectory(levelIndex);
+	const std::string textFilePath = levelDirectory + "level-data.txt";
+	const std::string binaryFilePath = levelDirectory + "level-data.bin";
+
+	if (IsBinaryUpToDate(textFilePath, binaryFilePath) && MapBinary(binaryFilePath))
+	{
+		return true;
+	}
+
+	if (ParseText(textFilePath, m_ParsedDataArr) == false)
+	{
+		return false;
+	}
+	m_DataPtr = m_ParsedDataArr.data();
+	m_HeaderPtr = (const Header*)m_DataPtr;
+
+	return true;
+}
+
+void LevelDataFile::Unload()
+{
+	if (m_FileMappingHandle != NULL)
+	{
+		if (m_DataPtr != nullptr) UnmapViewOfFile(m_DataPtr);
+		CloseHandle(m_FileMappingHandle);
+		m_FileMappingHandle = NULL;
+	}
+	if (m_FileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_FileHandle);
+		m_FileHandle = INVALID_HANDLE_VALUE;
+	}
+
+	m_ParsedDataArr.clear();
+	m_DataPtr = nullptr;
+	m_HeaderPtr = nullptr;
+}
+
+bool LevelDataFile::MapBinary(const std::string& filePath)
+{
+	m_FileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_FileHandle == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(m_FileHandle, &fileSize) == FALSE || fileSize.QuadPart < LONGLONG(sizeof(Header)))
+	{
+		Unload();
+		return false;
+	}
+
+	m_FileMappingHandle = CreateFileMappingA(m_FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_FileMappingHandle == NULL)
+	{
+		Unload();
+		return false;
+	}
+
+	m_DataPtr = (const char*)MapViewOfFile(m_FileMappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (m_DataPtr == nullptr || IsValid(m_DataPtr, size_t(fileSize.QuadPart)) == false)
+	{
+		OutputDebugString(String(("ERROR: Invalid compiled level " + filePath + ", reading the text version instead\n").c_str()));
+		Unload();
+		return false;
+	}
+	m_HeaderPtr = (const Header*)m_DataPtr;
+
+	return true;
+}
+
+bool LevelDataFile::IsValid(const char* dataPtr, size_t size) const
+{
+	if (size < sizeof(Header)) return false;
+
+	const Header* headerPtr = (const Header*)dataPtr;
+	if (memcmp(headerPtr->m_Magic, MAGIC, sizeof(MAGIC)) != 0 || headerPtr->m_Version != VERSION)
+	{
+		return false;
+	}
+
+	// Take every section off what's left of the file rather than adding up the section sizes,
+	// so a corrupt record count can't overflow into a size which happens to match
+	size_t remainingSize = size - sizeof(Header);
+	if (TakeSection(remainingSize, headerPtr->m_NumPlatforms, sizeof(PlatformRecord)) == false ||
+		TakeSection(remainingSize, headerPtr->m_NumPipes, sizeof(PipeRecord)) == false ||
+		TakeSection(remainingSize, headerPtr->m_NumItems, sizeof(ItemRecord)) == false ||
+		TakeSection(remainingSize, headerPtr->m_NumEnemies, sizeof(EnemyRecord)) == false)
+	{
+		return false;
+	}
+
+	// The string table always starts with the empty string and ends in a null terminator
+	const unsigned int stringTableSize = headerPtr->m_StringTableSize;
+	if (remainingSize != stringTableSize || stringTableSize == 0 || dataPtr[size - 1] != '\0')
+	{
+		return false;
+	}
+
+	// Since the table ends in a null terminator, every offset inside it reads a terminated string
+	const ItemRecord* itemsPtr = (const ItemRecord*)(dataPtr + sizeof(Header) +
+		headerPtr->m_NumPlatforms * sizeof(PlatformRecord) +
+		headerPtr->m_NumPipes * sizeof(PipeRecord));
+	for (unsigned int i = 0; i < headerPtr->m_NumItems; ++i)
+	{
+		if (itemsPtr[i].m_SpawnsOffset >= stringTableSize || itemsPtr[i].m_MessageTextOffset >= stringTableSize)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool LevelDataFile::TakeSection(size_t& remainingSizeRef, unsigned int numRecords, size_t recordSize)
+{
+	if (numRecords > remainingSizeRef / recordSize) return false;
+
+	remainingSizeRef -= numRecords * recordSize;
+	return true;
+}
+
+bool LevelDataFile::ParseInt(const std::string& string, int& valueRef)
+{
+	if (string.empty()) return false;
+
+	char* endPtr = nullptr;
+	errno = 0;
+	const long value = strtol(string.c_str(), &endPtr, 10);
+	if (errno != 0 || *endPtr != '\0' || value < INT_MIN || value > INT_MAX) return false;
+
+	valueRef = int(value);
+	return true;
+}
+
+bool LevelDataFile::ParseDouble(const std::string& string, double& valueRef)
+{
+	if (string.empty()) return false;
+
+	char* endPtr = nullptr;
+	errno = 0;
+	const double value = strtod(string.c_str(), &endPtr);
+	if (errno != 0 || *endPtr != '\0') return false;
+
+	valueRef = value;
+	return true;
+}
+
+bool LevelDataFile::ParseError(const std::string& filePath, const std::string& tagName, const std::string& value)
+{
+	OutputDebugString(String(("ERROR: Invalid " + tagName + " \"" + value + "\" in " + filePath + "\n").c_str()));
+	return false;
+}
+
+bool LevelDataFile::IsBinaryUpToDate(const std::string& textFilePath, const std::string& binaryFilePath)
+{
+	WIN32_FILE_ATTRIBUTE_DATA binaryAttributes;
+	if (GetFileAttributesExA(binaryFilePath.c_str(), GetFileExInfoStandard, &binaryAttributes) == FALSE)
+	{
+		return false;
+	}
+
+	WIN32_FILE_ATTRIBUTE_DATA textAttributes;
+	if (GetFileAttributesExA(textFilePath.c_str(), GetFileExInfoStandard, &textAttributes) == FALSE)
+	{
+		return true; // Only the compiled version was shipped
+	}
+
+	return CompareFileTime(&binaryAttributes.ftLastWriteTime, &textAttributes.ftLastWriteTime) >= 0;
+}
+
+std::string LevelDataFile::GetLevelDirectory(int levelIndex)
+{
+	std::stringstream levelIndexStr;
+	levelIndexStr << std::setw(2) << std::setfill('0') << levelIndex;
+	return "Resources/levels/" + levelIndexStr.str() + "/";
+}
+
+unsigned int LevelDataFile::AddString(std::vector<char>& stringTableRef, const std::string& string)
+{
+	if (string.empty()) return 0;
+
+	const unsigned int offset = stringTableRef.size();
+	stringTableRef.insert(stringTableRef.end(), string.begin(), string.end());
+	stringTableRef.push_back('\0');
+	return offset;
+}
+
+bool LevelDataFile::ParseText(const std::string& filePath, std::vector<char>& dataRef)
+{
+	std::ifstream fileInStream;
+	std::stringstream stringStream;
+
+	fileInStream.open(filePath);
+	if (fileInStream.fail())
+	{
+		return false;
+	}
+
+	std::string line;
+	while (fileInStream.eof() == false)
+	{
+		std::getline(fileInStream, line);
+		stringStream << line << "\n";
+	}
+	fileInStream.close();
+
+	std::string entireFileContents = stringStream.str();
+
+	std::string platforms = FileIO::GetTagContent(entireFileContents, "Platforms");
+	platforms.erase(std::remove_if(platforms.begin(), platforms.end(), IsWhitespace()), platforms.end());
+
+	std::string pipes = FileIO::GetTagContent(entireFileContents, "Pipes");
+	pipes.erase(std::remove_if(pipes.begin(), pipes.end(), IsWhitespace()), pipes.end());
+
+	std::string items = FileIO::GetTagContent(entireFileContents, "Items");
+	items.erase(std::remove_if(items.begin(), items.end(), IsWhitespace()), items.end());
+
+	std::string enemies = FileIO::GetTagContent(entireFileContents, "Enemies");
+	enemies.erase(std::remove_if(enemies.begin(), enemies.end(), IsWhitespace()), enemies.end());
+
+	std::vector<PlatformRecord> platformRecordsArr;
+	std::vector<PipeRecord> pipeRecordsArr;
+	std::vector<ItemRecord> itemRecordsArr;
+	std::vector<EnemyRecord> enemyRecordsArr;
+	std::vector<char> stringTableArr(1, '\0');
+
+	// PLATFORMS
+	size_t platformTagBeginIndex = 0;
+	while ((platformTagBeginIndex = platforms.find("<Platform>", platformTagBeginIndex)) != std::string::npos)
+	{
+		std::string platformContent = FileIO::GetTagContent(platforms, "Platform", platformTagBeginIndex);
+		++platformTagBeginIndex;
+
+		int comma1 = platformContent.find(",");
+		int comma2 = platformContent.find(",", comma1 + 1);
+
+		PlatformRecord record = {};
+		if (comma1 == -1 || comma2 == -1 ||
+			ParseInt(platformContent.substr(0, comma1), record.m_Left) == false ||
+			ParseInt(platformContent.substr(comma1 + 1, comma2 - comma1 - 1), record.m_Top) == false ||
+			ParseInt(platformContent.substr(comma2 + 1), record.m_Right) == false)
+		{
+			return ParseError(filePath, "Platform", platformContent);
+		}
+		platformRecordsArr.push_back(record);
+	}
+
+	// PIPES
+	size_t pipeTagBeginIndex = 0;
+	while ((pipeTagBeginIndex = pipes.find("<Pipe>", pipeTagBeginIndex)) != std::string::npos)
+	{
+		std::string pipeContent = FileIO::GetTagContent(pipes, "Pipe", pipeTagBeginIndex);
+		++pipeTagBeginIndex;
+
+		RECT2 boundingBox = FileIO::StringToRECT2(FileIO::GetTagContent(pipeContent, "BoundingBox"));
+
+		PipeRecord record = {};
+		record.m_Left = boundingBox.left;
+		record.m_Top = boundingBox.top;
+		record.m_Right = boundingBox.right;
+		record.m_Bottom = boundingBox.bottom;
+		record.m_Orientation = int(Pipe::StringToOrientation(FileIO::GetTagContent(pipeContent, "Orientation")));
+		record.m_SpawnsPiranhaPlant = FileIO::GetTagContent(pipeContent, "Spawns") == "PiranhaPlant";
+
+		std::string warpLevelIndexStr = FileIO::GetTagContent(pipeContent, "WarpLevelIndex");
+		record.m_WarpLevelIndex = -1;
+		if (warpLevelIndexStr.length() > 0 && ParseInt(warpLevelIndexStr, record.m_WarpLevelIndex) == false)
+		{
+			return ParseError(filePath, "WarpLevelIndex", warpLevelIndexStr);
+		}
+
+		std::string warpPipeIndexStr = FileIO::GetTagContent(pipeContent, "WarpPipeIndex");
+		record.m_WarpPipeIndex = -1;
+		if (warpPipeIndexStr.length() > 0 && ParseInt(warpPipeIndexStr, record.m_WarpPipeIndex) == false)
+		{
+			return ParseError(filePath, "WarpPipeIndex", warpPipeIndexStr);
+		}
+
+		pipeRecordsArr.push_back(record);
+	}
+
+	// ITEMS
+	size_t itemTagBeginIndex = 0;
+	while ((itemTagBeginIndex = items.find("<Item>", itemTagBeginIndex)) != std::string::npos)
+	{
+		std::string itemContent = FileIO::GetTagContent(items, "Item", itemTagBeginIndex);
+		++itemTagBeginIndex;
+
+		const std::string topLeftString = FileIO::GetTagContent(itemContent, "TopLeft");
+		const int comma = topLeftString.find(',');
+		const std::string itemTypeString = FileIO::GetTagContent(itemContent, "Type");
+
+		ItemRecord record = {};
+		if (comma == -1 ||
+			ParseDouble(topLeftString.substr(0, comma), record.m_Left) == false ||
+			ParseDouble(topLeftString.substr(comma + 1), record.m_Top) == false)
+		{
+			return ParseError(filePath, "TopLeft", topLeftString);
+		}
+		record.m_Type = int(Item::StringToTYPE(itemTypeString));
+		// NOTE: Not all items have the following properties, but there is no harm is seeing if a tag is there
+		record.m_Colour = int(SMWColour::StringToCOLOUR(FileIO::GetTagContent(itemContent, "Colour")));
+		record.m_IsFlyer = FileIO::GetTagContent(itemContent, "Flyer").length() > 0;
+		record.m_SpawnsOffset = AddString(stringTableArr, FileIO::GetTagContent(itemContent, "Spawns"));
+		record.m_MessageTextOffset = AddString(stringTableArr, FileIO::GetTagContent(itemContent, "MessageText"));
+
+		if (record.m_Type == int(Item::Type::MIDWAY_GATE))
+		{
+			const std::string barHeightString = FileIO::GetTagContent(itemContent, "BarHeight");
+			if (ParseInt(barHeightString, record.m_BarHeight) == false)
+			{
+				return ParseError(filePath, "BarHeight", barHeightString);
+			}
+		}
+
+		itemRecordsArr.push_back(record);
+	}
+
+	// ENEMIES
+	size_t enemyTagBeginIndex = 0;
+	while ((enemyTagBeginIndex = enemies.find("<Enemy>", enemyTagBeginIndex)) != std::string::npos)
+	{
+		std::string enemyContent = FileIO::GetTagContent(enemies, "Enemy", enemyTagBeginIndex);
+		++enemyTagBeginIndex;
+
+		const std::string topLeftString = FileIO::GetTagContent(enemyContent, "TopLeft");
+		const int comma = topLeftString.find(',');
+
+		EnemyRecord record = {};
+		if (comma == -1 ||
+			ParseDouble(topLeftString.substr(0, comma), record.m_Left) == false ||
+			ParseDouble(topLeftString.substr(comma + 1), record.m_Top) == false)
+		{
+			return ParseError(filePath, "TopLeft", topLeftString);
+		}
+		record.m_Type = int(Enemy::StringToTYPE(FileIO::GetTagContent(enemyContent, "Type")));
+		record.m_Colour = int(SMWColour::StringToCOLOUR(FileIO::GetTagContent(enemyContent, "Colour")));
+
+		if (record.m_Type == int(Enemy::Type::MONTY_MOLE))
+		{
+			record.m_AIType = int(MontyMole::StringToAIType(FileIO::GetTagContent(enemyContent, "AIType")));
+			record.m_SpawnLocationType = int(MontyMole::StringToSpawnLocationType(FileIO::GetTagContent(enemyContent, "SpawnLocationType")));
+		}
+
+		enemyRecordsArr.push_back(record);
+	}
+
+	Header header = {};
+	memcpy(header.m_Magic, MAGIC, sizeof(MAGIC));
+	header.m_Version = VERSION;
+	header.m_NumPlatforms = platformRecordsArr.size();
+	header.m_NumPipes = pipeRecordsArr.size();
+	header.m_NumItems = itemRecordsArr.size();
+	header.m_NumEnemies = enemyRecordsArr.size();
+	header.m_StringTableSize = stringTableArr.size();
+
+	dataRef.clear();
+	dataRef.insert(dataRef.end(), (const char*)&header, (const char*)&header + sizeof(Header));
+	dataRef.insert(dataRef.end(), (const char*)platformRecordsArr.data(), (const char*)(platformRecordsArr.data() + platformRecordsArr.size()));
+	dataRef.insert(dataRef.end(), (const char*)pipeRecordsArr.data(), (const char*)(pipeRecordsArr.data() + pipeRecordsArr.size()));
+	dataRef.insert(dataRef.end(), (const char*)itemRecordsArr.data(), (const char*)(itemRecordsArr.data() + itemRecordsArr.size()));
+	dataRef.insert(dataRef.end(), (const char*)enemyRecordsArr.data(), (const char*)(enemyRecordsArr.data() + enemyRecordsArr.size()));
+	dataRef.insert(dataRef.end(), stringTableArr.begin(), stringTableArr.end());
+
+	return true;
+}
+
+int LevelDataFile::GetNumPlatforms() const
+{
+	return m_HeaderPtr->m_NumPlatforms;
+}
+
+int LevelDataFile::GetNumPipes() const
+{
+	return m_HeaderPtr->m_NumPipes;
+}
+
+int LevelDataFile::GetNumItems() const
+{
+	return m_HeaderPtr->m_NumItems;
+}
+
+int LevelDataFile::GetNumEnemies() const
+{
+	return m_HeaderPtr->m_NumEnemies;
+}
+
+const LevelDataFile::PlatformRecord* LevelDataFile::GetPlatforms() const
+{
+	return (const PlatformRecord*)(m_DataPtr + sizeof(Header));
+}
+
+const LevelDataFile::PipeRecord* LevelDataFile::GetPipes() const
+{
+	return (const PipeRecord*)(GetPlatforms() + GetNumPlatforms());
+}
+
+const LevelDataFile::ItemRecord* LevelDataFile::GetItems() const
+{
+	return (const ItemRecord*)(GetPipes() + GetNumPipes());
+}
+
+const LevelDataFile::EnemyRecord* LevelDataFile::GetEnemies() const
+{
+	return (const EnemyRecord*)(GetItems() + GetNumItems());
+}
+
+const char* LevelDataFile::GetString(unsigned int offset) const
+{
+	assert(offset < m_HeaderPtr->m_StringTableSize);
+
+	const char* stringTablePtr = (const char*)(GetEnemies() + GetNumEnemies());
+	return stringTablePtr + offset;
+}
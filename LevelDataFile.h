@@ -0,0 +1,116 @@
+#pragma once
+
+// A level's spawn data compiled into one flat block of typed records:
+// a header, then every platform, pipe, item and enemy record, then the string table.
+// Compiled levels (level-data.bin) are memory mapped and read in place, levels which
+// haven't been compiled (or were edited since) are parsed from level-data.txt into the same layout
+class LevelDataFile
+{
+public:
+	struct Header
+	{
+		char m_Magic[4];
+		unsigned int m_Version;
+		unsigned int m_NumPlatforms;
+		unsigned int m_NumPipes;
+		unsigned int m_NumItems;
+		unsigned int m_NumEnemies;
+		unsigned int m_StringTableSize;
+		unsigned int m_Padding;
+	};
+
+	// All positions are in tiles
+	struct PlatformRecord
+	{
+		int m_Left;
+		int m_Top;
+		int m_Right;
+		int m_Padding;
+	};
+
+	struct PipeRecord
+	{
+		double m_Left;
+		double m_Top;
+		double m_Right;
+		double m_Bottom;
+		int m_Orientation; // Pipe::Orientation
+		int m_WarpLevelIndex;
+		int m_WarpPipeIndex;
+		int m_SpawnsPiranhaPlant;
+	};
+
+	struct ItemRecord
+	{
+		double m_Left;
+		double m_Top;
+		int m_Type; // Item::Type
+		int m_Colour;
+		int m_IsFlyer;
+		int m_BarHeight;
+		// Offsets into the string table, 0 is the empty string
+		unsigned int m_SpawnsOffset;
+		unsigned int m_MessageTextOffset;
+	};
+
+	struct EnemyRecord
+	{
+		double m_Left;
+		double m_Top;
+		int m_Type; // Enemy::Type
+		int m_Colour;
+		int m_AIType; // MontyMole::AIType
+		int m_SpawnLocationType; // MontyMole::SpawnLocationType
+	};
+
+	LevelDataFile();
+	virtual ~LevelDataFile();
+
+	LevelDataFile(const LevelDataFile&) = delete;
+	LevelDataFile& operator=(const LevelDataFile&) = delete;
+
+	// Parses every level's level-data.txt and writes it out as level-data.bin
+	static bool CompileAllLevels();
+	static bool CompileLevel(int levelIndex);
+
+	// Maps the compiled level if it is up to date, otherwise parses the text version
+	bool Load(int levelIndex);
+	void Unload();
+
+	int GetNumPlatforms() const;
+	int GetNumPipes() const;
+	int GetNumItems() const;
+	int GetNumEnemies() const;
+	const PlatformRecord* GetPlatforms() const;
+	const PipeRecord* GetPipes() const;
+	const ItemRecord* GetItems() const;
+	const EnemyRecord* GetEnemies() const;
+	const char* GetString(unsigned int offset) const;
+
+private:
+	static std::string GetLevelDirectory(int levelIndex);
+	static bool ParseText(const std::string& filePath, std::vector<char>& dataRef);
+	static unsigned int AddString(std::vector<char>& stringTableRef, const std::string& string);
+	static bool IsBinaryUpToDate(const std::string& textFilePath, const std::string& binaryFilePath);
+	// strtol/strtod which fail on anything but a whole number, instead of throwing like stoi/stod
+	static bool ParseInt(const std::string& string, int& valueRef);
+	static bool ParseDouble(const std::string& string, double& valueRef);
+	// Reports the malformed value and returns false
+	static bool ParseError(const std::string& filePath, const std::string& tagName, const std::string& value);
+	// Takes numRecords records off the remaining size, fails if they don't fit
+	static bool TakeSection(size_t& remainingSizeRef, unsigned int numRecords, size_t recordSize);
+
+	bool MapBinary(const std::string& filePath);
+	bool IsValid(const char* dataPtr, size_t size) const;
+
+	static const char MAGIC[4];
+	static const unsigned int VERSION = 1;
+
+	// Points either into the mapped view or into m_ParsedDataArr
+	const char* m_DataPtr = nullptr;
+	const Header* m_HeaderPtr = nullptr;
+
+	HANDLE m_FileHandle = INVALID_HANDLE_VALUE;
+	HANDLE m_FileMappingHandle = NULL;
+	std::vector<char> m_ParsedDataArr;
+};
@@ -4,6 +4,7 @@
 #include "Enumerations.h"
 #include "SpriteSheetManager.h"
 #include "Pipe.h"
+#include "ChunkedBitmap.h"
 
 std::vector<LevelProperties> LevelProperties::m_AllLevelPropertiesArr = std::vector<LevelProperties>(Constants::NUM_LEVELS);
 
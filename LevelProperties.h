@@ -4,6 +4,7 @@
 #include "SoundManager.h"
 
 class Pipe;
+class ChunkedBitmap;
 
 // This class represents all static data necessary to create a level (for entities see LevelData)
 struct LevelProperties
@@ -13,7 +14,7 @@ struct LevelProperties
 	Bitmap* m_BmpBackgroundPtr;
 	// Leave this set to -1 if the background doen't animate
 	int m_NumberOfBackgroundAnimationFrames = -1; 
-	Bitmap* m_BmpForegroundPtr;
+	ChunkedBitmap* m_BmpForegroundPtr;
 	SoundManager::Song m_BackgroundMusic;
 	SoundManager::Song m_BackgroundMusicFast;
 	int m_Width;
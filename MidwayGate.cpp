@@ -67,6 +67,11 @@ void MidwayGate::PaintFrontPole()
 	GAME_ENGINE->DrawBitmap(SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::GENERAL_TILES)->GetBitmap(), DOUBLE2(x, y), srcRect);
 }
 
+RECT2 MidwayGate::GetPaintBounds()
+{
+	return RECT2(m_TopLeft.x, m_TopLeft.y, m_TopLeft.x + TILES_WIDE * TILE_SIZE, m_TopLeft.y + TILES_HIGH * TILE_SIZE);
+}
+
 void MidwayGate::Hit()
 {
 	m_IsHit = true;
@@ -8,10 +8,7 @@
 #include "Player.h"
 #include "SoundManager.h"
 
-#include "DustParticle.h"
 #include "BlockBreakParticle.h"
-#include "EnemyPoofParticle.h"
-#include "SplatParticle.h"
 
 const double MontyMole::HORIZONTAL_ACCELERATION = 880.0;
 const double MontyMole::MAX_HORIZONTAL_VEL = 125.0;
@@ -45,24 +42,6 @@ MontyMole::~MontyMole()
 
 void MontyMole::Tick(double deltaTime)
 {
-	if (m_ActPtr != nullptr)
-	{
-		bool wasActive = m_IsActive;
-		Enemy::Tick(deltaTime);
-		if (wasActive && m_IsActive == false)
-		{
-			m_ActPtr->SetPosition(m_SpawingPosition);
-			m_ActPtr->SetActive(false);
-			m_ActPtr->SetSensor(true);
-			m_AnimationState = AnimationState::IN_GROUND;
-			return;
-		}
-		else if (wasActive == false && m_IsActive)
-		{
-			m_FramesSpentWrigglingInDirtTimer.Start();
-		}
-	}
-
 	if (m_IsActive == false) return;
 
 	m_AnimInfo.Tick(deltaTime);
@@ -204,18 +183,17 @@ void MontyMole::UpdatePosition(double deltaTime)
 		// Just walk forward, jumping periodically, until you hit a wall, at which point turn around
 
 		// Test if we're running into an obstacle
-		DOUBLE2 point1 = m_ActPtr->GetPosition();
-		DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
-		DOUBLE2 intersection, normal;
-		double fraction = -1.0;
-		int collisionBits = Level::LEVEL | Level::BLOCK;
-		if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+		if (m_WallProbe.m_Hit)
 		{
 			// Turn around
 			m_DirFacing = -m_DirFacing;
 			CalculateNewTarget();
 		}
 
+		m_WallProbe.m_Offset = DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
+		m_WallProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+		SubmitProbe(m_WallProbe);
+
 		// See if it's time to hop again
 		if (prevVel.y == 0 &&
 			m_FramesSinceLastHop.Tick() && m_FramesSinceLastHop.IsComplete())
@@ -238,8 +216,7 @@ void MontyMole::UpdatePosition(double deltaTime)
 		((horizontalDelta > 0 && prevVel.x < 0) ||
 			(horizontalDelta < 0 && prevVel.x > 0)))
 	{
-		DustParticle* dustParticlePtr = new DustParticle(m_ActPtr->GetPosition() + DOUBLE2(0, GetHeight() / 2 + 1));
-		m_LevelPtr->AddParticle(dustParticlePtr);
+		m_LevelPtr->AddParticle(SpriteParticleStore::Kind::DUST, m_ActPtr->GetPosition() + DOUBLE2(0, GetHeight() / 2 + 1));
 
 		m_SpawnDustCloudTimer.Start();
 	}
@@ -271,8 +248,7 @@ void MontyMole::HeadBonk()
 
 		m_ActPtr->SetLinearVelocity(DOUBLE2(0.0, 0.0));
 
-		SplatParticle* splatParticlePtr = new SplatParticle(m_ActPtr->GetPosition());
-		m_LevelPtr->AddParticle(splatParticlePtr);
+		m_LevelPtr->AddParticle(SpriteParticleStore::Kind::SPLAT, m_ActPtr->GetPosition());
 
 		m_LevelPtr->GetPlayer()->AddScore(200, true, m_ActPtr->GetPosition());
 
@@ -286,8 +262,7 @@ void MontyMole::StompKill()
 	SoundManager::PlaySoundEffect(SoundManager::Sound::ENEMY_HEAD_STOMP_START);
 	SoundManager::PlaySoundEffect(SoundManager::Sound::ENEMY_HEAD_STOMP_END);
 
-	EnemyPoofParticle* poofParticlePtr = new EnemyPoofParticle(m_ActPtr->GetPosition());
-	m_LevelPtr->AddParticle(poofParticlePtr);
+	m_LevelPtr->AddEnemyPoofParticles(m_ActPtr->GetPosition());
 
 	m_LevelPtr->GetPlayer()->AddScore(200, true, m_ActPtr->GetPosition());
 
@@ -295,6 +270,21 @@ void MontyMole::StompKill()
 	m_ShouldRemoveActor = true;
 }
 
+RECT2 MontyMole::GetPaintBounds()
+{
+	RECT2 bounds(m_SpawingPosition.x - PAINT_EXTENT, m_SpawingPosition.y - PAINT_EXTENT,
+		m_SpawingPosition.x + PAINT_EXTENT, m_SpawingPosition.y + PAINT_EXTENT);
+	if (m_ActPtr != nullptr)
+	{
+		const RECT2 bodyBounds = Entity::GetPaintBounds();
+		bounds.left = min(bounds.left, bodyBounds.left);
+		bounds.top = min(bounds.top, bodyBounds.top);
+		bounds.right = max(bounds.right, bodyBounds.right);
+		bounds.bottom = max(bounds.bottom, bodyBounds.bottom);
+	}
+	return bounds;
+}
+
 void MontyMole::Paint()
 {
 	if (m_SpawnLocationType == SpawnLocationType::WALL && m_HaveSpawnedMole)
@@ -395,6 +385,24 @@ MontyMole::SpawnLocationType MontyMole::StringToSpawnLocationType(std::string sp
 	}
 }
 
+void MontyMole::SetActivated(bool activated)
+{
+	// NOTE: Once our actor is gone we stay as we are
+	if (m_ActPtr != nullptr && m_IsActive && activated == false)
+	{
+		m_ActPtr->SetPosition(m_SpawingPosition);
+		m_ActPtr->SetActive(false);
+		m_ActPtr->SetSensor(true);
+		m_AnimationState = AnimationState::IN_GROUND;
+	}
+	else if (m_ActPtr != nullptr && m_IsActive == false && activated)
+	{
+		m_FramesSpentWrigglingInDirtTimer.Start();
+	}
+
+	Enemy::SetActivated(activated);
+}
+
 void MontyMole::SetPaused(bool paused)
 {
 	if (m_ActPtr == nullptr) return;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Enemy.h"
+#include "ProbeService.h"
 
 struct INT2;
 
@@ -50,6 +51,8 @@ public:
 
 	void Tick(double deltaTime);
 	void Paint();
+	// Also covers the hole left in the wall, which is painted even once the mole has no body
+	RECT2 GetPaintBounds();
 	INT2 GetAnimationFrame();
 
 	int GetWidth() const;
@@ -62,6 +65,7 @@ public:
 	void SetDead();
 
 	void SetPaused(bool paused);
+	void SetActivated(bool activated) override;
 	bool Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef);
 
 	static AIType StringToAIType(std::string aiTypeString);
@@ -90,6 +94,7 @@ private:
 	SMWTimer m_FramesSinceLastHop; // Only used by "dumb" moles
 
 	double m_TargetX;
+	Probe m_WallProbe; // Only used by "dumb" moles
 
 	bool m_HasBeenKilledByPlayer = false;
 	bool m_HaveSpawnedMole = false;
@@ -31,7 +31,6 @@ MoveableItem::MoveableItem(DOUBLE2 topLeft, Type itemType, int spriteSheetXIndex
 
 void MoveableItem::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
 	if (m_IsActive == false)
 	{
 		m_LevelPtr->RemoveItem(this); // Once we are no longer active, we just despawn
@@ -54,17 +53,16 @@ void MoveableItem::Tick(double deltaTime)
 	}
 	else
 	{
-		DOUBLE2 point1 = m_ActPtr->GetPosition();
-		DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * 7, 0);
-		DOUBLE2 intersection, normal;
-		double fraction = -1.0;
-
-		// If this returns true, we are about to hit an obstacle, let's turn around
-		if (m_LevelPtr->Raycast(point1, point2, m_CollisionBits, intersection, normal, fraction))
+		// If this hit, we are about to hit an obstacle, let's turn around
+		if (m_WallProbe.m_Hit)
 		{
 			m_DirFacing = -m_DirFacing;
 		}
 
+		m_WallProbe.m_Offset = DOUBLE2(m_DirFacing * 7, 0);
+		m_WallProbe.m_CollisionBits = m_CollisionBits;
+		SubmitProbe(m_WallProbe);
+
 		// Remove items which fall off the left edge of the level
 		if (m_ActPtr->GetPosition().x < -WIDTH)
 		{
@@ -27,6 +27,7 @@ public:
 private:
 	static const int HORIZONTAL_VEL = 80;
 	const int m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	Probe m_WallProbe;
 
 	INT2 m_SpriteSheetIndex;
 
@@ -5,7 +5,6 @@
 #include "SpriteSheet.h"
 #include "SoundManager.h"
 #include "Level.h"
-#include "EnemyDeathCloudParticle.h"
 
 PSwitch::PSwitch(DOUBLE2 topLeft, Level* levelPtr) :
 	Item(topLeft + DOUBLE2(8 - WIDTH / 2, 0), Item::Type::P_SWITCH, levelPtr, Level::ITEM, BodyType::DYNAMIC, WIDTH, HEIGHT)
@@ -15,14 +14,11 @@ PSwitch::PSwitch(DOUBLE2 topLeft, Level* levelPtr) :
 
 void PSwitch::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
-
 	m_ActPtr->SetAwake(true); // This line ensures that this p switch will fall through rotating blocks reliably
 
 	if (m_PressedTimer.Tick() && m_PressedTimer.IsComplete())
 	{
-		EnemyDeathCloudParticle* cloudParticlePtr = new EnemyDeathCloudParticle(m_ActPtr->GetPosition());
-		m_LevelPtr->AddParticle(cloudParticlePtr);
+		m_LevelPtr->AddParticle(SpriteParticleStore::Kind::ENEMY_DEATH_CLOUD, m_ActPtr->GetPosition());
 
 		m_LevelPtr->RemoveItem(this);
 	}
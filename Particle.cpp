@@ -2,6 +2,7 @@
 
 #include "Particle.h"
 #include "Game.h"
+#include "ParticlePool.h"
 
 Particle::Particle(int lifetime, DOUBLE2& positionRef) : 
 	m_LifeRemaining(lifetime), m_Position(positionRef)
@@ -11,3 +12,18 @@ Particle::Particle(int lifetime, DOUBLE2& positionRef) :
 Particle::~Particle()
 {
 }
+
+RECT2 Particle::GetPaintBounds()
+{
+	return RECT2(m_Position.x - PAINT_EXTENT, m_Position.y - PAINT_EXTENT, m_Position.x + PAINT_EXTENT, m_Position.y + PAINT_EXTENT);
+}
+
+void* Particle::operator new(size_t size)
+{
+	return ParticlePool::Allocate(size);
+}
+
+void Particle::operator delete(void* memoryPtr)
+{
+	ParticlePool::Free(memoryPtr);
+}
@@ -15,6 +15,15 @@ public:
 	// Returns true if this item needs to be removed
 	virtual bool Tick(double deltaTime) = 0;
 	virtual void Paint() = 0;
+	// Everything this particle paints fits inside this rect, it isn't painted while the rect is off screen
+	virtual RECT2 GetPaintBounds();
+
+	// Particles are stored in the ParticlePool instead of on the heap
+	static void* operator new(size_t size);
+	static void operator delete(void* memoryPtr);
+
+	// How far from their position most particles paint
+	static const int PAINT_EXTENT = 32;
 
 protected:
 	DOUBLE2 m_Position;
@@ -3,10 +3,13 @@
 #include "ParticleManager.h"
 #include "Game.h"
 #include "Particle.h"
+#include "Camera.h"
 
 ParticleManager::ParticleManager()
 {
-	Reset();
+	m_ParticlesPtrArr.reserve(INITIAL_CAPACITY);
+	m_DenseToSlotArr.reserve(INITIAL_CAPACITY);
+	m_SlotsArr.reserve(INITIAL_CAPACITY);
 }
 
 ParticleManager::~ParticleManager()
@@ -16,65 +19,137 @@ ParticleManager::~ParticleManager()
 
 void ParticleManager::Reset()
 {
+	// NOTE: The slots are kept so that handles to the particles deleted here are still known to be stale
 	for (size_t i = 0; i < m_ParticlesPtrArr.size(); ++i)
 	{
-		delete m_ParticlesPtrArr[i];
+		if (m_ParticlesPtrArr[i] != nullptr) RemoveParticle(int(i));
 	}
-	m_ParticlesPtrArr.clear();
+	Compact();
+
+	m_SpriteParticleStore.Reset();
 }
 
-void ParticleManager::AddParticle(Particle* newParticlePtr)
+ParticleHandle ParticleManager::AddParticle(Particle* newParticlePtr)
 {
-	for (size_t i = 0; i < m_ParticlesPtrArr.size(); ++i)
+	int slotIndex = m_FirstFreeSlot;
+	if (slotIndex != -1)
 	{
-		if (m_ParticlesPtrArr[i] == nullptr)
-		{
-			m_ParticlesPtrArr[i] = newParticlePtr;
-			return;
-		}
+		m_FirstFreeSlot = m_SlotsArr[slotIndex].m_DenseIndex;
+	}
+	else
+	{
+		slotIndex = int(m_SlotsArr.size());
+		m_SlotsArr.push_back({ -1, 0, false });
 	}
 
+	Slot& slotRef = m_SlotsArr[slotIndex];
+	slotRef.m_DenseIndex = int(m_ParticlesPtrArr.size());
+	slotRef.m_InUse = true;
+
 	m_ParticlesPtrArr.push_back(newParticlePtr);
+	m_DenseToSlotArr.push_back(slotIndex);
+
+	ParticleHandle handle;
+	handle.m_SlotIndex = slotIndex;
+	handle.m_Generation = slotRef.m_Generation;
+	return handle;
+}
+
+void ParticleManager::AddParticle(SpriteParticleStore::Kind kind, DOUBLE2 position, DOUBLE2 velocity)
+{
+	m_SpriteParticleStore.Add(kind, position, velocity);
+}
+
+void ParticleManager::AddEnemyPoofParticles(DOUBLE2 position)
+{
+	const double xv = 55;
+	const double yv = 45;
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::STAR, position, DOUBLE2(xv, yv));
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::STAR, position, DOUBLE2(xv, -yv));
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::STAR, position, DOUBLE2(-xv, yv));
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::STAR, position, DOUBLE2(-xv, -yv));
+
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::SPLAT, position + DOUBLE2(0, -11));
+
+	m_SpriteParticleStore.Add(SpriteParticleStore::Kind::ENEMY_POOF_CLOUD, position);
 }
 
 void ParticleManager::Tick(double deltaTime)
 {
 	for (size_t i = 0; i < m_ParticlesPtrArr.size(); ++i)
 	{
-		if (m_ParticlesPtrArr[i] != nullptr)
+		if (m_ParticlesPtrArr[i] != nullptr && m_ParticlesPtrArr[i]->Tick(deltaTime))
 		{
-			if (m_ParticlesPtrArr[i]->Tick(deltaTime))
-			{
-				RemoveParticle(i);
-			}
+			RemoveParticle(int(i));
 		}
 	}
+	Compact();
+
+	m_SpriteParticleStore.Tick(deltaTime);
 }
 
-void ParticleManager::Paint()
+void ParticleManager::Paint(ViewCulling& viewCullingRef)
 {
 	for (size_t i = 0; i < m_ParticlesPtrArr.size(); ++i)
 	{
-		if (m_ParticlesPtrArr[i] != nullptr)
+		// NOTE: Particles removed through a handle since the last tick leave a hole until the next Compact
+		if (m_ParticlesPtrArr[i] != nullptr && viewCullingRef.IsVisible(m_ParticlesPtrArr[i]->GetPaintBounds()))
 		{
 			m_ParticlesPtrArr[i]->Paint();
 		}
 	}
+
+	m_SpriteParticleStore.Paint(viewCullingRef);
 }
 
-void ParticleManager::RemoveParticle(int index)
+void ParticleManager::RemoveParticle(int denseIndex)
 {
-	delete m_ParticlesPtrArr[index];
-	m_ParticlesPtrArr[index] = nullptr;
+	delete m_ParticlesPtrArr[denseIndex];
+	m_ParticlesPtrArr[denseIndex] = nullptr;
+	m_HasHoles = true;
+
+	const int slotIndex = m_DenseToSlotArr[denseIndex];
+	Slot& slotRef = m_SlotsArr[slotIndex];
+	++slotRef.m_Generation;
+	slotRef.m_InUse = false;
+	slotRef.m_DenseIndex = m_FirstFreeSlot;
+	m_FirstFreeSlot = slotIndex;
 }
 
-void ParticleManager::RemoveParticle(Particle* particlePtr)
+void ParticleManager::Compact()
 {
+	if (m_HasHoles == false) return;
+
+	int liveCount = 0;
 	for (size_t i = 0; i < m_ParticlesPtrArr.size(); ++i)
 	{
-		if (particlePtr == m_ParticlesPtrArr[i])
-		{
-			RemoveParticle(i);
-		}
+		if (m_ParticlesPtrArr[i] == nullptr) continue;
+
+		m_ParticlesPtrArr[liveCount] = m_ParticlesPtrArr[i];
+		m_DenseToSlotArr[liveCount] = m_DenseToSlotArr[i];
+		m_SlotsArr[m_DenseToSlotArr[liveCount]].m_DenseIndex = liveCount;
+		++liveCount;
+	}
+
+	m_ParticlesPtrArr.resize(liveCount);
+	m_DenseToSlotArr.resize(liveCount);
+	m_HasHoles = false;
+}
+
+void ParticleManager::RemoveParticle(ParticleHandle handle)
+{
+	if (GetParticle(handle) != nullptr)
+	{
+		RemoveParticle(m_SlotsArr[handle.m_SlotIndex].m_DenseIndex);
 	}
-}
\ No newline at end of file
+}
+
+Particle* ParticleManager::GetParticle(ParticleHandle handle) const
+{
+	if (handle.m_SlotIndex < 0 || handle.m_SlotIndex >= int(m_SlotsArr.size())) return nullptr;
+
+	const Slot& slotRef = m_SlotsArr[handle.m_SlotIndex];
+	if (slotRef.m_InUse == false || slotRef.m_Generation != handle.m_Generation) return nullptr;
+
+	return m_ParticlesPtrArr[slotRef.m_DenseIndex];
+}
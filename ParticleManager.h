@@ -1,6 +1,17 @@
 #pragma once
 
+#include "SpriteParticleStore.h"
+
 class Particle;
+struct ViewCulling;
+
+// Refers to a particle in a ParticleManager. Once that particle is removed its slot's
+// generation changes, so a handle which outlived its particle can be detected
+struct ParticleHandle
+{
+	int m_SlotIndex = -1;
+	unsigned int m_Generation = 0;
+};
 
 class ParticleManager
 {
@@ -12,15 +23,43 @@ public:
 	ParticleManager& operator=(const ParticleManager&) = delete;
 
 	void Tick(double deltaTime);
-	void Paint();
+	// Particles outside viewCullingRef's visible rect are skipped
+	void Paint(ViewCulling& viewCullingRef);
 
-	void AddParticle(Particle* newParticlePtr);
-	void RemoveParticle(Particle* particlePtr);
+	// Takes ownership, the particle is deleted once its Tick returns true
+	ParticleHandle AddParticle(Particle* newParticlePtr);
+	void AddParticle(SpriteParticleStore::Kind kind, DOUBLE2 position, DOUBLE2 velocity = DOUBLE2(0, 0));
+	// A cloud, a white splat and four stars shooting outwards, spawned when the player spin jumps on an enemy
+	void AddEnemyPoofParticles(DOUBLE2 position);
+	// Does nothing if the particle has already been removed
+	void RemoveParticle(ParticleHandle handle);
+	// Returns nullptr if the particle has already been removed
+	Particle* GetParticle(ParticleHandle handle) const;
 	void Reset();
 
 private:
-	void RemoveParticle(int index);
+	struct Slot
+	{
+		int m_DenseIndex; // Where the particle is in m_ParticlesPtrArr, or the next free slot while this slot is free
+		unsigned int m_Generation;
+		bool m_InUse;
+	};
+
+	// Deletes the particle and frees its slot, the hole it leaves is closed by the next Compact
+	void RemoveParticle(int denseIndex);
+	// Moves the live particles forward over the holes, keeping them in the order they were added (their paint order)
+	void Compact();
 
+	// Particles which need more state than a sprite particle has, in the order they were added.
+	// m_DenseToSlotArr holds the slot of each one
 	std::vector<Particle*> m_ParticlesPtrArr;
+	std::vector<int> m_DenseToSlotArr;
+	std::vector<Slot> m_SlotsArr;
+	int m_FirstFreeSlot = -1;
+	bool m_HasHoles = false;
+
+	// Enough for every particle a busy screen spawns, so adding particles doesn't allocate
+	static const int INITIAL_CAPACITY = 256;
 
+	SpriteParticleStore m_SpriteParticleStore;
 };
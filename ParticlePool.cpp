@@ -0,0 +1,172 @@
+#include "stdafx.h"
+
+#include "ParticlePool.h"
+#include "Game.h"
+
+// Most particles fit in the medium class, effects which hold several pieces use the larger ones
+const int ParticlePool::BLOCK_SIZES[NUM_SIZE_CLASSES] = { 64, 128, 256, 512 };
+const int ParticlePool::CAPACITIES[NUM_SIZE_CLASSES] = { 512, 512, 64, 32 };
+
+char* ParticlePool::m_StoragePtrArr[NUM_SIZE_CLASSES] = {};
+void* ParticlePool::m_FirstFreeBlockPtrArr[NUM_SIZE_CLASSES] = {};
+int ParticlePool::m_NumBlocksInUseArr[NUM_SIZE_CLASSES] = {};
+int ParticlePool::m_HighWaterMarkArr[NUM_SIZE_CLASSES] = {};
+int ParticlePool::m_NumOverflowsArr[NUM_SIZE_CLASSES] = {};
+
+void ParticlePool::AllocateStorage()
+{
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		const int blockSize = BLOCK_SIZES[sizeClass];
+		m_StoragePtrArr[sizeClass] = (char*)malloc(blockSize * CAPACITIES[sizeClass]);
+		if (m_StoragePtrArr[sizeClass] == nullptr)
+		{
+			// Don't keep half the pool around, the next spawn tries again from scratch
+			for (int i = 0; i < sizeClass; ++i)
+			{
+				free(m_StoragePtrArr[i]);
+				m_StoragePtrArr[i] = nullptr;
+				m_FirstFreeBlockPtrArr[i] = nullptr;
+			}
+			throw std::bad_alloc();
+		}
+
+		// Thread every block onto the free list, front to back
+		m_FirstFreeBlockPtrArr[sizeClass] = nullptr;
+		for (int i = CAPACITIES[sizeClass] - 1; i >= 0; --i)
+		{
+			void* blockPtr = m_StoragePtrArr[sizeClass] + i * blockSize;
+			*(void**)blockPtr = m_FirstFreeBlockPtrArr[sizeClass];
+			m_FirstFreeBlockPtrArr[sizeClass] = blockPtr;
+		}
+	}
+}
+
+void* ParticlePool::Allocate(size_t size)
+{
+	if (m_StoragePtrArr[0] == nullptr) AllocateStorage();
+
+	int sizeClass = 0;
+	while (sizeClass < NUM_SIZE_CLASSES && int(size) > BLOCK_SIZES[sizeClass]) ++sizeClass;
+
+	if (sizeClass == NUM_SIZE_CLASSES)
+	{
+		OutputDebugString(String("ERROR: Particle of ") + String(int(size)) + String(" bytes is too large for ParticlePool\n"));
+		return AllocateFromHeap(size);
+	}
+
+	void* blockPtr = m_FirstFreeBlockPtrArr[sizeClass];
+	if (blockPtr == nullptr)
+	{
+		++m_NumOverflowsArr[sizeClass];
+		return AllocateFromHeap(size);
+	}
+
+	m_FirstFreeBlockPtrArr[sizeClass] = *(void**)blockPtr;
+	if (++m_NumBlocksInUseArr[sizeClass] > m_HighWaterMarkArr[sizeClass])
+	{
+		m_HighWaterMarkArr[sizeClass] = m_NumBlocksInUseArr[sizeClass];
+	}
+
+	return blockPtr;
+}
+
+// Particles are created with operator new, which must throw rather than return nullptr
+void* ParticlePool::AllocateFromHeap(size_t size)
+{
+	void* memoryPtr = malloc(size);
+	if (memoryPtr == nullptr) throw std::bad_alloc();
+	return memoryPtr;
+}
+
+void ParticlePool::Free(void* memoryPtr)
+{
+	if (memoryPtr == nullptr) return;
+
+	const int sizeClass = GetSizeClassOwning(memoryPtr);
+	if (sizeClass == -1)
+	{
+		// This came from the heap when the pool was full
+		free(memoryPtr);
+		return;
+	}
+
+	*(void**)memoryPtr = m_FirstFreeBlockPtrArr[sizeClass];
+	m_FirstFreeBlockPtrArr[sizeClass] = memoryPtr;
+	--m_NumBlocksInUseArr[sizeClass];
+}
+
+void ParticlePool::Shutdown()
+{
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		if (m_NumBlocksInUseArr[sizeClass] > 0)
+		{
+			// Freeing the storage now would leave those particles pointing at freed memory
+			OutputDebugString(String("ERROR: ParticlePool::Shutdown called while ") + String(m_NumBlocksInUseArr[sizeClass]) +
+				String(" blocks of ") + String(BLOCK_SIZES[sizeClass]) + String(" bytes are still in use\n"));
+			return;
+		}
+	}
+
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		free(m_StoragePtrArr[sizeClass]);
+		m_StoragePtrArr[sizeClass] = nullptr;
+		m_FirstFreeBlockPtrArr[sizeClass] = nullptr;
+	}
+}
+
+void ParticlePool::ResetCounters()
+{
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		m_HighWaterMarkArr[sizeClass] = m_NumBlocksInUseArr[sizeClass];
+		m_NumOverflowsArr[sizeClass] = 0;
+	}
+}
+
+int ParticlePool::GetSizeClassOwning(void* memoryPtr)
+{
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		const char* storageBeginPtr = m_StoragePtrArr[sizeClass];
+		const char* storageEndPtr = storageBeginPtr + BLOCK_SIZES[sizeClass] * CAPACITIES[sizeClass];
+		if ((char*)memoryPtr >= storageBeginPtr && (char*)memoryPtr < storageEndPtr)
+		{
+			return sizeClass;
+		}
+	}
+
+	return -1;
+}
+
+int ParticlePool::GetNumBlocksInUse(SizeClass sizeClass)
+{
+	return m_NumBlocksInUseArr[int(sizeClass)];
+}
+
+int ParticlePool::GetHighWaterMark(SizeClass sizeClass)
+{
+	return m_HighWaterMarkArr[int(sizeClass)];
+}
+
+int ParticlePool::GetNumOverflows(SizeClass sizeClass)
+{
+	return m_NumOverflowsArr[int(sizeClass)];
+}
+
+void ParticlePool::Paint(int left, int bottom, int lineHeight)
+{
+	int y = bottom - lineHeight * NUM_SIZE_CLASSES;
+	GAME_ENGINE->DrawString(String("particles used/max/ovf"), left, y - lineHeight);
+
+	for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass)
+	{
+		String line = String(BLOCK_SIZES[sizeClass]) + String("B: ") +
+			String(m_NumBlocksInUseArr[sizeClass]) + String("/") + String(m_HighWaterMarkArr[sizeClass]) +
+			String("/") + String(m_NumOverflowsArr[sizeClass]);
+		GAME_ENGINE->DrawString(line, left, y);
+		y += lineHeight;
+	}
+}
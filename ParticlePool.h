@@ -0,0 +1,51 @@
+#pragma once
+
+// Fixed capacity storage for particles, so spawning and removing them doesn't touch the heap.
+// Every allocation is served from the smallest size class it fits in, and freed blocks are
+// recycled through a free list. When a size class is full we fall back to the heap, which
+// is counted as an overflow so the capacities can be tuned
+class ParticlePool
+{
+public:
+	enum class SizeClass
+	{
+		SMALL, MEDIUM, LARGE, EXTRA_LARGE,
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
+	};
+
+	static void* Allocate(size_t size);
+	static void Free(void* memoryPtr);
+	// Frees the storage of every size class, call this once every particle has been deleted.
+	// The storage is allocated again when the next particle is spawned
+	static void Shutdown();
+	// Starts the high-water marks and overflow counts over, so they only cover the game that is starting
+	static void ResetCounters();
+
+	static int GetNumBlocksInUse(SizeClass sizeClass);
+	static int GetHighWaterMark(SizeClass sizeClass);
+	static int GetNumOverflows(SizeClass sizeClass);
+
+	// Usage, high-water mark and overflows of every size class, drawn upwards from bottom using the current font
+	static void Paint(int left, int bottom, int lineHeight);
+
+	static const int NUM_SIZE_CLASSES = int(SizeClass::_LAST_ELEMENT);
+
+private:
+	ParticlePool() = delete;
+
+	// The storage of every size class is allocated once, the first time any particle is spawned
+	static void AllocateStorage();
+	static void* AllocateFromHeap(size_t size);
+	static int GetSizeClassOwning(void* memoryPtr);
+
+	static const int BLOCK_SIZES[NUM_SIZE_CLASSES];
+	static const int CAPACITIES[NUM_SIZE_CLASSES];
+
+	static char* m_StoragePtrArr[NUM_SIZE_CLASSES];
+	// The first bytes of every free block point to the next free block
+	static void* m_FirstFreeBlockPtrArr[NUM_SIZE_CLASSES];
+	static int m_NumBlocksInUseArr[NUM_SIZE_CLASSES];
+	static int m_HighWaterMarkArr[NUM_SIZE_CLASSES];
+	static int m_NumOverflowsArr[NUM_SIZE_CLASSES];
+};
@@ -45,6 +45,11 @@ bool Pipe::Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, DOU
 	return m_ActPtr->Raycast(point1, point2, intersectionRef, normalRef, fractionRef);
 }
 
+RECT2 Pipe::GetBounds() const
+{
+	return m_Bounds;
+}
+
 Pipe::Orientation Pipe::GetOrientation()
 {
 	return m_Orientation;
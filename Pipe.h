@@ -22,6 +22,7 @@ public:
 	bool Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef);
 
 	Orientation GetOrientation();
+	RECT2 GetBounds() const;
 
 	static Orientation StringToOrientation(std::string orientationStr);
 	static std::string OrientationToString(Orientation orientation);
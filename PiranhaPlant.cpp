@@ -33,7 +33,6 @@ PiranhaPlant::~PiranhaPlant()
 
 void PiranhaPlant::Tick(double deltaTime)
 {
-	Enemy::Tick(deltaTime);
 	if (m_IsActive == false) return;
 
 	m_AnimInfo.Tick(deltaTime);
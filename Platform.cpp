@@ -37,3 +37,9 @@ double Platform::GetHeight()
 {
 	return HEIGHT;
 }
+
+RECT2 Platform::GetBounds()
+{
+	const DOUBLE2 center = m_ActPtr->GetPosition();
+	return RECT2(center.x - m_Width / 2, center.y - HEIGHT / 2.0, center.x + m_Width / 2, center.y + HEIGHT / 2.0);
+}
@@ -14,6 +14,7 @@ public:
 	void AddContactListener(ContactListener* listener);
 	double GetWidth();
 	double GetHeight();
+	RECT2 GetBounds();
 	bool Raycast(DOUBLE2 point1, DOUBLE2 point2, DOUBLE2 &intersectionRef, DOUBLE2 &normalRef, double &fractionRef);
 
 	static const int HEIGHT = 6;
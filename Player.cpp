@@ -11,10 +11,7 @@
 #include "SpriteSheet.h"
 
 #include "SoundManager.h"
-#include "DustParticle.h"
 #include "NumberParticle.h"
-#include "SplatParticle.h"
-#include "OneUpParticle.h"
 #include "GrabBlock.h"
 #include "PSwitch.h"
 
@@ -50,15 +47,24 @@ Player::Player(Level* levelPtr, GameState* gameStatePtr, SessionInfo sessionInfo
 {
 	Reset();
 
-	m_AnimInfo.secondsPerFrame = MARIO_SECONDS_PER_FRAME;
-
 	m_RecentlyTouchedGrabBlocksPtrArr = std::vector<GrabBlock*>(2);
 
-	if (sessionInfo.m_PlayerLives == -1) // The session info was not set, use default values
-	{
-		m_Lives = STARTING_LIVES;
-	}
-	else // The session info was set, use it
+	m_Lives = STARTING_LIVES;
+	ApplySessionInfo(sessionInfo);
+
+	b2Filter collisionFilter;
+	collisionFilter.categoryBits = Level::PLAYER;
+	collisionFilter.maskBits = Level::LEVEL | Level::BLOCK | Level::YOSHI | Level::BEANSTALK | Level::ENEMY | Level::ITEM | Level::SHELL;
+	m_ActPtr->SetCollisionFilter(collisionFilter);
+}
+
+Player::~Player()
+{
+}
+
+void Player::ApplySessionInfo(SessionInfo sessionInfo)
+{
+	if (sessionInfo.m_PlayerLives != -1) // The session info was set, use it
 	{
 		m_Lives = sessionInfo.m_PlayerLives;
 		m_Score = sessionInfo.m_PlayerScore;
@@ -73,15 +79,6 @@ Player::Player(Level* levelPtr, GameState* gameStatePtr, SessionInfo sessionInfo
 		if (differentPowerupState) m_PowerupState = StringToPowerupState(sessionInfo.m_PlayerPowerupState);
 		else m_PowerupState = PowerupState::NORMAL;
 	}
-
-	b2Filter collisionFilter;
-	collisionFilter.categoryBits = Level::PLAYER;
-	collisionFilter.maskBits = Level::LEVEL | Level::BLOCK | Level::YOSHI | Level::BEANSTALK | Level::ENEMY | Level::ITEM | Level::SHELL;
-	m_ActPtr->SetCollisionFilter(collisionFilter);
-}
-
-Player::~Player()
-{
 }
 
 void Player::Reset()
@@ -94,6 +91,7 @@ void Player::Reset()
 	m_IsOnGround = false;
 
 	m_AnimInfo.Reset();
+	m_AnimInfo.secondsPerFrame = MARIO_SECONDS_PER_FRAME;
 
 	m_Score = 0;
 	m_Coins = 0;
@@ -199,7 +197,7 @@ void Player::Tick(double deltaTime)
 			SessionInfo currentSessionInfo;
 			GameSession::RecordSessionInfo(currentSessionInfo, m_LevelPtr);
 			
-			m_GameStatePtr->EnterNewLevel(m_PipeTouchingPtr, currentSessionInfo);
+			m_GameStatePtr->RequestPipeWarp(m_PipeTouchingPtr, currentSessionInfo);
 		}
 		return;
 	}
@@ -681,8 +679,7 @@ void Player::HandleKeyboardInput(double deltaTime)
 	{
 		if (m_SpawnDustCloudTimer.IsActive() == false && m_IsOnGround)
 		{
-			DustParticle* dustParticlePtr = new DustParticle(m_ActPtr->GetPosition() + DOUBLE2(0, GetHeight() / 2 + 1));
-			m_LevelPtr->AddParticle(dustParticlePtr);
+			m_LevelPtr->AddParticle(SpriteParticleStore::Kind::DUST, m_ActPtr->GetPosition() + DOUBLE2(0, GetHeight() / 2 + 1));
 			m_SpawnDustCloudTimer.Start();
 		}
 	}
@@ -693,20 +690,16 @@ void Player::HandleKeyboardInput(double deltaTime)
 
 bool Player::CalculateOnGround()
 {
-	if (m_ActPtr->GetLinearVelocity().y < 0) return false;
+	// NOTE: This probe was run from where the last physics step left us
+	const bool groundBelow = m_GroundProbe.m_Hit;
 
-	DOUBLE2 point1 = m_ActPtr->GetPosition();
-	DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(0, (GetHeight() / 2 + 3));
-	DOUBLE2 intersection, normal;
-	double fraction = -1.0;
-	int collisionBits = Level::LEVEL | Level::BLOCK;
+	m_GroundProbe.m_Offset = DOUBLE2(0, (GetHeight() / 2 + 3));
+	m_GroundProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_GroundProbe);
 
-	if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
-	{
-		return true;
-	}
+	if (m_ActPtr->GetLinearVelocity().y < 0) return false;
 
-	return false;
+	return groundBelow;
 }
 
 void Player::Paint()
@@ -1493,8 +1486,7 @@ void Player::AddDragonCoin(DragonCoin* dragonCoinPtr)
 void Player::AddLife(DOUBLE2 particlePos)
 {
 	m_Lives++;
-	OneUpParticle* oneUpParticlePtr = new OneUpParticle(particlePos);
-	m_LevelPtr->AddParticle(oneUpParticlePtr);
+	m_LevelPtr->AddParticle(SpriteParticleStore::Kind::ONE_UP, particlePos);
 
 	SoundManager::PlaySoundEffect(SoundManager::Sound::PLAYER_ONE_UP);
 }
@@ -37,6 +37,8 @@ public:
 	void Tick(double deltaTime);
 	void Paint();
 	void Reset();
+	// Picks up the lives, score, powerup and held item the player had in the level they came from
+	void ApplySessionInfo(SessionInfo sessionInfo);
 	
 	static PowerupState StringToPowerupState(const std::string& powerupStateStr);
 	static std::string PowerupStateToString(PowerupState powerupState);
@@ -142,6 +144,7 @@ private:
 
 	bool m_IsOnGround;
 	bool m_WasOnGround;
+	Probe m_GroundProbe;
 	int m_FramesSpentInAir;
 
 	int m_Lives;
@@ -177,3 +177,18 @@ bool PrizeBlock::IsFlying() const
 {
 	return m_IsFlyer && m_IsFlying;
 }
+
+bool PrizeBlock::ResetToSpawnState()
+{
+	// Flying blocks change their body type once they're hit, it's simpler to just spawn a new one
+	if (m_IsFlyer) return false;
+
+	ResetBodyAndAnimation();
+
+	m_BumpAnimationTimer = SMWTimer(14);
+	m_yo = 0;
+	m_IsUsed = false;
+	m_ShouldSpawnItem = false;
+
+	return true;
+}
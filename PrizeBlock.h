@@ -19,6 +19,8 @@ public:
 
 	bool IsFlying() const;
 
+	bool ResetToSpawnState();
+
 private:
 	SMWTimer m_BumpAnimationTimer;
 	int m_yo = 0;
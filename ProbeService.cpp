@@ -0,0 +1,53 @@
+#include "stdafx.h"
+
+#include "ProbeService.h"
+#include "Entity.h"
+
+ProbeService::ProbeService()
+{
+	m_RequestsArr.reserve(INITIAL_CAPACITY);
+}
+
+ProbeService::~ProbeService()
+{
+}
+
+void ProbeService::Submit(Entity* entityPtr, Probe* probePtr)
+{
+	if (probePtr->m_IsSubmitted) return;
+
+	probePtr->m_IsSubmitted = true;
+	m_RequestsArr.push_back({ entityPtr, probePtr });
+}
+
+void ProbeService::Cancel(Entity* entityPtr)
+{
+	for (int i = int(m_RequestsArr.size()) - 1; i >= 0; --i)
+	{
+		if (m_RequestsArr[i].m_EntityPtr == entityPtr)
+		{
+			m_RequestsArr[i] = m_RequestsArr.back();
+			m_RequestsArr.pop_back();
+		}
+	}
+}
+
+void ProbeService::Run()
+{
+	for (size_t i = 0; i < m_RequestsArr.size(); ++i)
+	{
+		Probe* probePtr = m_RequestsArr[i].m_ProbePtr;
+		m_RequestsArr[i].m_EntityPtr->RunProbe(*probePtr);
+		probePtr->m_IsSubmitted = false;
+	}
+	m_RequestsArr.clear();
+}
+
+void ProbeService::Reset()
+{
+	for (size_t i = 0; i < m_RequestsArr.size(); ++i)
+	{
+		m_RequestsArr[i].m_ProbePtr->m_IsSubmitted = false;
+	}
+	m_RequestsArr.clear();
+}
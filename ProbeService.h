@@ -0,0 +1,43 @@
+#pragma once
+
+class Entity;
+
+// A ray cast from an entity's center, which the entity submits while it ticks. Every submitted
+// probe is run in one batch after the next physics step, and the entity reads the answer on its
+// following tick instead of raycasting in the middle of its own logic
+struct Probe
+{
+	DOUBLE2 m_Offset; // From the entity's center to the end of the ray
+	int m_CollisionBits = 0; // Level::CollisionFilter
+	bool m_Hit = false; // The answer from the last time this probe was run
+	bool m_IsSubmitted = false;
+};
+
+class ProbeService
+{
+public:
+	ProbeService();
+	virtual ~ProbeService();
+
+	ProbeService(const ProbeService&) = delete;
+	ProbeService& operator=(const ProbeService&) = delete;
+
+	// NOTE: Submitting a probe which is already waiting to be run only updates its ray
+	void Submit(Entity* entityPtr, Probe* probePtr);
+	// Forgets every probe this entity submitted, must be called before the entity is deleted
+	void Cancel(Entity* entityPtr);
+	// Runs every submitted probe from where its entity is now
+	void Run();
+	void Reset();
+
+	static const int INITIAL_CAPACITY = 64;
+
+private:
+	struct Request
+	{
+		Entity* m_EntityPtr;
+		Probe* m_ProbePtr;
+	};
+
+	std::vector<Request> m_RequestsArr;
+};
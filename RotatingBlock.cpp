@@ -19,7 +19,6 @@ RotatingBlock::RotatingBlock(DOUBLE2 topLeft, Level* levelPtr, bool spawnsBeanst
 
 void RotatingBlock::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
 	if (m_IsActive == false) return;
 
 	if (m_ShouldSpawnBeanstalk)
@@ -110,3 +109,17 @@ bool RotatingBlock::IsRotating()
 {
 	return m_RotationTimer.IsActive();
 }
+
+bool RotatingBlock::ResetToSpawnState()
+{
+	ResetBodyAndAnimation();
+
+	m_RotationTimer = SMWTimer(255);
+	m_BumpAnimationTimer = SMWTimer(14);
+	m_ShouldSpawnBeanstalk = false;
+	m_yo = 0;
+	m_IsUsed = false;
+	m_ActPtr->SetSensor(false);
+
+	return true;
+}
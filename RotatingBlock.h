@@ -14,6 +14,7 @@ public:
 	void Paint();
 	void Hit();
 	bool IsRotating();
+	bool ResetToSpawnState();
 
 private:
 	SMWTimer m_RotationTimer;
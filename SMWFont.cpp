@@ -6,11 +6,69 @@
 #include "SpriteSheet.h"
 #include "HUD.h"
 
-void SMWFont::PaintPhrase(std::string phrase, int left, int top, int attributeFlags)
+std::map<std::string, SMWFont::Layout> SMWFont::m_LayoutsMapArr[NUM_LAYOUTS_MAPS];
+
+void SMWFont::PaintPhrase(const std::string& phrase, int left, int top, int attributeFlags)
+{
+	const Layout& layoutRef = GetLayout(phrase, attributeFlags);
+
+	SpriteSheet* spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::FONT);
+	if (attributeFlags & INVERTED) spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::FONT_INVERTED);
+	Bitmap* letterBmpPtr = spriteSheetPtr->GetBitmap();
+	for (size_t i = 0; i < layoutRef.m_LetterGlyphsArr.size(); ++i)
+	{
+		const Glyph& glyphRef = layoutRef.m_LetterGlyphsArr[i];
+		GAME_ENGINE->DrawBitmap(letterBmpPtr, left + glyphRef.m_Left, top + glyphRef.m_Top, glyphRef.m_SrcRect);
+	}
+
+	Bitmap* digitBmpPtr = SpriteSheetManager::GetBitmapPtr(SpriteSheetManager::HUD);
+	for (size_t i = 0; i < layoutRef.m_DigitGlyphsArr.size(); ++i)
+	{
+		const Glyph& glyphRef = layoutRef.m_DigitGlyphsArr[i];
+		GAME_ENGINE->DrawBitmap(digitBmpPtr, left + glyphRef.m_Left, top + glyphRef.m_Top, glyphRef.m_SrcRect);
+	}
+}
+
+void SMWFont::ClearLayoutCache()
+{
+	for (int i = 0; i < NUM_LAYOUTS_MAPS; ++i)
+	{
+		m_LayoutsMapArr[i].clear();
+	}
+}
+
+int SMWFont::GetLayoutsMapIndex(int attributeFlags)
+{
+	return ((attributeFlags & OUTLINED) ? 1 : 0) + ((attributeFlags & INVERTED) ? 2 : 0);
+}
+
+const SMWFont::Layout& SMWFont::GetLayout(const std::string& phrase, int attributeFlags)
+{
+	std::map<std::string, Layout>& layoutsMapRef = m_LayoutsMapArr[GetLayoutsMapIndex(attributeFlags)];
+	std::map<std::string, Layout>::iterator layoutIt = layoutsMapRef.find(phrase);
+	if (layoutIt != layoutsMapRef.end())
+	{
+		return layoutIt->second;
+	}
+
+	if (int(layoutsMapRef.size()) >= MAX_CACHED_PHRASES) layoutsMapRef.clear();
+
+	// NOTE: Only a phrase which isn't cached yet is copied, to become its key
+	Layout& layoutRef = layoutsMapRef[phrase];
+	LayoutPhrase(phrase, attributeFlags, layoutRef);
+	return layoutRef;
+}
+
+void SMWFont::LayoutPhrase(const std::string& phrase, int attributeFlags, Layout& layoutRef)
 {
-	left += CHARACTER_WIDTH / 2;
+	SpriteSheet* spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::FONT);
+	const int tileWidth = spriteSheetPtr->GetTileWidth();
+	const int tileHeight = spriteSheetPtr->GetTileHeight();
+
+	// Positions are relative to the top left of the phrase, centers of the glyphs
+	const int left = CHARACTER_WIDTH / 2;
 	int xo = left;
-	int yo = top + CHARACTER_HEIGHT / 2;
+	int yo = CHARACTER_HEIGHT / 2;
 
 	int srcX;
 	int srcY;
@@ -21,18 +79,26 @@ void SMWFont::PaintPhrase(std::string phrase, int left, int top, int attributeFl
 		if (currentChar == '_') spriteIndex = 66;
 		else if (currentChar >= '0' && currentChar <= '9')
 		{
-			std::string numberStr; // Paint several numbers at once
-			while (i < phrase.length() && currentChar >= '0' && currentChar <= '9')
+			// A run of digits is painted as one number, right aligned on its last digit (leading zeros are dropped)
+			size_t end = i;
+			while (end < phrase.length() && phrase.at(end) >= '0' && phrase.at(end) <= '9') ++end;
+			size_t firstSignificant = i;
+			while (firstSignificant < end - 1 && phrase.at(firstSignificant) == '0') ++firstSignificant;
+
+			xo += int(end - i - 1) * CHARACTER_WIDTH;
+			int digitLeft = xo - 4;
+			for (size_t digitIndex = end; digitIndex > firstSignificant; --digitIndex)
 			{
-				numberStr += std::to_string(int(currentChar - '0'));
-				++i;
-				if (i < phrase.length()) currentChar = phrase.at(i);
+				Glyph glyph;
+				glyph.m_Left = digitLeft;
+				glyph.m_Top = 2;
+				glyph.m_SrcRect = HUD::GetSmallSingleNumberSrcRect(phrase.at(digitIndex - 1) - '0', false);
+				layoutRef.m_DigitGlyphsArr.push_back(glyph);
+				digitLeft -= 8;
 			}
-			--i;
-			xo += (numberStr.length()-1) * CHARACTER_WIDTH;
 
-			HUD::PaintSeveralDigitNumber(xo - 4, top + 2, stoi(numberStr), false);
 			xo += CHARACTER_WIDTH;
+			i = end - 1;
 			continue;
 		}
 		else if (currentChar >= 'A' && currentChar <= 'z')
@@ -68,10 +134,14 @@ void SMWFont::PaintPhrase(std::string phrase, int left, int top, int attributeFl
 
 		if (attributeFlags & OUTLINED) srcY += 4;
 
-		SpriteSheet* spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::FONT);
-		if (attributeFlags & INVERTED) spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::FONT_INVERTED);
-		
-		spriteSheetPtr->Paint(xo, yo, srcX, srcY);
+		assert(srcX >= 0 && srcX < spriteSheetPtr->GetTilesWide() && srcY >= 0 && srcY < spriteSheetPtr->GetTilesHigh());
+
+		// The same rect SpriteSheet::Paint would paint around the glyph's center
+		Glyph glyph;
+		glyph.m_Left = xo - tileWidth / 2;
+		glyph.m_Top = yo - tileHeight / 2;
+		glyph.m_SrcRect = RECT2(srcX * tileWidth, srcY * tileHeight, srcX * tileWidth + tileWidth, srcY * tileHeight + tileHeight);
+		layoutRef.m_LetterGlyphsArr.push_back(glyph);
 
 		xo += CHARACTER_WIDTH;
 	}
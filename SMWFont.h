@@ -6,11 +6,42 @@ public:
 	static const int OUTLINED = (1 << 1);
 	static const int INVERTED = (1 << 2);
 
-	static void PaintPhrase(std::string phrase, int left, int top, int attributeFlags);
+	// The glyphs of every phrase are laid out once per combination of attributeFlags and reused while the phrase
+	// is painted again, so static text is painted in one batch per bitmap
+	static void PaintPhrase(const std::string& phrase, int left, int top, int attributeFlags);
+
+	// Forgets every laid out phrase, called when the font sprite sheets are unloaded
+	static void ClearLayoutCache();
 
 	static const int CHARACTER_WIDTH = 8;
 	static const int CHARACTER_HEIGHT = 9;
 private:
+	// Top left corner relative to where the phrase is painted, and the part of the bitmap to paint there
+	struct Glyph
+	{
+		int m_Left;
+		int m_Top;
+		RECT2 m_SrcRect;
+	};
+
+	// Letters come from the font sprite sheet and numbers from the HUD bitmap, each kept apart so they're painted in one go
+	struct Layout
+	{
+		std::vector<Glyph> m_LetterGlyphsArr;
+		std::vector<Glyph> m_DigitGlyphsArr;
+	};
+
+	static const Layout& GetLayout(const std::string& phrase, int attributeFlags);
+	static void LayoutPhrase(const std::string& phrase, int attributeFlags, Layout& layoutRef);
+	// Which of m_LayoutsMapArr holds the phrases painted with these flags
+	static int GetLayoutsMapIndex(int attributeFlags);
 
 	static const int CHARS_WIDE = 18;
-};
\ No newline at end of file
+	// Phrases which change every frame (counting scores) would otherwise grow the cache forever
+	static const int MAX_CACHED_PHRASES = 128;
+	// One for every combination of OUTLINED and INVERTED
+	static const int NUM_LAYOUTS_MAPS = 4;
+
+	// Keyed by the phrase alone, so looking a phrase up doesn't copy it
+	static std::map<std::string, Layout> m_LayoutsMapArr[NUM_LAYOUTS_MAPS];
+};
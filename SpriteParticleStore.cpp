@@ -0,0 +1,227 @@
+#include "stdafx.h"
+
+#include "SpriteParticleStore.h"
+#include "Game.h"
+#include "SpriteSheetManager.h"
+#include "SpriteSheet.h"
+#include "Camera.h"
+
+#include <emmintrin.h>
+
+// NOTE: Must be in the same order as Kind
+const SpriteParticleStore::KindInfo SpriteParticleStore::KIND_INFOS[NUM_KINDS] =
+{
+	// sprite sheet, bitmap, seconds per frame, frames, lifetime ticks, moves
+	{ SpriteSheetManager::DUST_CLOUD_PARTICLE, -1, 0.08, 4, -1, false },			// DUST
+	{ SpriteSheetManager::COIN_COLLECT_PARTICLE, -1, 0.055, 10, -1, false },		// COIN_COLLECT
+	{ SpriteSheetManager::ENEMY_DEATH_CLOUD_PARTICLE, -1, 0.1, 5, -1, false },		// ENEMY_DEATH_CLOUD
+	{ SpriteSheetManager::ENEMY_DEATH_CLOUD_PARTICLE, -1, 0.1, 5, 13, false },		// ENEMY_POOF_CLOUD (cut short with the rest of the poof)
+	{ -1, SpriteSheetManager::STAR_CLOUD_PARTICLE, 0.0, 0, 9, false },				// STAR_CLOUD
+	{ -1, SpriteSheetManager::STAR_PARTICLE, 0.0, 0, 13, true },					// STAR
+	{ -1, SpriteSheetManager::SPLAT_PARTICLE, 0.0, 0, 13, false },					// SPLAT
+	{ -1, SpriteSheetManager::ONE_UP_PARTICLE, 0.0, 0, 44, true },					// ONE_UP
+};
+
+SpriteParticleStore::SpriteParticleStore()
+{
+	// Everything is allocated up front, adding and removing particles never allocates
+	for (int kind = 0; kind < NUM_KINDS; ++kind)
+	{
+		KindArrays& arraysRef = m_KindArraysArr[kind];
+		arraysRef.m_PosXArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_PosYArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_VelXArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_VelYArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_FrameSecondsArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_FrameArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_LifeRemainingArr.resize(CAPACITY_PER_KIND);
+		arraysRef.m_Count = 0;
+	}
+}
+
+SpriteParticleStore::~SpriteParticleStore()
+{
+}
+
+void SpriteParticleStore::Reset()
+{
+	for (int kind = 0; kind < NUM_KINDS; ++kind)
+	{
+		m_KindArraysArr[kind].m_Count = 0;
+	}
+}
+
+void SpriteParticleStore::Add(Kind kind, DOUBLE2 position, DOUBLE2 velocity)
+{
+	KindArrays& arraysRef = m_KindArraysArr[int(kind)];
+	if (arraysRef.m_Count == CAPACITY_PER_KIND) return;
+
+	const int index = arraysRef.m_Count++;
+	arraysRef.m_PosXArr[index] = position.x;
+	arraysRef.m_PosYArr[index] = position.y;
+	arraysRef.m_VelXArr[index] = velocity.x;
+	arraysRef.m_VelYArr[index] = velocity.y;
+	arraysRef.m_FrameSecondsArr[index] = 0.0;
+	arraysRef.m_FrameArr[index] = 0;
+	arraysRef.m_LifeRemainingArr[index] = KIND_INFOS[int(kind)].m_LifetimeTicks;
+}
+
+int SpriteParticleStore::GetNumParticles() const
+{
+	int numParticles = 0;
+	for (int kind = 0; kind < NUM_KINDS; ++kind)
+	{
+		numParticles += m_KindArraysArr[kind].m_Count;
+	}
+	return numParticles;
+}
+
+void SpriteParticleStore::Tick(double deltaTime)
+{
+	for (int kind = 0; kind < NUM_KINDS; ++kind)
+	{
+		TickLifetimes(Kind(kind), deltaTime);
+
+		if (KIND_INFOS[kind].m_Moves)
+		{
+			TickPositions(m_KindArraysArr[kind], deltaTime);
+		}
+	}
+}
+
+void SpriteParticleStore::TickLifetimes(Kind kind, double deltaTime)
+{
+	const KindInfo& infoRef = KIND_INFOS[int(kind)];
+	KindArrays& arraysRef = m_KindArraysArr[int(kind)];
+
+	// NOTE: Walking backwards means the particle swapped into a removed slot has already been ticked
+	for (int i = arraysRef.m_Count - 1; i >= 0; --i)
+	{
+		bool expired = false;
+		if (infoRef.m_NumFrames > 0)
+		{
+			arraysRef.m_FrameSecondsArr[i] += deltaTime;
+			if (arraysRef.m_FrameSecondsArr[i] > infoRef.m_SecondsPerFrame)
+			{
+				arraysRef.m_FrameSecondsArr[i] -= infoRef.m_SecondsPerFrame;
+				++arraysRef.m_FrameArr[i];
+			}
+			expired = arraysRef.m_FrameArr[i] >= infoRef.m_NumFrames;
+		}
+		if (infoRef.m_LifetimeTicks != -1 && --arraysRef.m_LifeRemainingArr[i] <= 0)
+		{
+			expired = true;
+		}
+
+		if (expired)
+		{
+			RemoveSwapLast(arraysRef, i);
+		}
+		else if (kind == Kind::ONE_UP)
+		{
+			// Rises quickly at first, then slows down for the second half of its life
+			const bool slow = arraysRef.m_LifeRemainingArr[i] < infoRef.m_LifetimeTicks / 2;
+			arraysRef.m_VelYArr[i] = -(slow ? ONE_UP_SLOW_VEL : ONE_UP_FAST_VEL);
+		}
+	}
+}
+
+void SpriteParticleStore::TickPositions(KindArrays& arraysRef, double deltaTime)
+{
+	double* posXPtr = arraysRef.m_PosXArr.data();
+	double* posYPtr = arraysRef.m_PosYArr.data();
+	const double* velXPtr = arraysRef.m_VelXArr.data();
+	const double* velYPtr = arraysRef.m_VelYArr.data();
+	const int count = arraysRef.m_Count;
+
+	// Two particles at a time
+	const __m128d deltaTimes = _mm_set1_pd(deltaTime);
+	int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		_mm_storeu_pd(posXPtr + i, _mm_add_pd(_mm_loadu_pd(posXPtr + i), _mm_mul_pd(_mm_loadu_pd(velXPtr + i), deltaTimes)));
+		_mm_storeu_pd(posYPtr + i, _mm_add_pd(_mm_loadu_pd(posYPtr + i), _mm_mul_pd(_mm_loadu_pd(velYPtr + i), deltaTimes)));
+	}
+	for (; i < count; ++i)
+	{
+		posXPtr[i] += velXPtr[i] * deltaTime;
+		posYPtr[i] += velYPtr[i] * deltaTime;
+	}
+}
+
+void SpriteParticleStore::RemoveSwapLast(KindArrays& arraysRef, int index)
+{
+	const int last = --arraysRef.m_Count;
+	arraysRef.m_PosXArr[index] = arraysRef.m_PosXArr[last];
+	arraysRef.m_PosYArr[index] = arraysRef.m_PosYArr[last];
+	arraysRef.m_VelXArr[index] = arraysRef.m_VelXArr[last];
+	arraysRef.m_VelYArr[index] = arraysRef.m_VelYArr[last];
+	arraysRef.m_FrameSecondsArr[index] = arraysRef.m_FrameSecondsArr[last];
+	arraysRef.m_FrameArr[index] = arraysRef.m_FrameArr[last];
+	arraysRef.m_LifeRemainingArr[index] = arraysRef.m_LifeRemainingArr[last];
+}
+
+void SpriteParticleStore::Paint(ViewCulling& viewCullingRef)
+{
+	for (int kind = 0; kind < NUM_KINDS; ++kind)
+	{
+		if (m_KindArraysArr[kind].m_Count > 0)
+		{
+			PaintKind(Kind(kind), viewCullingRef);
+		}
+	}
+}
+
+void SpriteParticleStore::PaintKind(Kind kind, ViewCulling& viewCullingRef)
+{
+	const KindInfo& infoRef = KIND_INFOS[int(kind)];
+	const KindArrays& arraysRef = m_KindArraysArr[int(kind)];
+
+	if (infoRef.m_SpriteSheet != -1)
+	{
+		SpriteSheet* spriteSheetPtr = SpriteSheetManager::GetSpriteSheetPtr(SpriteSheetManager::SpriteSheets(infoRef.m_SpriteSheet));
+		for (int i = 0; i < arraysRef.m_Count; ++i)
+		{
+			if (viewCullingRef.IsVisible(DOUBLE2(arraysRef.m_PosXArr[i], arraysRef.m_PosYArr[i]), PAINT_EXTENT) == false) continue;
+			spriteSheetPtr->Paint(arraysRef.m_PosXArr[i], arraysRef.m_PosYArr[i], arraysRef.m_FrameArr[i], 0);
+		}
+		return;
+	}
+
+	Bitmap* bmpPtr = SpriteSheetManager::GetBitmapPtr(SpriteSheetManager::Bitmaps(infoRef.m_Bitmap));
+	if (kind == Kind::SPLAT)
+	{
+		const MATRIX3X2 matPrevWorld = GAME_ENGINE->GetWorldMatrix();
+		const MATRIX3X2 matReflect = MATRIX3X2::CreateScalingMatrix(-1, 1);
+		for (int i = 0; i < arraysRef.m_Count; ++i)
+		{
+			const double left = arraysRef.m_PosXArr[i];
+			const double top = arraysRef.m_PosYArr[i];
+			if (viewCullingRef.IsVisible(DOUBLE2(left, top), PAINT_EXTENT) == false) continue;
+
+			// These particles flip horizontally every two frames
+			if ((arraysRef.m_LifeRemainingArr[i] - 1) % 4 >= 2)
+			{
+				const double centerX = left + SPLAT_SIZE / 2.0;
+				const double centerY = top + SPLAT_SIZE / 2.0;
+				MATRIX3X2 matTranslate = MATRIX3X2::CreateTranslationMatrix(centerX, centerY);
+				MATRIX3X2 matTranslateInverse = MATRIX3X2::CreateTranslationMatrix(-centerX, -centerY);
+				GAME_ENGINE->SetWorldMatrix(matTranslateInverse * matReflect * matTranslate);
+			}
+			else
+			{
+				GAME_ENGINE->SetWorldMatrix(matPrevWorld);
+			}
+
+			GAME_ENGINE->DrawBitmap(bmpPtr, left, top);
+		}
+		GAME_ENGINE->SetWorldMatrix(matPrevWorld);
+		return;
+	}
+
+	for (int i = 0; i < arraysRef.m_Count; ++i)
+	{
+		if (viewCullingRef.IsVisible(DOUBLE2(arraysRef.m_PosXArr[i], arraysRef.m_PosYArr[i]), PAINT_EXTENT) == false) continue;
+		GAME_ENGINE->DrawBitmap(bmpPtr, arraysRef.m_PosXArr[i], arraysRef.m_PosYArr[i]);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+struct ViewCulling;
+
+// Stores every simple particle (one which only moves, animates and expires) as a structure of arrays,
+// one set of arrays per kind. Each kind is moved in SIMD batches and painted in one go from its
+// sprite sheet or bitmap. Particles which need more state than this are still Particle objects
+class SpriteParticleStore
+{
+public:
+	enum class Kind
+	{
+		DUST, COIN_COLLECT, ENEMY_DEATH_CLOUD, ENEMY_POOF_CLOUD, STAR_CLOUD, STAR, SPLAT, ONE_UP,
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
+	};
+
+	SpriteParticleStore();
+	virtual ~SpriteParticleStore();
+
+	SpriteParticleStore(const SpriteParticleStore&) = delete;
+	SpriteParticleStore& operator=(const SpriteParticleStore&) = delete;
+
+	void Tick(double deltaTime);
+	// Particles outside viewCullingRef's visible rect are skipped
+	void Paint(ViewCulling& viewCullingRef);
+	void Reset();
+
+	// NOTE: When a kind is full the new particle is dropped
+	void Add(Kind kind, DOUBLE2 position, DOUBLE2 velocity = DOUBLE2(0, 0));
+	int GetNumParticles() const;
+
+	static const int NUM_KINDS = int(Kind::_LAST_ELEMENT);
+	static const int CAPACITY_PER_KIND = 1024;
+
+private:
+	struct KindInfo
+	{
+		int m_SpriteSheet; // SpriteSheetManager::SpriteSheets, or -1 if painted from m_Bitmap
+		int m_Bitmap; // SpriteSheetManager::Bitmaps
+		// Particles expire once they've shown every frame, or after a number of ticks, whichever comes first
+		double m_SecondsPerFrame;
+		int m_NumFrames; // 0 if not animated
+		int m_LifetimeTicks; // -1 if only the animation decides
+		bool m_Moves;
+	};
+
+	// Every array is CAPACITY_PER_KIND long, the first m_Count entries are live
+	struct KindArrays
+	{
+		std::vector<double> m_PosXArr;
+		std::vector<double> m_PosYArr;
+		std::vector<double> m_VelXArr;
+		std::vector<double> m_VelYArr;
+		std::vector<double> m_FrameSecondsArr;
+		std::vector<int> m_FrameArr;
+		std::vector<int> m_LifeRemainingArr;
+		int m_Count;
+	};
+
+	void TickLifetimes(Kind kind, double deltaTime);
+	void TickPositions(KindArrays& arraysRef, double deltaTime);
+	void RemoveSwapLast(KindArrays& arraysRef, int index);
+	void PaintKind(Kind kind, ViewCulling& viewCullingRef);
+
+	static const KindInfo KIND_INFOS[NUM_KINDS];
+
+	static const int ONE_UP_FAST_VEL = 40;
+	static const int ONE_UP_SLOW_VEL = 20;
+	static const int SPLAT_SIZE = 17;
+	// How far from their position any of these particles paint
+	static const int PAINT_EXTENT = 32;
+
+	KindArrays m_KindArraysArr[NUM_KINDS];
+};
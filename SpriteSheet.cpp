@@ -36,4 +36,14 @@ int SpriteSheet::GetTileWidth() const
 int SpriteSheet::GetTileHeight() const
 {
 	return m_TileHeight;
+}
+
+int SpriteSheet::GetTilesWide() const
+{
+	return m_TilesWide;
+}
+
+int SpriteSheet::GetTilesHigh() const
+{
+	return m_TilesHigh;
 }
\ No newline at end of file
@@ -13,6 +13,8 @@ public:
 
 	int GetTileWidth() const;
 	int GetTileHeight() const;
+	int GetTilesWide() const;
+	int GetTilesHigh() const;
 	Bitmap* GetBitmap() const;
 
 private:
@@ -2,9 +2,10 @@
 
 #include "SpriteSheetManager.h"
 #include "SpriteSheet.h"
+#include "ChunkedBitmap.h"
 #include "Enumerations.h"
 
-std::vector<Bitmap*> SpriteSheetManager::m_LevelForegroundsPtrArr = std::vector<Bitmap*>(Constants::NUM_LEVELS);
+std::vector<ChunkedBitmap*> SpriteSheetManager::m_LevelForegroundsPtrArr = std::vector<ChunkedBitmap*>(Constants::NUM_LEVELS);
 
 SpriteSheet* SpriteSheetManager::m_SpriteSheetPtrArr[];
 Bitmap* SpriteSheetManager::m_BitmapPtrArr[];
@@ -19,8 +20,8 @@ SpriteSheetManager::~SpriteSheetManager()
 void SpriteSheetManager::Load()
 {
 	// Level
-	m_LevelForegroundsPtrArr[0] = new Bitmap(String("Resources/levels/00/foreground.png"));
-	m_LevelForegroundsPtrArr[1] = new Bitmap(String("Resources/levels/01/foreground.png"));
+	m_LevelForegroundsPtrArr[0] = new ChunkedBitmap(String("Resources/levels/00/foreground.png"));
+	m_LevelForegroundsPtrArr[1] = new ChunkedBitmap(String("Resources/levels/01/foreground.png"));
 
 	m_BitmapPtrArr[int(Bitmaps::LEVEL_ONE_BACKGROUND)] = new Bitmap(String("Resources/background.png"));
 	m_BitmapPtrArr[int(Bitmaps::LEVEL_ONE_UNDERGROUND_BACKGROUND)] = new Bitmap(String("Resources/cave-bg-animated.png"));
@@ -86,7 +87,7 @@ void SpriteSheetManager::Unload()
 	}
 }
 
-Bitmap* SpriteSheetManager::GetLevelForegroundBmpPtr(int levelIndex)
+ChunkedBitmap* SpriteSheetManager::GetLevelForegroundBmpPtr(int levelIndex)
 {
 	return m_LevelForegroundsPtrArr[levelIndex];
 }
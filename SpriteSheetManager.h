@@ -1,6 +1,7 @@
 #pragma once
 
 class SpriteSheet;
+class ChunkedBitmap;
 
 class SpriteSheetManager
 {
@@ -36,14 +37,14 @@ public:
 	static void Load();
 	static void Unload();
 
-	static Bitmap* GetLevelForegroundBmpPtr(int levelIndex);
+	static ChunkedBitmap* GetLevelForegroundBmpPtr(int levelIndex);
 	static Bitmap* GetBitmapPtr(Bitmaps bitmap);
 	static SpriteSheet* GetSpriteSheetPtr(SpriteSheets spriteSheet);
 
 private:
 	SpriteSheetManager();
 
-	static std::vector<Bitmap*> m_LevelForegroundsPtrArr;
+	static std::vector<ChunkedBitmap*> m_LevelForegroundsPtrArr;
 	static SpriteSheet* m_SpriteSheetPtrArr[int(SpriteSheets::__LAST_ELEMENT)];
 	static Bitmap* m_BitmapPtrArr[int(Bitmaps::_LAST_ELEMENT)];
 };
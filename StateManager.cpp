@@ -8,11 +8,10 @@
 StateManager::StateManager(Game* gamePtr) : 
 	m_GamePtr(gamePtr)
 {
-	if (Game::DEBUG_SKIP_MAIN_MENU)
-	{
-		m_CurrentStatePtr = new GameState(this);
-	}
-	else
+	// NOTE: There is nobody to navigate the menus when running headless,
+	// and recordings only hold the input from the moment a level was entered.
+	// The game state is then created during the first tick, see Tick
+	if (!(Game::DEBUG_SKIP_MAIN_MENU || GAME_ENGINE->IsHeadless() || GAME_ENGINE->IsReplayingInput()))
 	{
 		m_CurrentStatePtr = new MainMenuState(this);
 	}
@@ -25,11 +24,21 @@ StateManager::~StateManager()
 
 void StateManager::Tick(double deltaTime)
 {
+	if (m_CurrentStatePtr == nullptr)
+	{
+		// Enter the level during a tick, like the level select does, so that the physics step
+		// of this tick runs before the first recorded input, both while recording and replaying
+		SetState(new GameState(this));
+		return;
+	}
+
 	CurrentState()->Tick(deltaTime);
 }
 
 void StateManager::Paint()
 {
+	if (m_CurrentStatePtr == nullptr) return;
+
 	CurrentState()->Paint();
 }
 
@@ -11,7 +11,6 @@ ThreeUpMoon::ThreeUpMoon(DOUBLE2 topLeft, Level* levelPtr) :
 
 void ThreeUpMoon::Tick(double deltaTime)
 {
-	Item::Tick(deltaTime);
 }
 
 void ThreeUpMoon::Paint()
@@ -0,0 +1,229 @@
+#include "stdafx.h"
+
+#include "TileMap.h"
+#include "Enumerations.h"
+
+#include <algorithm>
+#include <intrin.h>
+
+TileMap::TileMap(double levelWidth, double levelHeight) :
+	COLUMNS(int(ceil(levelWidth / TILE_SIZE))),
+	ROWS(int(ceil(levelHeight / TILE_SIZE))),
+	WORDS_PER_ROW((int(ceil(levelWidth / TILE_SIZE)) + BITS_PER_WORD - 1) / BITS_PER_WORD)
+{
+	m_TilesArr.resize(ROWS * COLUMNS, Tile::EMPTY);
+	m_GroundBitsArr.resize(ROWS * WORDS_PER_ROW, 0);
+}
+
+TileMap::~TileMap()
+{
+}
+
+void TileMap::AddChains(const std::vector<std::vector<DOUBLE2>>& chainsArrRef)
+{
+	FillChainRows(chainsArrRef);
+
+	for (size_t i = 0; i < chainsArrRef.size(); ++i)
+	{
+		const std::vector<DOUBLE2>& chainRef = chainsArrRef[i];
+		for (size_t j = 0; j < chainRef.size(); ++j)
+		{
+			const DOUBLE2 point1 = chainRef[j];
+			const DOUBLE2 point2 = chainRef[(j + 1) % chainRef.size()];
+			const bool isDiagonal = abs(point2.x - point1.x) > 0.5 && abs(point2.y - point1.y) > 0.5;
+			if (isDiagonal)
+			{
+				MarkSlope(point1, point2);
+			}
+		}
+	}
+}
+
+void TileMap::FillChainRows(const std::vector<std::vector<DOUBLE2>>& chainsArrRef)
+{
+	// Every chain is a closed loop, so a tile is inside the geometry when a line through
+	// its center crosses an odd number of edges before reaching it
+	std::vector<double> crossingsArr;
+	for (int row = 0; row < ROWS; ++row)
+	{
+		const double centerY = row * TILE_SIZE + TILE_SIZE / 2.0;
+
+		crossingsArr.clear();
+		for (size_t i = 0; i < chainsArrRef.size(); ++i)
+		{
+			const std::vector<DOUBLE2>& chainRef = chainsArrRef[i];
+			for (size_t j = 0; j < chainRef.size(); ++j)
+			{
+				const DOUBLE2 point1 = chainRef[j];
+				const DOUBLE2 point2 = chainRef[(j + 1) % chainRef.size()];
+				if ((point1.y <= centerY) != (point2.y <= centerY))
+				{
+					const double t = (centerY - point1.y) / (point2.y - point1.y);
+					crossingsArr.push_back(point1.x + t * (point2.x - point1.x));
+				}
+			}
+		}
+		std::sort(crossingsArr.begin(), crossingsArr.end());
+
+		for (size_t i = 0; i + 1 < crossingsArr.size(); i += 2)
+		{
+			const int firstCol = max(0, int(ceil(crossingsArr[i] / TILE_SIZE - 0.5)));
+			const int lastCol = min(COLUMNS - 1, int(floor(crossingsArr[i + 1] / TILE_SIZE - 0.5)));
+			for (int col = firstCol; col <= lastCol; ++col)
+			{
+				SetTile(col, row, Tile::SOLID);
+			}
+		}
+	}
+}
+
+void TileMap::MarkSlope(DOUBLE2 point1, DOUBLE2 point2)
+{
+	const DOUBLE2 edge = point2 - point1;
+	const int steps = int(ceil(edge.Length() / (TILE_SIZE / 4.0)));
+	for (int i = 0; i <= steps; ++i)
+	{
+		const DOUBLE2 point = point1 + edge * (double(i) / steps);
+		SetTile(GetColumn(point.x), GetRow(point.y), Tile::SLOPE);
+	}
+}
+
+void TileMap::AddRect(RECT2 rect, Tile tile)
+{
+	const int firstCol = GetColumn(rect.left);
+	const int lastCol = GetColumn(rect.right - 0.001);
+	const int firstRow = GetRow(rect.top);
+	const int lastRow = GetRow(rect.bottom - 0.001);
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		for (int col = firstCol; col <= lastCol; ++col)
+		{
+			SetTile(col, row, tile);
+		}
+	}
+}
+
+void TileMap::SetTile(int col, int row, Tile tile)
+{
+	if (col < 0 || col >= COLUMNS || row < 0 || row >= ROWS) return;
+
+	m_TilesArr[row * COLUMNS + col] = tile;
+
+	unsigned int& wordRef = m_GroundBitsArr[row * WORDS_PER_ROW + col / BITS_PER_WORD];
+	const unsigned int bit = 1u << (col % BITS_PER_WORD);
+	if (tile == Tile::EMPTY) wordRef &= ~bit;
+	else wordRef |= bit;
+}
+
+int TileMap::GetColumns() const
+{
+	return COLUMNS;
+}
+
+int TileMap::GetRows() const
+{
+	return ROWS;
+}
+
+int TileMap::GetColumn(double x) const
+{
+	return int(floor(x / TILE_SIZE));
+}
+
+int TileMap::GetRow(double y) const
+{
+	return int(floor(y / TILE_SIZE));
+}
+
+TileMap::Tile TileMap::GetTile(int col, int row) const
+{
+	if (col < 0 || col >= COLUMNS || row < 0 || row >= ROWS) return Tile::EMPTY;
+
+	return m_TilesArr[row * COLUMNS + col];
+}
+
+TileMap::Tile TileMap::GetTileAt(DOUBLE2 point) const
+{
+	return GetTile(GetColumn(point.x), GetRow(point.y));
+}
+
+bool TileMap::IsRectOverlappingGround(RECT2 rect) const
+{
+	const int firstCol = max(0, GetColumn(rect.left));
+	const int lastCol = min(COLUMNS - 1, GetColumn(rect.right));
+	const int firstRow = max(0, GetRow(rect.top));
+	const int lastRow = min(ROWS - 1, GetRow(rect.bottom));
+	if (firstCol > lastCol || firstRow > lastRow) return false;
+
+	const int firstWord = firstCol / BITS_PER_WORD;
+	const int lastWord = lastCol / BITS_PER_WORD;
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		const unsigned int* wordsPtr = GetGroundBitsRow(row);
+		for (int word = firstWord; word <= lastWord; ++word)
+		{
+			unsigned int mask = 0xFFFFFFFFu;
+			if (word == firstWord) mask &= 0xFFFFFFFFu << (firstCol % BITS_PER_WORD);
+			if (word == lastWord) mask &= 0xFFFFFFFFu >> (BITS_PER_WORD - 1 - lastCol % BITS_PER_WORD);
+
+			if (wordsPtr[word] & mask) return true;
+		}
+	}
+
+	return false;
+}
+
+const unsigned int* TileMap::GetGroundBitsRow(int row) const
+{
+	return &m_GroundBitsArr[row * WORDS_PER_ROW];
+}
+
+int TileMap::GetWordsPerRow() const
+{
+	return WORDS_PER_ROW;
+}
+
+int TileMap::FindGapInRow(int row, int startCol, int dir, int maxCols) const
+{
+	const int lastCol = startCol + dir * maxCols;
+	int col = startCol + dir;
+	if (maxCols <= 0 || col < 0 || col >= COLUMNS) return -1;
+
+	// There's nothing to stand on above or below the level
+	if (row < 0 || row >= ROWS) return col;
+
+	const unsigned int* wordsPtr = GetGroundBitsRow(row);
+	while (dir == Direction::RIGHT ? col <= lastCol : col >= lastCol)
+	{
+		if (col < 0 || col >= COLUMNS) return -1;
+
+		const int word = col / BITS_PER_WORD;
+		const int bit = col % BITS_PER_WORD;
+		unsigned long gapBit;
+		if (dir == Direction::RIGHT)
+		{
+			// Only the gaps at or after col
+			const unsigned int gaps = ~wordsPtr[word] & (0xFFFFFFFFu << bit);
+			if (_BitScanForward(&gapBit, gaps))
+			{
+				// NOTE: The bits past the last column are never set, those aren't gaps
+				const int gapCol = word * BITS_PER_WORD + int(gapBit);
+				return (gapCol <= lastCol && gapCol < COLUMNS ? gapCol : -1);
+			}
+			col = (word + 1) * BITS_PER_WORD;
+		}
+		else
+		{
+			// Only the gaps at or before col
+			const unsigned int gaps = ~wordsPtr[word] & (0xFFFFFFFFu >> (BITS_PER_WORD - 1 - bit));
+			if (_BitScanReverse(&gapBit, gaps))
+			{
+				const int gapCol = word * BITS_PER_WORD + int(gapBit);
+				return (gapCol >= lastCol ? gapCol : -1);
+			}
+			col = word * BITS_PER_WORD - 1;
+		}
+	}
+
+	return -1;
+}
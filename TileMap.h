@@ -0,0 +1,64 @@
+#pragma once
+
+// A coarse picture of a level's terrain, one entry per TILE_SIZE square, built once when the level is loaded.
+// Answers "is there ground here" questions without going through the physics world. Next to the tile
+// types every row is also kept as bits, one per tile, set where there is anything to stand on, so
+// scanning ahead for the end of a ledge only touches one word per 32 tiles
+class TileMap
+{
+public:
+	enum class Tile : unsigned char
+	{
+		EMPTY, 
+		SOLID, 
+		SEMI_SOLID, // Can be jumped through from below (platforms)
+		SLOPE, // Part of a diagonal edge of the level's geometry
+		// NOTE: All entries must be above this line
+		_LAST_ELEMENT
+	};
+
+	TileMap(double levelWidth, double levelHeight);
+	virtual ~TileMap();
+
+	TileMap(const TileMap&) = delete;
+	TileMap& operator=(const TileMap&) = delete;
+
+	// Fills the inside of every closed chain (the level's svg geometry) with solid tiles,
+	// and marks the tiles diagonal edges pass through as slopes
+	void AddChains(const std::vector<std::vector<DOUBLE2>>& chainsArrRef);
+	void AddRect(RECT2 rect, Tile tile);
+
+	int GetColumns() const;
+	int GetRows() const;
+	int GetColumn(double x) const;
+	int GetRow(double y) const;
+
+	// Everything outside of the level is empty
+	Tile GetTile(int col, int row) const;
+	Tile GetTileAt(DOUBLE2 point) const;
+	// Whether any tile the rectangle overlaps is not empty
+	bool IsRectOverlappingGround(RECT2 rect) const;
+
+	// The bits of this row, one per tile, starting with column 0 in the lowest bit of the first word
+	const unsigned int* GetGroundBitsRow(int row) const;
+	int GetWordsPerRow() const;
+	// The first column after startCol, walking in dir (Direction::LEFT or RIGHT) for at most maxCols tiles,
+	// which has nothing to stand on. Returns -1 when every one of those tiles has ground, or the walk
+	// leaves the sides of the level
+	int FindGapInRow(int row, int startCol, int dir, int maxCols) const;
+
+	static const int TILE_SIZE = 16;
+	static const int BITS_PER_WORD = 32;
+
+private:
+	void SetTile(int col, int row, Tile tile);
+	void FillChainRows(const std::vector<std::vector<DOUBLE2>>& chainsArrRef);
+	void MarkSlope(DOUBLE2 point1, DOUBLE2 point2);
+
+	const int COLUMNS;
+	const int ROWS;
+	const int WORDS_PER_ROW;
+
+	std::vector<Tile> m_TilesArr; // ROWS * COLUMNS, row by row
+	std::vector<unsigned int> m_GroundBitsArr; // ROWS * WORDS_PER_ROW
+};
@@ -57,7 +57,7 @@ void $projectname$::GameTick(double deltaTime)
 	// Insert the code that needs to be executed, EXCEPT for paint commands (see next method)
 }
 
-void $projectname$::GamePaint()
+void $projectname$::GamePaint(double alpha)
 {
 	// Insert the code that needs to be executed each time a new frame needs to be drawn to the screen
 }
@@ -49,7 +49,7 @@ public:
 	virtual void GameStart();
 	virtual void GameEnd();
 	virtual void GameTick(double deltaTime);
-	virtual void GamePaint();
+	virtual void GamePaint(double alpha);
 
 	// -------------------------
 	// Public Member functions
@@ -15,7 +15,6 @@
 #include "OneUpMushroom.h"
 #include "Fireball.h"
 #include "YoshiEggBreakParticle.h"
-#include "StarCloudParticle.h"
 
 // STATIC INITIALIZATIONS
 const std::string Yoshi::MESSAGE_STRING = "Hooray!  Thank you\n" "for rescuing   me.\n" "My name  is Yoshi.\n" 
@@ -173,8 +172,7 @@ void Yoshi::Tick(double deltaTime)
 			m_ActPtr->SetGravityScale(1.0);
 			m_GrowingTimer.Start();
 
-			StarCloudParticle* starCloudParticlePtr = new StarCloudParticle(m_ActPtr->GetPosition() + DOUBLE2(-8, -8));
-			m_LevelPtr->AddParticle(starCloudParticlePtr);
+			m_LevelPtr->AddParticle(SpriteParticleStore::Kind::STAR_CLOUD, m_ActPtr->GetPosition() + DOUBLE2(-8, -8));
 
 			YoshiEggBreakParticle* yoshiEggBreakParticle = new YoshiEggBreakParticle(m_ActPtr->GetPosition());
 			m_LevelPtr->AddParticle(yoshiEggBreakParticle);
@@ -278,12 +276,7 @@ void Yoshi::UpdatePosition(double deltaTime)
 	double newXVel = prevVel.x;
 
 	// Just run until you hit an obstacle, then turn around
-	DOUBLE2 point1 = m_ActPtr->GetPosition();
-	DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
-	DOUBLE2 intersection, normal;
-	double fraction = -1.0;
-	int collisionBits = Level::LEVEL | Level::BLOCK;
-	if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
+	if (m_WallProbe.m_Hit)
 	{
 		// Turn around
 		m_DirFacing = -m_DirFacing;
@@ -297,23 +290,32 @@ void Yoshi::UpdatePosition(double deltaTime)
 
 	newXVel = double(m_DirFacing) * RUN_VEL * deltaTime;
 
+	m_WallProbe.m_Offset = DOUBLE2(m_DirFacing * (GetWidth() / 2 + 2), 0);
+	m_WallProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_WallProbe);
+
 	m_ActPtr->SetLinearVelocity(DOUBLE2(newXVel, prevVel.y));
 }
 
 bool Yoshi::CalculateOnGround()
 {
-	DOUBLE2 point1 = m_ActPtr->GetPosition();
-	DOUBLE2 point2 = m_ActPtr->GetPosition() + DOUBLE2(0, (GetHeight() / 2 + 3));
-	DOUBLE2 intersection, normal;
-	double fraction = -1.0;
-	int collisionBits = Level::LEVEL | Level::BLOCK;
+	// NOTE: This probe was run from where the last physics step left us
+	const bool groundBelow = m_GroundProbe.m_Hit;
 
-	if (m_LevelPtr->Raycast(point1, point2, collisionBits, intersection, normal, fraction))
-	{
-		return true;
-	}
+	m_GroundProbe.m_Offset = DOUBLE2(0, (GetHeight() / 2 + 3));
+	m_GroundProbe.m_CollisionBits = Level::LEVEL | Level::BLOCK;
+	SubmitProbe(m_GroundProbe);
 
-	return false;
+	return groundBelow;
+}
+
+RECT2 Yoshi::GetPaintBounds()
+{
+	RECT2 bounds = Entity::GetPaintBounds();
+	const double tongueLength = GetTongueLength();
+	bounds.left -= tongueLength;
+	bounds.right += tongueLength;
+	return bounds;
 }
 
 void Yoshi::Paint()
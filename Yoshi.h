@@ -8,7 +8,6 @@ class Player;
 class Enemy;
 class Message;
 class YoshiEggBreakParticle;
-class StarCloudParticle;
 
 class Yoshi : public Entity
 {
@@ -26,6 +25,8 @@ public:
 
 	void Tick(double deltaTime);
 	void Paint();
+	// Widened by the length of the tongue, and whatever is on the end of it
+	RECT2 GetPaintBounds();
 
 	int GetWidth() const;
 	int GetHeight() const;
@@ -93,6 +94,8 @@ private:
 
 	bool m_IsOnGround = false;
 	bool m_WasOnGround = false;
+	Probe m_GroundProbe;
+	Probe m_WallProbe; // Only used while running wild
 	bool m_NeedsNewFixture = false;
 	bool m_ShouldSpawnMushroom = false;
 
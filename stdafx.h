@@ -20,6 +20,7 @@
 
 // std lib includes
 #include <vector>			// std lib vector
+#include <map>				// SVGGeometryCache
 #include <string>			// std lib to_string
 #include <sstream>			// std lib stringstream
 #include <fstream>			// SVGParser
@@ -87,7 +88,9 @@ enum class BodyType
 #include "EngineFiles/Box2DDebugRenderer.h"
 #include "EngineFiles/InputManager.h"
 #include "EngineFiles/PrecisionTimer.h"
+#include "EngineFiles/Profiler.h"
 #include "EngineFiles/GameSettings.h"
+#include "EngineFiles/SpriteBatch.h"
 #include "EngineFiles/GameEngine.h"
 #include "EngineFiles/Font.h"
 
@@ -95,6 +98,7 @@ enum class BodyType
 #include "EngineFiles/FmodSound.h"
 
 #include "EngineFiles/Bitmap.h"
+#include "EngineFiles/SoftwareRenderer.h"
 #include "EngineFiles/GUIBase.h"
 #include "EngineFiles/TextBox.h"
 #include "EngineFiles/Button.h"
@@ -102,6 +106,7 @@ enum class BodyType
 
 #include "EngineFiles/PhysicsActor.h"
 #include "EngineFiles/SVGParser.h"
+#include "EngineFiles/SVGGeometryCache.h"
 #include "EngineFiles/PhysicsRevoluteJoint.h"
 #include "EngineFiles/PhysicsPrismaticJoint.h"
 #include "EngineFiles/PhysicsDistanceJoint.h"